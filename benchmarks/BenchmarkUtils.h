@@ -0,0 +1,185 @@
+#ifndef BENCHMARK_UTILS_H
+#define BENCHMARK_UTILS_H
+
+#include <benchmark/benchmark.h>
+#include <MiningTruckProcessor.h>
+#include <UnloadingStationProcessor.h>
+#include <sys/resource.h>
+#include <chrono>
+#include <fstream>
+#include <string>
+
+using namespace std;
+
+/**
+* @brief  Simulation parameters shared by every benchmark
+*/
+static const float BENCH_MIN_MINING_DURATION_HRS{1};
+static const float BENCH_MAX_MINING_DURATION_HRS{5};
+static const float BENCH_TRAVEL_DURATION_HRS{0.5};
+static const float BENCH_UNLOAD_DURATION_MIN{5};
+static const float BENCH_TIMESTEP_MIN{5};
+static const uint64_t BENCH_SEED{1};
+
+/**
+* @brief  Number of time steps run before a processor benchmark starts timing, so trucks are spread across all states (6 hours)
+*/
+static const int BENCH_WARMUP_TIMESTEPS{72};
+
+/**
+* @brief  Benchmarks are skipped when one iteration would run more truck-ticks than this
+*/
+static const double BENCH_MAX_TRUCK_TICKS{2e9};
+
+/**
+* @brief  Resets the peak resident set size of the process to its current resident set size (Linux 4.0+), so each benchmark
+*         reports its own peak instead of the peak of every benchmark run before it
+*/
+inline void resetPeakRSS(){
+    ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+}
+
+/**
+* @brief  Returns the peak resident set size of the process in MiB since the last resetPeakRSS
+*/
+inline double getPeakRSS_MiB(){
+    ifstream status("/proc/self/status");
+    string line{};
+    while(getline(status, line)){
+        if(line.rfind("VmHWM:", 0) == 0){
+            return stod(line.substr(6)) / 1024.0;   // VmHWM is in kB
+        }
+    }
+
+    // Fall back to the peak of the whole process
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;   // ru_maxrss is in kB on Linux
+}
+
+/**
+* @brief  Returns the number of state changes every truck has made since it was initialized. A truck moves through
+*         MINING -> TRAVEL (loaded) -> UNLOAD -> TRAVEL (unloaded) -> MINING, and numUnloads is incremented while in UNLOAD
+*/
+inline long countTruckStateChanges(const vector<Truck>& trucks){
+    long numStateChanges{0};
+    for(const Truck& truck : trucks){
+        long cyclePosition{0};
+        switch(truck.state){
+            case TruckStates::MINING:
+                cyclePosition = 0;
+                break;
+            case TruckStates::TRAVEL:
+                cyclePosition = truck.isLoaded ? 1 : -1;
+                break;
+            case TruckStates::UNLOAD:
+                cyclePosition = truck.isLoaded ? 2 : -2;
+                break;
+        }
+        numStateChanges += 4L * truck.numUnloads + cyclePosition;
+    }
+    return numStateChanges;
+}
+
+/**
+* @brief  Returns the number of simulation events (truck state changes and truck unloads) made since initialization
+*/
+inline long countEvents(const vector<Truck>& trucks){
+    long numUnloads{0};
+    for(const Truck& truck : trucks){
+        numUnloads += truck.numUnloads;
+    }
+    return countTruckStateChanges(trucks) + numUnloads;
+}
+
+/**
+* @brief  Sets the counters reported by every benchmark
+* @param state Benchmark state
+* @param numTruckTicks Number of truck updates timed over all iterations (trucks x time steps)
+* @param numEvents Number of events processed over all iterations
+* @param elapsed_s Total timed duration of all iterations in seconds
+*/
+inline void setBenchmarkCounters(benchmark::State& state, const double numTruckTicks, const double numEvents, const double elapsed_s){
+    state.counters["ns_per_truck_tick"] = numTruckTicks > 0 ? elapsed_s * 1e9 / numTruckTicks : 0;
+    state.counters["events_per_s"] = benchmark::Counter(numEvents, benchmark::Counter::kIsRate);
+    state.counters["peak_rss_MiB"] = getPeakRSS_MiB();
+}
+
+/**
+* @brief  Adds every (trucks, stations) pair with 10 -> 10M trucks and 1 -> 4096 stations, skipping more stations than trucks
+*/
+inline void fleetArguments(benchmark::internal::Benchmark* benchmark){
+    benchmark->ArgNames({"trucks", "stations"});
+    for(long numTrucks = 10; numTrucks <= 10000000; numTrucks *= 10){
+        for(long numStations : {1L, 16L, 256L, 4096L}){
+            if(numStations <= numTrucks){
+                benchmark->Args({numTrucks, numStations});
+            }
+        }
+    }
+}
+
+/**
+* @class BenchmarkFleet
+* @brief Trucks and stations advanced one fixed time step at a time, in the same order as Simulation::run
+*/
+class BenchmarkFleet{
+    public:
+        /**
+        * @brief  Constructs new 'BenchmarkFleet' object and runs the warm-up time steps
+        */
+        BenchmarkFleet(const size_t numMiningTrucks, const size_t numUnloadingStations) :
+                    m_MiningTrucksProcessor(numMiningTrucks, BENCH_MIN_MINING_DURATION_HRS, BENCH_MAX_MINING_DURATION_HRS,
+                                            BENCH_TRAVEL_DURATION_HRS, BENCH_UNLOAD_DURATION_MIN, BENCH_SEED),
+                    m_UnloadingStationProcessor(numUnloadingStations, BENCH_UNLOAD_DURATION_MIN, numMiningTrucks) {
+            for(int i = 0; i < BENCH_WARMUP_TIMESTEPS; i++){
+                updateUnloadingStations();
+                updateMiningTrucks();
+                assignVehiclesToStations();
+            }
+        };
+
+        /**
+        * @brief  Updates every unloading station by one time step
+        */
+        void updateUnloadingStations(){
+            m_UnloadingStationProcessor.updateUnloadingStations(minutesToTicks(BENCH_TIMESTEP_MIN), m_MiningTrucksProcessor.m_MiningTrucksList);
+        };
+
+        /**
+        * @brief  Updates every mining truck by one time step
+        */
+        void updateMiningTrucks(){
+            m_MiningTrucksProcessor.updateMiningTrucks(minutesToTicks(BENCH_TIMESTEP_MIN));
+        };
+
+        /**
+        * @brief  Assigns the trucks loaded in the last truck update to unloading stations
+        */
+        void assignVehiclesToStations(){
+            m_UnloadingStationProcessor.assignVehiclesToStations(m_MiningTrucksProcessor.m_MiningTrucksList, m_MiningTrucksProcessor.getLoadedTrucks());
+        };
+
+        /**
+        * @brief  Processor of all mining trucks
+        */
+        MiningTrucksProcessor m_MiningTrucksProcessor;
+
+        /**
+        * @brief  Processor of all unloading stations
+        */
+        UnloadingStationProcessor m_UnloadingStationProcessor;
+};
+
+/**
+* @brief  Returns the duration of a call in seconds
+*/
+template<typename Body>
+inline double timeCall(Body&& body){
+    const chrono::steady_clock::time_point start{chrono::steady_clock::now()};
+    body();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+#endif // BENCHMARK_UTILS_H
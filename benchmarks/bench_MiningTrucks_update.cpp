@@ -0,0 +1,25 @@
+#include <BenchmarkUtils.h>
+
+using namespace std;
+
+// Benchmark of updating every mining truck by one time step
+static void BM_MiningTrucksUpdate(benchmark::State& state) {
+    const size_t numMiningTrucks{static_cast<size_t>(state.range(0))};
+    const size_t numUnloadingStations{static_cast<size_t>(state.range(1))};
+    resetPeakRSS();
+    BenchmarkFleet fleet(numMiningTrucks, numUnloadingStations);
+
+    // Time only the truck update, stations are updated and assigned between iterations so trucks keep cycling
+    const long firstNumStateChanges{countTruckStateChanges(fleet.m_MiningTrucksProcessor.m_MiningTrucksList)};
+    double elapsed_s{0};
+    for(auto _ : state){
+        fleet.updateUnloadingStations();
+        const double iteration_s{timeCall([&fleet](){ fleet.updateMiningTrucks(); })};
+        fleet.assignVehiclesToStations();
+        state.SetIterationTime(iteration_s);
+        elapsed_s += iteration_s;
+    }
+    const long numStateChanges{countTruckStateChanges(fleet.m_MiningTrucksProcessor.m_MiningTrucksList) - firstNumStateChanges};
+    setBenchmarkCounters(state, static_cast<double>(numMiningTrucks) * state.iterations(), numStateChanges, elapsed_s);
+}
+BENCHMARK(BM_MiningTrucksUpdate)->Apply(fleetArguments)->UseManualTime()->Unit(benchmark::kMicrosecond);
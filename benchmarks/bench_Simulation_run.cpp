@@ -0,0 +1,85 @@
+#include <BenchmarkUtils.h>
+#include <Simulation.h>
+
+using namespace std;
+
+// Adds every (trucks, stations, horizon, engine) combination that runs at most BENCH_MAX_TRUCK_TICKS truck-ticks
+static void simulationArguments(benchmark::internal::Benchmark* benchmark){
+    benchmark->ArgNames({"trucks", "stations", "hours", "engine"});
+    for(long numTrucks = 10; numTrucks <= 10000000; numTrucks *= 10){
+        for(long numStations : {1L, 256L}){
+            for(long simulationTime_hrs : {1L, 24L, 72L}){
+                const double numTruckTicks{static_cast<double>(numTrucks) * (simulationTime_hrs * 60 / BENCH_TIMESTEP_MIN + 1)};
+                if(numStations > numTrucks || numTruckTicks > BENCH_MAX_TRUCK_TICKS){
+                    continue;
+                }
+                for(long engine : {SimulationEngines::FIXED_STEP, SimulationEngines::DISCRETE_EVENT, SimulationEngines::STRUCT_OF_ARRAYS, 
+                                    SimulationEngines::TIMING_WHEEL, SimulationEngines::ADAPTIVE_STEP}){
+                    benchmark->Args({numTrucks, numStations, simulationTime_hrs, engine});
+                }
+            }
+        }
+    }
+}
+
+// Benchmark of a full simulation run, from initialized trucks and stations to the end of the simulation time
+static void BM_SimulationRun(benchmark::State& state) {
+    const size_t numMiningTrucks{static_cast<size_t>(state.range(0))};
+    const size_t numUnloadingStations{static_cast<size_t>(state.range(1))};
+    const double simulationTime_hrs{static_cast<double>(state.range(2))};
+    const SimulationEngines engine{static_cast<SimulationEngines>(state.range(3))};
+    const double numTimesteps{floor(simulationTime_hrs * 60 / BENCH_TIMESTEP_MIN) + 1};
+
+    // Time only the run, each iteration starts from a newly initialized simulation
+    resetPeakRSS();
+    long numEvents{0};
+    double elapsed_s{0};
+    for(auto _ : state){
+        Simulation simulation(numMiningTrucks, numUnloadingStations, BENCH_MIN_MINING_DURATION_HRS, BENCH_MAX_MINING_DURATION_HRS,
+                                BENCH_TRAVEL_DURATION_HRS, BENCH_UNLOAD_DURATION_MIN, simulationTime_hrs, BENCH_TIMESTEP_MIN, engine, BENCH_SEED);
+        const double iteration_s{timeCall([&simulation](){ simulation.run(); })};
+        state.SetIterationTime(iteration_s);
+        elapsed_s += iteration_s;
+        numEvents += countEvents(simulation.getMiningTrucks());
+    }
+    setBenchmarkCounters(state, numMiningTrucks * numTimesteps * state.iterations(), numEvents, elapsed_s);
+}
+BENCHMARK(BM_SimulationRun)->Apply(simulationArguments)->UseManualTime()->Unit(benchmark::kMillisecond);
+
+/**
+* @brief  Mining durations of the sparse fleet benchmark: few trucks with long mining cycles, so most time steps change nothing
+*/
+static const float BENCH_SPARSE_MIN_MINING_DURATION_HRS{12};
+static const float BENCH_SPARSE_MAX_MINING_DURATION_HRS{48};
+static const double BENCH_SPARSE_SIMULATION_TIME_HRS{8760};
+
+// Adds the sparse fleets run by the struct-of-arrays and adaptive-step engines, which step through the same fleet layout
+static void sparseFleetArguments(benchmark::internal::Benchmark* benchmark){
+    benchmark->ArgNames({"trucks", "engine"});
+    for(long numTrucks : {1L, 10L, 100L, 1000L}){
+        for(long engine : {SimulationEngines::STRUCT_OF_ARRAYS, SimulationEngines::ADAPTIVE_STEP}){
+            benchmark->Args({numTrucks, engine});
+        }
+    }
+}
+
+// Benchmark of a year-long run of a sparse fleet with one station, where the adaptive-step engine skips most time steps
+static void BM_SimulationRunSparseFleet(benchmark::State& state) {
+    const size_t numMiningTrucks{static_cast<size_t>(state.range(0))};
+    const SimulationEngines engine{static_cast<SimulationEngines>(state.range(1))};
+    const double numTimesteps{floor(BENCH_SPARSE_SIMULATION_TIME_HRS * 60 / BENCH_TIMESTEP_MIN) + 1};
+
+    resetPeakRSS();
+    long numEvents{0};
+    double elapsed_s{0};
+    for(auto _ : state){
+        Simulation simulation(numMiningTrucks, 1, BENCH_SPARSE_MIN_MINING_DURATION_HRS, BENCH_SPARSE_MAX_MINING_DURATION_HRS, BENCH_TRAVEL_DURATION_HRS,
+                                BENCH_UNLOAD_DURATION_MIN, BENCH_SPARSE_SIMULATION_TIME_HRS, BENCH_TIMESTEP_MIN, engine, BENCH_SEED);
+        const double iteration_s{timeCall([&simulation](){ simulation.run(); })};
+        state.SetIterationTime(iteration_s);
+        elapsed_s += iteration_s;
+        numEvents += countEvents(simulation.getMiningTrucks());
+    }
+    setBenchmarkCounters(state, numMiningTrucks * numTimesteps * state.iterations(), numEvents, elapsed_s);
+}
+BENCHMARK(BM_SimulationRunSparseFleet)->Apply(sparseFleetArguments)->UseManualTime()->Unit(benchmark::kMillisecond);
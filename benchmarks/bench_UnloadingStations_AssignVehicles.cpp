@@ -0,0 +1,25 @@
+#include <BenchmarkUtils.h>
+
+using namespace std;
+
+// Benchmark of assigning newly loaded trucks to unloading stations
+static void BM_UnloadingStationsAssignVehicles(benchmark::State& state) {
+    const size_t numMiningTrucks{static_cast<size_t>(state.range(0))};
+    const size_t numUnloadingStations{static_cast<size_t>(state.range(1))};
+    resetPeakRSS();
+    BenchmarkFleet fleet(numMiningTrucks, numUnloadingStations);
+
+    // Time only the assignment, every assigned truck is one event
+    long numAssignments{0};
+    double elapsed_s{0};
+    for(auto _ : state){
+        fleet.updateUnloadingStations();
+        fleet.updateMiningTrucks();
+        numAssignments += fleet.m_MiningTrucksProcessor.getLoadedTrucks().size();
+        const double iteration_s{timeCall([&fleet](){ fleet.assignVehiclesToStations(); })};
+        state.SetIterationTime(iteration_s);
+        elapsed_s += iteration_s;
+    }
+    setBenchmarkCounters(state, static_cast<double>(numMiningTrucks) * state.iterations(), numAssignments, elapsed_s);
+}
+BENCHMARK(BM_UnloadingStationsAssignVehicles)->Apply(fleetArguments)->UseManualTime()->Unit(benchmark::kMicrosecond);
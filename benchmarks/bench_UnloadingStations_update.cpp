@@ -0,0 +1,34 @@
+#include <BenchmarkUtils.h>
+
+using namespace std;
+
+// Returns the number of trucks unloaded by all stations
+static long countStationUnloads(const vector<Station>& stations){
+    long numUnloads{0};
+    for(const Station& station : stations){
+        numUnloads += station.numVehiclesUnloaded;
+    }
+    return numUnloads;
+}
+
+// Benchmark of updating every unloading station by one time step
+static void BM_UnloadingStationsUpdate(benchmark::State& state) {
+    const size_t numMiningTrucks{static_cast<size_t>(state.range(0))};
+    const size_t numUnloadingStations{static_cast<size_t>(state.range(1))};
+    resetPeakRSS();
+    BenchmarkFleet fleet(numMiningTrucks, numUnloadingStations);
+
+    // Time only the station update
+    const long firstNumUnloads{countStationUnloads(fleet.m_UnloadingStationProcessor.m_UnloadingStationsList)};
+    double elapsed_s{0};
+    for(auto _ : state){
+        const double iteration_s{timeCall([&fleet](){ fleet.updateUnloadingStations(); })};
+        fleet.updateMiningTrucks();
+        fleet.assignVehiclesToStations();
+        state.SetIterationTime(iteration_s);
+        elapsed_s += iteration_s;
+    }
+    const long numUnloads{countStationUnloads(fleet.m_UnloadingStationProcessor.m_UnloadingStationsList) - firstNumUnloads};
+    setBenchmarkCounters(state, static_cast<double>(numMiningTrucks) * state.iterations(), numUnloads, elapsed_s);
+}
+BENCHMARK(BM_UnloadingStationsUpdate)->Apply(fleetArguments)->UseManualTime()->Unit(benchmark::kMicrosecond);
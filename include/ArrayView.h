@@ -0,0 +1,96 @@
+#ifndef ARRAY_VIEW_H
+#define ARRAY_VIEW_H
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+using namespace std;
+
+/**
+* @class ArrayView
+* @brief Non-owning view of a contiguous array, the subset of std::span the simulation needs. Copying a view copies two words, never the
+*        elements. A view is invalidated when the vector it views reallocates
+*/
+template<typename T>
+class ArrayView{
+    public:
+        /**
+        * @brief  Constructs new empty 'ArrayView' object
+        */
+        ArrayView() : m_Data(nullptr), m_Size(0) {};
+
+        /**
+        * @brief  Constructs new 'ArrayView' object of size elements starting at data
+        */
+        ArrayView(T* data, const size_t size) : m_Data(data), m_Size(size) {};
+
+        /**
+        * @brief  Constructs new 'ArrayView' object of every element of a vector
+        */
+        template<typename Element>
+        ArrayView(const vector<Element>& values) : m_Data(values.data()), m_Size(values.size()) {};
+
+        /**
+        * @brief  Returns the element at idx
+        */
+        T& operator[](const size_t idx) const {
+            return m_Data[idx];
+        };
+
+        /**
+        * @brief  Returns a pointer to the first element
+        */
+        T* data() const {
+            return m_Data;
+        };
+
+        /**
+        * @brief  Returns the number of elements
+        */
+        size_t size() const {
+            return m_Size;
+        };
+
+        /**
+        * @brief  Returns true if the view has no elements
+        */
+        bool empty() const {
+            return m_Size == 0;
+        };
+
+        /**
+        * @brief  Returns an iterator to the first element
+        */
+        T* begin() const {
+            return m_Data;
+        };
+
+        /**
+        * @brief  Returns an iterator past the last element
+        */
+        T* end() const {
+            return m_Data + m_Size;
+        };
+
+        /**
+        * @brief  Returns a view of at most count elements starting at offset, clamped to the end of this view
+        */
+        ArrayView subview(const size_t offset, const size_t count) const {
+            const size_t first{min(offset, m_Size)};
+            return ArrayView(m_Data + first, min(count, m_Size - first));
+        };
+
+    private:
+        /**
+        * @brief  First element
+        */
+        T* m_Data;
+
+        /**
+        * @brief  Number of elements
+        */
+        size_t m_Size;
+};
+
+#endif // ARRAY_VIEW_H
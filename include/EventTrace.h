@@ -0,0 +1,519 @@
+#ifndef EVENT_TRACE_H
+#define EVENT_TRACE_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "spdlog/spdlog.h"
+
+using namespace std;
+using namespace spdlog;
+
+ /**
+  * @brief Defines the different events recorded in an event trace
+  */
+enum TraceEventTypes {
+    TRUCK_STATE_CHANGED,        // Truck changed state (from state -> to state)
+    STATION_STATE_CHANGED,      // Station changed state (from state -> to state)
+    TRUCK_ASSIGNED,             // Loaded truck was added to the queue of a station
+    TRUCK_UNLOADED              // Truck was unloaded by a station
+    };
+
+/**
+* @brief  Constructs new 'EventTraceBlock' object. Columns of one block of trace events
+*/
+struct EventTraceBlock{
+    vector<uint32_t> timestep{};        // Index of the time step of the event, counted from the start of the run
+    vector<int32_t> entityId{};         // Id of the truck or station
+    vector<int32_t> stationId{};        // Id of the station involved, or -1
+    vector<uint8_t> type{};             // TraceEventTypes of the event
+    vector<uint8_t> fromState{};        // State before the event
+    vector<uint8_t> toState{};          // State after the event
+
+    /**
+    * @brief  Returns the number of events in the block
+    */
+    size_t size() const {
+        return timestep.size();
+    };
+
+    /**
+    * @brief  Resizes every column
+    */
+    void resize(const size_t numEvents){
+        timestep.resize(numEvents);
+        entityId.resize(numEvents);
+        stationId.resize(numEvents);
+        type.resize(numEvents);
+        fromState.resize(numEvents);
+        toState.resize(numEvents);
+    };
+};
+
+/**
+* @brief  Constructs new 'EventTraceHeader' object. Header at the start of a trace file
+*/
+struct EventTraceHeader{
+    char magic[8]{'M', 'S', 'T', 'R', 'A', 'C', 'E', '\0'};    // Identifies the file as an event trace
+    uint32_t version{1};                                        // Version of the trace format
+    uint32_t blockCapacity{0};                                  // Maximum number of events in a block
+    double timestep_min{0};                                     // Length of a single timestep (min)
+    double startTime_min{0};                                    // Simulation time at the start of the run (min)
+};
+
+/**
+* @class EventTraceWriter
+* @brief Records truck and station events to a compact columnar binary file. Events are collected into blocks of
+*        columns, and each full block is appended to the file through a memory-mapped buffer that grows by doubling.
+*        File layout: EventTraceHeader, then blocks of
+*        [uint32 numEvents (n), uint32 numStationIds (m), uint32 first timestep, uint32 entity id bytes, uint32 timestep bytes, uint32 padding,
+*         stationId (int32) x m, type | fromState << 2 | toState << 4 | hasStationId << 6 (uint8) x n,
+*         entity id change from previous event (zigzag varint) x n, timestep change from previous event (varint) x n,
+*         zero padding to a multiple of 4 bytes].
+*        Only events involving a station store a station id
+*/
+class EventTraceWriter{
+    public:
+        /**
+        * @brief  Constructs new 'EventTraceWriter' object and opens the trace file
+        * @param fileName Path of the trace file, replaced if it exists
+        * @param timestep_min Length of a single timestep (min)
+        * @param startTime_min Simulation time at the start of the run (min)
+        */
+        EventTraceWriter(const string& fileName, const double timestep_min, const double startTime_min) : m_FileName(fileName),
+                        m_FileDescriptor(-1), m_MappedFile(nullptr), m_MappedSize(0), m_FileSize(0), m_NumEvents(0),
+                        m_NumBlockEvents(0), m_NumBlockStationIds(0), m_NumEntityIdBytes(0), m_NumTimestepBytes(0), m_BaseTimestep(0),
+                        m_PreviousTimestep(0), m_PreviousEntityId(0), m_CurrentTimestep(0), m_StationIds(BLOCK_CAPACITY),
+                        m_PackedEvents(BLOCK_CAPACITY), m_EntityIdBytes(BLOCK_CAPACITY * MAX_VARINT_BYTES),
+                        m_TimestepBytes(BLOCK_CAPACITY * MAX_VARINT_BYTES) {
+            m_FileDescriptor = ::open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if(m_FileDescriptor == -1){
+                error("Error: Could not open file {} for writing.", fileName);
+                return;
+            }
+
+            EventTraceHeader header{};
+            header.blockCapacity = BLOCK_CAPACITY;
+            header.timestep_min = timestep_min;
+            header.startTime_min = startTime_min;
+            appendBytes(&header, sizeof(header));
+        };
+
+        /**
+        * @brief  Writes any remaining events and closes the trace file
+        */
+        ~EventTraceWriter(){
+            close();
+        };
+
+        EventTraceWriter(const EventTraceWriter&) = delete;
+        EventTraceWriter& operator=(const EventTraceWriter&) = delete;
+
+        /**
+        * @brief  Sets the time step of the events recorded next. Time steps must not decrease
+        */
+        void setTimestep(const uint32_t timestep){
+            m_CurrentTimestep = timestep;
+        };
+
+        /**
+        * @brief  Records an event in the current time step
+        */
+        void record(const TraceEventTypes type, const int entityId, const int fromState, const int toState, const int stationId = -1){
+            if(m_NumBlockEvents == 0){
+                m_BaseTimestep = m_CurrentTimestep;
+                m_PreviousTimestep = m_CurrentTimestep;
+                m_PreviousEntityId = 0;
+            }
+
+            // Events arrive in time step and mostly id order, so both are stored as small changes from the previous event
+            const int32_t entityIdChange{entityId - m_PreviousEntityId};
+            m_NumEntityIdBytes += writeVarint(m_EntityIdBytes.data() + m_NumEntityIdBytes,
+                                                (static_cast<uint32_t>(entityIdChange) << 1) ^ static_cast<uint32_t>(entityIdChange >> 31));
+            m_NumTimestepBytes += writeVarint(m_TimestepBytes.data() + m_NumTimestepBytes, m_CurrentTimestep - m_PreviousTimestep);
+            m_PreviousEntityId = entityId;
+            m_PreviousTimestep = m_CurrentTimestep;
+
+            const bool hasStationId{stationId != -1};
+            if(hasStationId){
+                m_StationIds[m_NumBlockStationIds++] = stationId;
+            }
+            m_PackedEvents[m_NumBlockEvents] = static_cast<uint8_t>(type | fromState << 2 | toState << 4 | hasStationId << 6);
+            m_NumBlockEvents++;
+            m_NumEvents++;
+            if(m_NumBlockEvents == BLOCK_CAPACITY){
+                writeBlock();
+            }
+        };
+
+        /**
+        * @brief  Returns the number of events recorded
+        */
+        const size_t getNumEvents(){
+            return m_NumEvents;
+        };
+
+        /**
+        * @brief  Returns true if the trace file is open
+        */
+        const bool isOpen(){
+            return m_FileDescriptor != -1;
+        };
+
+        /**
+        * @brief  Writes any remaining events, trims the file to its contents and closes it
+        */
+        void close(){
+            if(m_FileDescriptor == -1){
+                return;
+            }
+            writeBlock();
+            if(m_MappedFile != nullptr){
+                munmap(m_MappedFile, m_MappedSize);
+                m_MappedFile = nullptr;
+            }
+            if(ftruncate(m_FileDescriptor, m_FileSize) != 0){
+                error("Error: Could not resize file {}", m_FileName);
+            }
+            ::close(m_FileDescriptor);
+            m_FileDescriptor = -1;
+        };
+
+        /**
+        * @brief  Maximum number of events in a block
+        */
+        static constexpr uint32_t BLOCK_CAPACITY{65536};
+
+    private:
+        /**
+        * @brief  Path of the trace file
+        */
+        const string m_FileName;
+
+        /**
+        * @brief  File descriptor of the trace file, -1 if closed
+        */
+        int m_FileDescriptor;
+
+        /**
+        * @brief  Memory-mapped contents of the trace file
+        */
+        char* m_MappedFile;
+
+        /**
+        * @brief  Size of the memory-mapped region (bytes)
+        */
+        size_t m_MappedSize;
+
+        /**
+        * @brief  Number of bytes written to the trace file
+        */
+        size_t m_FileSize;
+
+        /**
+        * @brief  Number of events recorded
+        */
+        size_t m_NumEvents;
+
+        /**
+        * @brief  Number of events in the current block
+        */
+        uint32_t m_NumBlockEvents;
+
+        /**
+        * @brief  Number of station ids in the current block
+        */
+        uint32_t m_NumBlockStationIds;
+
+        /**
+        * @brief  Number of bytes of encoded entity ids in the current block
+        */
+        uint32_t m_NumEntityIdBytes;
+
+        /**
+        * @brief  Number of bytes of encoded time steps in the current block
+        */
+        uint32_t m_NumTimestepBytes;
+
+        /**
+        * @brief  Time step of the first event in the current block
+        */
+        uint32_t m_BaseTimestep;
+
+        /**
+        * @brief  Time step of the previous event in the current block
+        */
+        uint32_t m_PreviousTimestep;
+
+        /**
+        * @brief  Entity id of the previous event in the current block
+        */
+        int32_t m_PreviousEntityId;
+
+        /**
+        * @brief  Time step of the events recorded next
+        */
+        uint32_t m_CurrentTimestep;
+
+        /**
+        * @brief  Columns of the current block
+        */
+        vector<int32_t> m_StationIds;
+        vector<uint8_t> m_PackedEvents;
+        vector<uint8_t> m_EntityIdBytes;
+        vector<uint8_t> m_TimestepBytes;
+
+        /**
+        * @brief  Maximum number of bytes of a 32-bit varint
+        */
+        static constexpr size_t MAX_VARINT_BYTES{5};
+
+        /**
+        * @brief  Minimum size of the memory-mapped region (bytes)
+        */
+        static constexpr size_t MIN_MAPPED_SIZE{size_t{16} << 20};
+
+        /**
+        * @brief  Writes a value as a varint (7 bits per byte, high bit set on all but the last byte). Returns the number of bytes written
+        */
+        static uint32_t writeVarint(uint8_t* bytes, uint32_t value){
+            uint32_t numBytes{0};
+            while(value >= 0x80){
+                bytes[numBytes++] = static_cast<uint8_t>(value | 0x80);
+                value >>= 7;
+            }
+            bytes[numBytes++] = static_cast<uint8_t>(value);
+            return numBytes;
+        };
+
+        /**
+        * @brief  Appends the current block to the trace file
+        */
+        void writeBlock(){
+            if(m_NumBlockEvents == 0){
+                return;
+            }
+
+            const uint32_t blockHeader[6]{m_NumBlockEvents, m_NumBlockStationIds, m_BaseTimestep, m_NumEntityIdBytes, m_NumTimestepBytes, 0};
+            appendBytes(blockHeader, sizeof(blockHeader));
+            appendBytes(m_StationIds.data(), m_NumBlockStationIds * sizeof(int32_t));
+            appendBytes(m_PackedEvents.data(), m_NumBlockEvents);
+            appendBytes(m_EntityIdBytes.data(), m_NumEntityIdBytes);
+            appendBytes(m_TimestepBytes.data(), m_NumTimestepBytes);
+            const uint8_t padding[4]{};
+            appendBytes(padding, (4 - (m_NumBlockEvents + m_NumEntityIdBytes + m_NumTimestepBytes) % 4) % 4);
+            m_NumBlockEvents = 0;
+            m_NumBlockStationIds = 0;
+            m_NumEntityIdBytes = 0;
+            m_NumTimestepBytes = 0;
+        };
+
+        /**
+        * @brief  Copies bytes to the end of the trace file, growing the file and its mapping when full
+        */
+        void appendBytes(const void* bytes, const size_t numBytes){
+            if(m_FileDescriptor == -1 || numBytes == 0){
+                return;
+            }
+            if(m_FileSize + numBytes > m_MappedSize && !growMapping(m_FileSize + numBytes)){
+                return;
+            }
+            memcpy(m_MappedFile + m_FileSize, bytes, numBytes);
+            m_FileSize += numBytes;
+        };
+
+        /**
+        * @brief  Grows the trace file and remaps it so it can hold at least minSize bytes. Returns false on failure
+        */
+        bool growMapping(const size_t minSize){
+            size_t mappedSize{max(m_MappedSize, MIN_MAPPED_SIZE)};
+            while(mappedSize < minSize){
+                mappedSize *= 2;
+            }
+
+            if(m_MappedFile != nullptr){
+                munmap(m_MappedFile, m_MappedSize);
+                m_MappedFile = nullptr;
+            }
+            if(ftruncate(m_FileDescriptor, mappedSize) != 0){
+                error("Error: Could not resize file {}", m_FileName);
+                ::close(m_FileDescriptor);
+                m_FileDescriptor = -1;
+                return false;
+            }
+            void* mappedFile{mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_FileDescriptor, 0)};
+            if(mappedFile == MAP_FAILED){
+                error("Error: Could not memory-map file {}", m_FileName);
+                ::close(m_FileDescriptor);
+                m_FileDescriptor = -1;
+                return false;
+            }
+            m_MappedFile = static_cast<char*>(mappedFile);
+            m_MappedSize = mappedSize;
+            return true;
+        };
+};
+
+/**
+* @class EventTraceReader
+* @brief Streams an event trace file back one block at a time, so the whole file is never held in memory
+*/
+class EventTraceReader{
+    public:
+        /**
+        * @brief  Constructs new 'EventTraceReader' object and reads the header of the trace file
+        */
+        EventTraceReader(const string& fileName) : m_InFile(fileName, ios::binary), m_Header(), m_Valid(false), m_StationIds(), m_PackedEvents(),
+                                                        m_EntityIdBytes(), m_TimestepBytes() {
+            if(!m_InFile){
+                error("Error: Could not open file {} for reading.", fileName);
+                return;
+            }
+            const EventTraceHeader expectedHeader{};
+            m_InFile.read(reinterpret_cast<char*>(&m_Header), sizeof(m_Header));
+            if(!m_InFile || memcmp(m_Header.magic, expectedHeader.magic, sizeof(m_Header.magic)) != 0){
+                error("Error: File {} is not an event trace.", fileName);
+                return;
+            }
+            if(m_Header.version != expectedHeader.version){
+                error("Error: Unsupported event trace version {} in file {}.", m_Header.version, fileName);
+                return;
+            }
+            m_Valid = true;
+        };
+
+        /**
+        * @brief  Returns true if the trace file was opened and has a valid header
+        */
+        const bool isValid(){
+            return m_Valid;
+        };
+
+        /**
+        * @brief  Returns the header of the trace file
+        */
+        const EventTraceHeader& getHeader(){
+            return m_Header;
+        };
+
+        /**
+        * @brief  Reads the next block of events. Returns false at the end of the file
+        */
+        bool readBlock(EventTraceBlock& block){
+            uint32_t blockHeader[6]{};
+            if(!m_Valid || !m_InFile.read(reinterpret_cast<char*>(blockHeader), sizeof(blockHeader))){
+                return false;
+            }
+            const uint32_t numEvents{blockHeader[0]};
+            const uint32_t numStationIds{blockHeader[1]};
+            const uint32_t numEntityIdBytes{blockHeader[3]};
+            const uint32_t numTimestepBytes{blockHeader[4]};
+            if(numEvents > m_Header.blockCapacity || numStationIds > numEvents || numEntityIdBytes > numEvents * 5 || numTimestepBytes > numEvents * 5){
+                return corruptBlock(numEvents);
+            }
+
+            // Read columns
+            m_StationIds.resize(numStationIds);
+            m_PackedEvents.resize(numEvents);
+            m_EntityIdBytes.resize(numEntityIdBytes);
+            m_TimestepBytes.resize(numTimestepBytes);
+            m_InFile.read(reinterpret_cast<char*>(m_StationIds.data()), numStationIds * sizeof(int32_t));
+            m_InFile.read(reinterpret_cast<char*>(m_PackedEvents.data()), numEvents);
+            m_InFile.read(reinterpret_cast<char*>(m_EntityIdBytes.data()), numEntityIdBytes);
+            m_InFile.read(reinterpret_cast<char*>(m_TimestepBytes.data()), numTimestepBytes);
+            m_InFile.ignore((4 - (numEvents + numEntityIdBytes + numTimestepBytes) % 4) % 4);
+            if(!m_InFile){
+                error("Error: Truncated event trace block.");
+                m_Valid = false;
+                return false;
+            }
+
+            // Decode columns
+            block.resize(numEvents);
+            size_t stationIdx{0};
+            size_t entityIdByteIdx{0};
+            size_t timestepByteIdx{0};
+            int32_t entityId{0};
+            uint32_t timestep{blockHeader[2]};
+            for(uint32_t i = 0; i < numEvents; i++){
+                uint32_t entityIdChange{0};
+                uint32_t timestepChange{0};
+                if(!readVarint(m_EntityIdBytes, entityIdByteIdx, entityIdChange) || !readVarint(m_TimestepBytes, timestepByteIdx, timestepChange)){
+                    return corruptBlock(numEvents);
+                }
+                entityId += static_cast<int32_t>((entityIdChange >> 1) ^ (~(entityIdChange & 1) + 1));
+                timestep += timestepChange;
+                block.entityId[i] = entityId;
+                block.timestep[i] = timestep;
+
+                const uint8_t packedEvent{m_PackedEvents[i]};
+                block.type[i] = packedEvent & 0x3;
+                block.fromState[i] = (packedEvent >> 2) & 0x3;
+                block.toState[i] = (packedEvent >> 4) & 0x3;
+                block.stationId[i] = -1;
+                if((packedEvent >> 6) & 1){
+                    if(stationIdx == numStationIds){
+                        return corruptBlock(numEvents);
+                    }
+                    block.stationId[i] = m_StationIds[stationIdx++];
+                }
+            }
+            return true;
+        };
+
+    private:
+        /**
+        * @brief  Trace file being read
+        */
+        ifstream m_InFile;
+
+        /**
+        * @brief  Header of the trace file
+        */
+        EventTraceHeader m_Header;
+
+        /**
+        * @brief  True while the trace file can be read
+        */
+        bool m_Valid;
+
+        /**
+        * @brief  Encoded columns of the block being read
+        */
+        vector<int32_t> m_StationIds;
+        vector<uint8_t> m_PackedEvents;
+        vector<uint8_t> m_EntityIdBytes;
+        vector<uint8_t> m_TimestepBytes;
+
+        /**
+        * @brief  Reads the varint starting at byteIdx and moves byteIdx past it. Returns false if the bytes run out
+        */
+        static bool readVarint(const vector<uint8_t>& bytes, size_t& byteIdx, uint32_t& value){
+            value = 0;
+            for(int shift = 0; shift < 35 && byteIdx < bytes.size(); shift += 7){
+                const uint8_t byte{bytes[byteIdx++]};
+                value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if((byte & 0x80) == 0){
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        /**
+        * @brief  Reports a corrupt block and stops reading. Returns false
+        */
+        bool corruptBlock(const uint32_t numEvents){
+            error("Error: Corrupt event trace block of {} events.", numEvents);
+            m_Valid = false;
+            return false;
+        };
+};
+
+#endif // EVENT_TRACE_H
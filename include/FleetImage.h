@@ -0,0 +1,81 @@
+#ifndef FLEET_IMAGE_H
+#define FLEET_IMAGE_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+/**
+* @brief  Constructs new 'FleetImageHeader' object. Header at the start of a fleet image file, holds the parameters the fleet was generated with
+*/
+struct FleetImageHeader{
+    char magic[8]{'M', 'S', 'F', 'L', 'E', 'E', 'T', '\0'};    // Identifies the file as a fleet image
+    uint32_t version{1};                                        // Version of the fleet image format
+    uint32_t replication{0};                                    // Index of the replication of the seed
+    uint64_t seed{0};                                           // Seed the mining durations were drawn with
+    uint64_t numMiningTrucks{0};                                // Number of mining trucks
+    float minMiningDuration_hrs{0};                             // Minimum mining duration (hrs)
+    float maxMiningDuration_hrs{0};                             // Maximum mining duration (hrs)
+};
+
+/**
+* @class FleetImage
+* @brief Reads and writes precomputed fleets. A fleet image holds a header followed by the mining duration of every truck as
+*        int32 ticks, so a fleet is loaded with one read instead of drawing every truck's duration
+*/
+class FleetImage{
+    public:
+        /**
+        * @brief  Writes a fleet image. Returns false if the file could not be written
+        * @param fileName Name of the fleet image file
+        * @param header Parameters the fleet was generated with
+        * @param miningDurations Mining duration of every truck (ticks)
+        */
+        static bool write(const string& fileName, FleetImageHeader header, const vector<int>& miningDurations){
+            header.numMiningTrucks = miningDurations.size();
+            ofstream outFile(fileName, ios::binary | ios::trunc);
+            outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            outFile.write(reinterpret_cast<const char*>(miningDurations.data()), miningDurations.size() * sizeof(int));
+            outFile.flush();
+            return outFile.good();
+        };
+
+        /**
+        * @brief  Reads a fleet image generated with the same parameters. Returns false, leaving miningDurations empty, if the file is
+        *         missing, invalid or was generated with other parameters
+        * @param fileName Name of the fleet image file
+        * @param expectedHeader Parameters the fleet must have been generated with
+        * @param miningDurations Set to the mining duration of every truck (ticks)
+        */
+        static bool read(const string& fileName, const FleetImageHeader& expectedHeader, vector<int>& miningDurations){
+            miningDurations.clear();
+            ifstream inFile(fileName, ios::binary);
+            FleetImageHeader header{};
+            if(!inFile.read(reinterpret_cast<char*>(&header), sizeof(header)) || !matches(header, expectedHeader)){
+                return false;
+            }
+            miningDurations.resize(header.numMiningTrucks);
+            if(!inFile.read(reinterpret_cast<char*>(miningDurations.data()), miningDurations.size() * sizeof(int))){
+                miningDurations.clear();
+                return false;
+            }
+            return true;
+        };
+
+    private:
+        /**
+        * @brief  Returns true if a header is a valid fleet image header with the expected parameters
+        */
+        static bool matches(const FleetImageHeader& header, const FleetImageHeader& expectedHeader){
+            return memcmp(header.magic, expectedHeader.magic, sizeof(header.magic)) == 0 && header.version == expectedHeader.version
+                    && header.replication == expectedHeader.replication && header.seed == expectedHeader.seed
+                    && header.numMiningTrucks == expectedHeader.numMiningTrucks && header.minMiningDuration_hrs == expectedHeader.minMiningDuration_hrs
+                    && header.maxMiningDuration_hrs == expectedHeader.maxMiningDuration_hrs;
+        };
+};
+
+#endif // FLEET_IMAGE_H
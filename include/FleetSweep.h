@@ -0,0 +1,375 @@
+#ifndef FLEET_SWEEP_H
+#define FLEET_SWEEP_H
+
+#include <Simulation.h>
+#include <ThreadPool.h>
+#include <numeric>
+#include <sstream>
+#include "spdlog/spdlog.h"
+
+using namespace std;
+using namespace spdlog;
+
+/**
+* @brief  Constructs new 'FleetSweepRanges' object. Holds the values of every swept parameter, the sweep runs every
+*         combination of them. Empty duration lists use the duration of the base parameters
+*/
+struct FleetSweepRanges{
+    vector<size_t> numMiningTrucks{};                           // Numbers of mining trucks
+    vector<size_t> numUnloadingStations{};                      // Numbers of unloading stations
+    vector<float> minMiningDurations_hrs{};                     // Minimum mining durations (hrs)
+    vector<float> maxMiningDurations_hrs{};                     // Maximum mining durations (hrs)
+    vector<float> travelDurations_hrs{};                        // Travel durations (hrs)
+    vector<float> unloadDurations_min{};                        // Unload durations (min)
+};
+
+/**
+* @brief  Constructs new 'FleetSweepResult' object. Summary of one configuration of the sweep
+*/
+struct FleetSweepResult{
+    SimulationParameters parameters{};                          // Parameters the configuration was simulated with
+    double throughput_per_hr{0};                                // Unloads per hour across all stations
+    double meanStationIdlePercent{0};                           // Mean percent idle time of the unloading stations
+    double meanTruckIdlePercent{0};                             // Mean percent idle time of the mining trucks
+    double fleetCost{0};                                        // Cost of the trucks and stations
+    bool meetsIdleThreshold{false};                             // True if mean station idle time is within the threshold
+    bool onParetoFrontier{false};                               // True if no cheaper configuration has at least the same throughput
+};
+
+/**
+* @class FleetSweep
+* @brief Simulates every combination of fleet sizes (and optionally durations) on a work-stealing thread pool and
+*        finds the Pareto frontier of throughput vs. fleet cost. Every configuration uses the seed of the base
+*        parameters, so configurations are compared on common random numbers
+*/
+class FleetSweep{
+    public:
+        /**
+        * @brief  Constructs new 'FleetSweep' object
+        * @param baseParameters Parameters used for every value that is not swept
+        * @param ranges Values of the swept parameters
+        * @param numThreads Number of worker threads, defaults to the number of hardware threads
+        * @param truckCost Cost of one mining truck
+        * @param stationCost Cost of one unloading station
+        * @param maxStationIdlePercent Highest mean station idle time (percent) a configuration may have to meet the threshold
+        */
+        FleetSweep(const SimulationParameters& baseParameters, const FleetSweepRanges& ranges, const size_t numThreads = thread::hardware_concurrency(),
+                    const double truckCost = 1, const double stationCost = 1, const double maxStationIdlePercent = 100) :
+                    m_BaseParameters(baseParameters), m_Ranges(ranges), m_NumThreads(numThreads), m_TruckCost(truckCost), m_StationCost(stationCost),
+                    m_MaxStationIdlePercent(maxStationIdlePercent), m_Results(), m_LiveMetrics(nullptr) {};
+
+        /**
+        * @brief  Sets the live metrics the configurations publish their time steps and progress to, or nullptr to stop publishing
+        */
+        void setLiveMetrics(LiveMetrics* liveMetrics){
+            m_LiveMetrics = liveMetrics;
+        };
+
+        /**
+        * @brief  Simulates every configuration of the sweep and finds the Pareto frontier
+        */
+        void run(){
+            initResults();
+            if(m_LiveMetrics != nullptr){
+                m_LiveMetrics->setNumRuns(m_Results.size());
+            }
+
+            // Submit the largest configurations first so they do not finish last, each writes to its own result slot
+            vector<size_t> submissionOrder(m_Results.size());
+            iota(submissionOrder.begin(), submissionOrder.end(), 0);
+            stable_sort(submissionOrder.begin(), submissionOrder.end(), [this](const size_t a, const size_t b){
+                return estimateWork(m_Results[a].parameters) > estimateWork(m_Results[b].parameters);
+            });
+            {
+                ThreadPool threadPool(m_NumThreads);
+                vector<future<void>> configurationFutures{};
+                for(size_t idx : submissionOrder){
+                    configurationFutures.push_back(threadPool.submit([this, idx](){ runConfiguration(m_Results[idx]); }));
+                }
+                for(future<void>& configurationFuture : configurationFutures){
+                    configurationFuture.get();
+                }
+            }
+
+            findParetoFrontier();
+        };
+
+        /**
+        * @brief  Returns the results of every configuration, in sweep order (trucks, then stations, then durations)
+        */
+        const vector<FleetSweepResult>& getResults(){
+            return m_Results;
+        };
+
+        /**
+        * @brief  Returns the indices of the configurations on the Pareto frontier, in order of increasing fleet cost
+        */
+        vector<size_t> getParetoFrontier(){
+            vector<size_t> frontier{};
+            for(size_t idx : getCostOrder()){
+                if(m_Results[idx].onParetoFrontier){
+                    frontier.push_back(idx);
+                }
+            }
+            return frontier;
+        };
+
+        /**
+        * @brief  Returns the index of the cheapest configuration that meets the idle threshold (highest throughput on ties),
+        *         or -1 if none does
+        */
+        int getCheapestConfigurationIdx(){
+            for(size_t idx : getCostOrder()){
+                if(m_Results[idx].meetsIdleThreshold){
+                    return static_cast<int>(idx);
+                }
+            }
+            return -1;
+        };
+
+        /**
+        * @brief  Prints the results of every configuration, the Pareto frontier and the cheapest configuration meeting the idle threshold
+        */
+        void printResults(){
+            cout << "Fleet Sweep Results (" << m_Results.size() << " configurations): " << endl;
+            printHeader();
+            for(const FleetSweepResult& result : m_Results){
+                printResult(result);
+            }
+
+            cout << "Pareto Frontier (throughput vs. fleet cost): " << endl;
+            printHeader();
+            for(size_t idx : getParetoFrontier()){
+                printResult(m_Results[idx]);
+            }
+
+            const int cheapestIdx{getCheapestConfigurationIdx()};
+            if(cheapestIdx == -1){
+                cout << "No configuration keeps mean station idle time within " << fixed << setprecision(2) << m_MaxStationIdlePercent << "%" << endl;
+                return;
+            }
+            cout << "Cheapest configuration with mean station idle time within " << fixed << setprecision(2) << m_MaxStationIdlePercent << "%: " << endl;
+            printHeader();
+            printResult(m_Results[cheapestIdx]);
+        };
+
+        /**
+         * @brief Writes the results of every configuration to one CSV file.
+         * @param fileName Base name of the file to save.
+         * @param resultsDir Name of the results directory to save file in.
+         */
+        void writeResultsToCSV(const string& fileName, const string& resultsDir){
+            // Check that results directory exists
+            if (!Simulation::createResultsDirectory(resultsDir)) {
+                return;
+            }
+
+            // Append date and time to fileName
+            string fullFileName = getUniqueResultFileName(resultsDir, fileName, ".csv");
+
+            // Open file in write mode
+            CsvWriter csvWriter(fullFileName);
+            if (!csvWriter.good()) {
+                error("Error: Could not open file {} for writing.", fullFileName);
+                return;
+            }
+
+            // Write CSV header
+            csvWriter.write("Mining Trucks,Unloading Stations,Min Mining Duration (hrs),Max Mining Duration (hrs),Travel Duration (hrs),"
+                            "Unload Duration (min),Throughput (unloads/hr),Mean Station Idle Time (%),Mean Truck Idle Time (%),Fleet Cost,"
+                            "Meets Idle Threshold,Pareto Frontier").endRow();
+
+            // Write data to csv file
+            for(const FleetSweepResult& result : m_Results){
+                const SimulationParameters& parameters{result.parameters};
+                csvWriter.write(parameters.numMiningTrucks).write(parameters.numUnloadingStations)
+                        .write(parameters.minMiningDuration_hrs, 4).write(parameters.maxMiningDuration_hrs, 4)
+                        .write(parameters.travelDuration_hrs, 4).write(parameters.unloadDuration_min, 4)
+                        .write(result.throughput_per_hr, 4).write(result.meanStationIdlePercent, 4)
+                        .write(result.meanTruckIdlePercent, 4).write(result.fleetCost, 4)
+                        .write(static_cast<int>(result.meetsIdleThreshold)).write(static_cast<int>(result.onParetoFrontier)).endRow();
+            }
+            if (!csvWriter.close()) {
+                error("Error: Could not write file {}", fullFileName);
+                return;
+            }
+            info("Fleet sweep results written to file: {}", fullFileName);
+        };
+
+    private:
+        /**
+        * @brief  Parameters used for every value that is not swept
+        */
+        const SimulationParameters m_BaseParameters;
+
+        /**
+        * @brief  Values of the swept parameters
+        */
+        const FleetSweepRanges m_Ranges;
+
+        /**
+        * @brief  Number of worker threads
+        */
+        const size_t m_NumThreads;
+
+        /**
+        * @brief  Cost of one mining truck
+        */
+        const double m_TruckCost;
+
+        /**
+        * @brief  Cost of one unloading station
+        */
+        const double m_StationCost;
+
+        /**
+        * @brief  Highest mean station idle time (percent) a configuration may have to meet the threshold
+        */
+        const double m_MaxStationIdlePercent;
+
+        /**
+        * @brief  Results of every configuration, in sweep order
+        */
+        vector<FleetSweepResult> m_Results;
+
+        /**
+        * @brief  Live metrics the configurations publish to, nullptr if not publishing
+        */
+        LiveMetrics* m_LiveMetrics;
+
+        /**
+        * @brief  Creates a result for every combination of the swept parameters. Skips combinations with a minimum mining
+        *         duration above the maximum
+        */
+        void initResults(){
+            const vector<float> minMiningDurations{valuesOrBase(m_Ranges.minMiningDurations_hrs, m_BaseParameters.minMiningDuration_hrs)};
+            const vector<float> maxMiningDurations{valuesOrBase(m_Ranges.maxMiningDurations_hrs, m_BaseParameters.maxMiningDuration_hrs)};
+            const vector<float> travelDurations{valuesOrBase(m_Ranges.travelDurations_hrs, m_BaseParameters.travelDuration_hrs)};
+            const vector<float> unloadDurations{valuesOrBase(m_Ranges.unloadDurations_min, m_BaseParameters.unloadDuration_min)};
+
+            m_Results.clear();
+            for(size_t numMiningTrucks : m_Ranges.numMiningTrucks){
+                for(size_t numUnloadingStations : m_Ranges.numUnloadingStations){
+                    for(float minMiningDuration : minMiningDurations){
+                        for(float maxMiningDuration : maxMiningDurations){
+                            if(minMiningDuration > maxMiningDuration){
+                                continue;
+                            }
+                            for(float travelDuration : travelDurations){
+                                for(float unloadDuration : unloadDurations){
+                                    FleetSweepResult result{};
+                                    result.parameters = m_BaseParameters;
+                                    result.parameters.numMiningTrucks = numMiningTrucks;
+                                    result.parameters.numUnloadingStations = numUnloadingStations;
+                                    result.parameters.minMiningDuration_hrs = minMiningDuration;
+                                    result.parameters.maxMiningDuration_hrs = maxMiningDuration;
+                                    result.parameters.travelDuration_hrs = travelDuration;
+                                    result.parameters.unloadDuration_min = unloadDuration;
+                                    result.fleetCost = numMiningTrucks * m_TruckCost + numUnloadingStations * m_StationCost;
+                                    m_Results.push_back(result);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        /**
+        * @brief  Returns the swept values of a duration, or the base value if it is not swept
+        */
+        static vector<float> valuesOrBase(const vector<float>& values, const float baseValue){
+            return values.empty() ? vector<float>{baseValue} : values;
+        };
+
+        /**
+        * @brief  Returns an estimate of the relative run time of a configuration
+        */
+        static double estimateWork(const SimulationParameters& parameters){
+            return static_cast<double>(parameters.numMiningTrucks + parameters.numUnloadingStations) * parameters.simulationTime_hrs;
+        };
+
+        /**
+        * @brief  Simulates one configuration and saves its summary
+        */
+        void runConfiguration(FleetSweepResult& result){
+            Simulation simulation(result.parameters);
+            simulation.setLiveMetrics(m_LiveMetrics);
+            simulation.run();
+            if(m_LiveMetrics != nullptr){
+                m_LiveMetrics->completeRun();
+            }
+
+            double totalUnloads{0};
+            double totalStationIdlePercent{0};
+            const vector<StationPerformanceStats>& stationPerformances{simulation.getUnloadingStationPerformances()};
+            for(const StationPerformanceStats& stats : stationPerformances){
+                totalUnloads += stats.totalUnloads;
+                totalStationIdlePercent += stats.percentIdleTime;
+            }
+            double totalTruckIdlePercent{0};
+            const vector<TruckPerformanceStats>& truckPerformances{simulation.getMiningTruckPerformances()};
+            for(const TruckPerformanceStats& stats : truckPerformances){
+                totalTruckIdlePercent += stats.percentIdleTime;
+            }
+
+            result.throughput_per_hr = totalUnloads / result.parameters.simulationTime_hrs;
+            result.meanStationIdlePercent = stationPerformances.empty() ? 0 : totalStationIdlePercent / stationPerformances.size();
+            result.meanTruckIdlePercent = truckPerformances.empty() ? 0 : totalTruckIdlePercent / truckPerformances.size();
+            result.meetsIdleThreshold = result.meanStationIdlePercent <= m_MaxStationIdlePercent;
+        };
+
+        /**
+        * @brief  Returns the indices of all configurations in order of increasing fleet cost, then decreasing throughput, then sweep order
+        */
+        vector<size_t> getCostOrder(){
+            vector<size_t> costOrder(m_Results.size());
+            iota(costOrder.begin(), costOrder.end(), 0);
+            stable_sort(costOrder.begin(), costOrder.end(), [this](const size_t a, const size_t b){
+                if(m_Results[a].fleetCost != m_Results[b].fleetCost){
+                    return m_Results[a].fleetCost < m_Results[b].fleetCost;
+                }
+                return m_Results[a].throughput_per_hr > m_Results[b].throughput_per_hr;
+            });
+            return costOrder;
+        };
+
+        /**
+        * @brief  Marks every configuration with a higher throughput than all cheaper configurations as on the Pareto frontier
+        */
+        void findParetoFrontier(){
+            double bestThroughput{-1};
+            for(size_t idx : getCostOrder()){
+                FleetSweepResult& result{m_Results[idx]};
+                result.onParetoFrontier = result.throughput_per_hr > bestThroughput;
+                if(result.onParetoFrontier){
+                    bestThroughput = result.throughput_per_hr;
+                }
+            }
+        };
+
+        /**
+        * @brief  Prints the column names of the results table
+        */
+        static void printHeader(){
+            cout << setw(8) << "Trucks" << setw(10) << "Stations" << setw(12) << "Mining(hrs)" << setw(13) << "Travel(hrs)"
+                    << setw(13) << "Unload(min)" << setw(17) << "Throughput(/hr)" << setw(17) << "Station Idle(%)"
+                    << setw(15) << "Truck Idle(%)" << setw(12) << "Fleet Cost" << setw(9) << "Idle OK" << setw(8) << "Pareto" << endl;
+        };
+
+        /**
+        * @brief  Prints one row of the results table
+        */
+        static void printResult(const FleetSweepResult& result){
+            const SimulationParameters& parameters{result.parameters};
+            ostringstream miningDuration{};
+            miningDuration << fixed << setprecision(1) << parameters.minMiningDuration_hrs << "-" << parameters.maxMiningDuration_hrs;
+            cout << setw(8) << parameters.numMiningTrucks << setw(10) << parameters.numUnloadingStations << setw(12) << miningDuration.str()
+                    << fixed << setprecision(2) << setw(13) << parameters.travelDuration_hrs << setw(13) << parameters.unloadDuration_min
+                    << setw(17) << result.throughput_per_hr << setw(17) << result.meanStationIdlePercent
+                    << setw(15) << result.meanTruckIdlePercent << setw(12) << result.fleetCost
+                    << setw(9) << (result.meetsIdleThreshold ? "yes" : "no") << setw(8) << (result.onParetoFrontier ? "*" : "") << endl;
+        };
+};
+
+#endif // FLEET_SWEEP_H
@@ -0,0 +1,278 @@
+#ifndef LIVE_METRICS_H
+#define LIVE_METRICS_H
+
+#include <MiningTruck.h>
+#include <MiningTruckFleet.h>
+#include <UnloadingStation.h>
+#include <SimulationTime.h>
+#include <atomic>
+#include <array>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <sstream>
+#include <cstdint>
+
+using namespace std;
+
+/**
+* @class LiveMetrics
+* @brief Progress of running simulations, published by the simulation threads and read by a metrics exporter while they run.
+*        Every value is a lock-free atomic: publishers only store and add with relaxed ordering and never wait for readers, and
+*        readers never block publishers. Several simulations (replications or sweep configurations) may publish to the same metrics
+*/
+class LiveMetrics{
+    public:
+        /**
+        * @brief  Number of truck states counted by snapshots (MINING, TRAVEL, UNLOAD)
+        */
+        static constexpr size_t NUM_TRUCK_STATES{3};
+
+        /**
+        * @brief  Constructs new 'LiveMetrics' object publishing the queue lengths of up to maxStations stations
+        */
+        LiveMetrics(const size_t maxStations = 0) : m_StartTime(chrono::steady_clock::now()), m_SimulationTime_ticks(0), m_NumSimulatedTicks(0),
+                    m_NumTimesteps(0), m_NumTruckStateChanges(0), m_TruckStateCounts(), m_MaxStations(maxStations), m_NumStations(0),
+                    m_StationQueueLengths(make_unique<atomic<int>[]>(maxStations)), m_NumRuns(0), m_NumRunsCompleted(0), m_SnapshotRequested(false),
+                    m_NumSnapshots(0), m_ScrapeMutex(), m_LastScrapeTime(m_StartTime), m_LastScrapeTicks(0), m_LastScrapeStateChanges(0) {
+            for(atomic<uint64_t>& count : m_TruckStateCounts){
+                count.store(0, memory_order_relaxed);
+            }
+            for(size_t i = 0; i < m_MaxStations; i++){
+                m_StationQueueLengths[i].store(0, memory_order_relaxed);
+            }
+        };
+
+        /**
+        * @brief  Publishes the end of a time step: the simulation time the step started at, the simulated ticks since the previous
+        *         time step published by the same simulation and the truck state changes in between
+        */
+        void publishTimestep(const SimulationTicks simulationTime, const SimulationTicks numTicks, const uint64_t numTruckStateChanges){
+            m_SimulationTime_ticks.store(simulationTime, memory_order_relaxed);
+            m_NumSimulatedTicks.fetch_add(numTicks, memory_order_relaxed);
+            m_NumTimesteps.fetch_add(1, memory_order_relaxed);
+            m_NumTruckStateChanges.fetch_add(numTruckStateChanges, memory_order_relaxed);
+        };
+
+        /**
+        * @brief  Returns true if a reader is waiting for a snapshot of the truck state counts and station queue lengths. Costs one
+        *         relaxed load, so it is checked every time step
+        */
+        bool isSnapshotRequested() const {
+            return m_SnapshotRequested.load(memory_order_relaxed);
+        };
+
+        /**
+        * @brief  Publishes the number of trucks in each state and the queue length of every station, if a snapshot is still requested
+        * @param stations List of all unloading stations in the simulation
+        * @param miningTrucksList List (or struct-of-arrays fleet) of all mining trucks in the simulation
+        */
+        template<typename TruckList>
+        void publishSnapshot(const vector<Station>& stations, const TruckList& miningTrucksList){
+            // Only one of the simulations publishing to these metrics takes each request
+            if(!m_SnapshotRequested.exchange(false, memory_order_relaxed)){
+                return;
+            }
+            const array<size_t, NUM_TRUCK_STATES> truckStateCounts{countTruckStates<NUM_TRUCK_STATES>(miningTrucksList)};
+            for(size_t state = 0; state < NUM_TRUCK_STATES; state++){
+                m_TruckStateCounts[state].store(truckStateCounts[state], memory_order_relaxed);
+            }
+            const size_t numStations{min(stations.size(), m_MaxStations)};
+            for(size_t i = 0; i < numStations; i++){
+                m_StationQueueLengths[i].store(static_cast<int>(stations[i].vehicleIdQueue.size()), memory_order_relaxed);
+            }
+            m_NumStations.store(numStations, memory_order_relaxed);
+            m_NumSnapshots.fetch_add(1, memory_order_release);
+        };
+
+        /**
+        * @brief  Sets the number of runs (replications or sweep configurations) in progress
+        */
+        void setNumRuns(const uint64_t numRuns){
+            m_NumRuns.store(numRuns, memory_order_relaxed);
+            m_NumRunsCompleted.store(0, memory_order_relaxed);
+        };
+
+        /**
+        * @brief  Publishes the completion of a run
+        */
+        void completeRun(){
+            m_NumRunsCompleted.fetch_add(1, memory_order_relaxed);
+        };
+
+        /**
+        * @brief  Requests a snapshot from the publishing simulations and waits up to timeout for one. Returns false if no simulation
+        *         published one in time (for example between runs), the previous snapshot is kept. Only the reader waits
+        */
+        bool requestSnapshot(const chrono::milliseconds timeout){
+            const uint64_t numSnapshots{m_NumSnapshots.load(memory_order_acquire)};
+            m_SnapshotRequested.store(true, memory_order_relaxed);
+            const chrono::steady_clock::time_point deadline{chrono::steady_clock::now() + timeout};
+            while(m_NumSnapshots.load(memory_order_acquire) == numSnapshots){
+                if(chrono::steady_clock::now() >= deadline){
+                    return false;
+                }
+                this_thread::sleep_for(chrono::microseconds(200));
+            }
+            return true;
+        };
+
+        /**
+        * @brief  Returns the metrics in the Prometheus text exposition format. Rates are averaged over the time since the previous call,
+        *         or since the metrics were constructed for the first call
+        */
+        string toPrometheusText(){
+            const uint64_t numSimulatedTicks{m_NumSimulatedTicks.load(memory_order_relaxed)};
+            const uint64_t numTruckStateChanges{m_NumTruckStateChanges.load(memory_order_relaxed)};
+
+            // Rates since the previous scrape, readers only share this state with each other
+            double ticksPerSecond{0};
+            double eventsPerSecond{0};
+            {
+                lock_guard<mutex> lock(m_ScrapeMutex);
+                const chrono::steady_clock::time_point now{chrono::steady_clock::now()};
+                const double elapsed_s{chrono::duration<double>(now - m_LastScrapeTime).count()};
+                if(elapsed_s > 0){
+                    ticksPerSecond = (numSimulatedTicks - m_LastScrapeTicks) / elapsed_s;
+                    eventsPerSecond = (numTruckStateChanges - m_LastScrapeStateChanges) / elapsed_s;
+                }
+                m_LastScrapeTime = now;
+                m_LastScrapeTicks = numSimulatedTicks;
+                m_LastScrapeStateChanges = numTruckStateChanges;
+            }
+
+            ostringstream text{};
+            writeMetric(text, "mining_simulation_uptime_seconds", "gauge", "Wall time since the metrics were created",
+                        chrono::duration<double>(chrono::steady_clock::now() - m_StartTime).count());
+            writeMetric(text, "mining_simulation_simulated_time_hours", "gauge", "Simulation time of the last published time step",
+                        ticksToHours(m_SimulationTime_ticks.load(memory_order_relaxed)));
+            writeMetric(text, "mining_simulation_simulated_ticks_total", "counter", "Simulated ticks (seconds) of every run", numSimulatedTicks);
+            writeMetric(text, "mining_simulation_ticks_per_second", "gauge", "Simulated ticks per wall second since the previous scrape", ticksPerSecond);
+            writeMetric(text, "mining_simulation_timesteps_total", "counter", "Time steps processed by every run", m_NumTimesteps.load(memory_order_relaxed));
+            writeMetric(text, "mining_simulation_truck_state_changes_total", "counter", "Truck state changes of every run", numTruckStateChanges);
+            writeMetric(text, "mining_simulation_events_per_second", "gauge", "Truck state changes per wall second since the previous scrape", eventsPerSecond);
+
+            static const char* TRUCK_STATE_NAMES[NUM_TRUCK_STATES]{"mining", "travel", "unload"};
+            writeHeader(text, "mining_simulation_trucks", "gauge", "Trucks in each state at the last snapshot");
+            for(size_t state = 0; state < NUM_TRUCK_STATES; state++){
+                text << "mining_simulation_trucks{state=\"" << TRUCK_STATE_NAMES[state] << "\"} " << m_TruckStateCounts[state].load(memory_order_relaxed) << "\n";
+            }
+            writeHeader(text, "mining_simulation_station_queue_length", "gauge", "Trucks queued at each station at the last snapshot");
+            const size_t numStations{m_NumStations.load(memory_order_relaxed)};
+            for(size_t i = 0; i < numStations; i++){
+                text << "mining_simulation_station_queue_length{station=\"" << i << "\"} " << m_StationQueueLengths[i].load(memory_order_relaxed) << "\n";
+            }
+
+            writeMetric(text, "mining_simulation_runs", "gauge", "Runs (replications or sweep configurations) to complete", m_NumRuns.load(memory_order_relaxed));
+            writeMetric(text, "mining_simulation_runs_completed", "gauge", "Runs completed", m_NumRunsCompleted.load(memory_order_relaxed));
+            return text.str();
+        };
+
+    private:
+        /**
+        * @brief  Time the metrics were created
+        */
+        const chrono::steady_clock::time_point m_StartTime;
+
+        /**
+        * @brief  Simulation time of the last published time step (ticks)
+        */
+        atomic<int64_t> m_SimulationTime_ticks;
+
+        /**
+        * @brief  Simulated ticks of every run
+        */
+        atomic<uint64_t> m_NumSimulatedTicks;
+
+        /**
+        * @brief  Time steps processed by every run
+        */
+        atomic<uint64_t> m_NumTimesteps;
+
+        /**
+        * @brief  Truck state changes of every run
+        */
+        atomic<uint64_t> m_NumTruckStateChanges;
+
+        /**
+        * @brief  Trucks in each state at the last snapshot
+        */
+        array<atomic<uint64_t>, NUM_TRUCK_STATES> m_TruckStateCounts;
+
+        /**
+        * @brief  Most stations whose queue lengths are published
+        */
+        const size_t m_MaxStations;
+
+        /**
+        * @brief  Stations whose queue lengths were published by the last snapshot
+        */
+        atomic<size_t> m_NumStations;
+
+        /**
+        * @brief  Queue length of every station at the last snapshot
+        */
+        unique_ptr<atomic<int>[]> m_StationQueueLengths;
+
+        /**
+        * @brief  Runs to complete
+        */
+        atomic<uint64_t> m_NumRuns;
+
+        /**
+        * @brief  Runs completed
+        */
+        atomic<uint64_t> m_NumRunsCompleted;
+
+        /**
+        * @brief  True while a reader waits for a snapshot
+        */
+        atomic<bool> m_SnapshotRequested;
+
+        /**
+        * @brief  Number of snapshots published
+        */
+        atomic<uint64_t> m_NumSnapshots;
+
+        /**
+        * @brief  Guards the state of the previous scrape, only taken by readers
+        */
+        mutex m_ScrapeMutex;
+
+        /**
+        * @brief  Time of the previous scrape
+        */
+        chrono::steady_clock::time_point m_LastScrapeTime;
+
+        /**
+        * @brief  Simulated ticks at the previous scrape
+        */
+        uint64_t m_LastScrapeTicks;
+
+        /**
+        * @brief  Truck state changes at the previous scrape
+        */
+        uint64_t m_LastScrapeStateChanges;
+
+        /**
+        * @brief  Writes the help and type lines of a metric
+        */
+        static void writeHeader(ostringstream& text, const char* name, const char* type, const char* help){
+            text << "# HELP " << name << " " << help << "\n# TYPE " << name << " " << type << "\n";
+        };
+
+        /**
+        * @brief  Writes a metric without labels
+        */
+        template<typename Value>
+        static void writeMetric(ostringstream& text, const char* name, const char* type, const char* help, const Value value){
+            writeHeader(text, name, type, help);
+            text << name << " " << value << "\n";
+        };
+
+};
+
+#endif // LIVE_METRICS_H
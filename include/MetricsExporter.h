@@ -0,0 +1,263 @@
+#ifndef METRICS_EXPORTER_H
+#define METRICS_EXPORTER_H
+
+#include <LiveMetrics.h>
+#include <atomic>
+#include <thread>
+#include <string>
+#include <cstring>
+#include <cerrno>
+#include <cstdint>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#include "spdlog/spdlog.h"
+
+using namespace std;
+using namespace spdlog;
+
+/**
+* @class MetricsExporter
+* @brief Serves live metrics in the Prometheus text format over HTTP, on a localhost TCP port or a Unix domain socket, from a
+*        thread of its own. Every request (GET /metrics) asks the running simulations for a fresh snapshot, waiting at most
+*        SNAPSHOT_TIMEOUT for it, so scrapes never stall the simulation threads
+*/
+class MetricsExporter{
+    public:
+        /**
+        * @brief  Longest time a request waits for a snapshot of the running simulations
+        */
+        static constexpr chrono::milliseconds SNAPSHOT_TIMEOUT{100};
+
+        /**
+        * @brief  Constructs new stopped 'MetricsExporter' object serving liveMetrics
+        */
+        MetricsExporter(LiveMetrics& liveMetrics) : m_LiveMetrics(liveMetrics), m_ListenSocket(-1), m_Port(0), m_SocketPath(), m_Running(false), m_ServeThread() {};
+
+        MetricsExporter(const MetricsExporter&) = delete;
+        MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+        /**
+        * @brief  Stops serving
+        */
+        ~MetricsExporter(){
+            stop();
+        };
+
+        /**
+        * @brief  Starts serving on 127.0.0.1:port, on a free port chosen by the system if port is 0 (see getPort). Returns false
+        *         if the port could not be bound
+        */
+        bool startTcp(const uint16_t port){
+            stop();
+            m_ListenSocket = socket(AF_INET, SOCK_STREAM, 0);
+            if(m_ListenSocket < 0){
+                error("MetricsExporter Error: Socket could not be created: {}", strerror(errno));
+                return false;
+            }
+            const int reuseAddress{1};
+            setsockopt(m_ListenSocket, SOL_SOCKET, SO_REUSEADDR, &reuseAddress, sizeof(reuseAddress));
+
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            address.sin_port = htons(port);
+            if(bind(m_ListenSocket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(m_ListenSocket, 16) != 0){
+                error("MetricsExporter Error: Port {} could not be bound: {}", port, strerror(errno));
+                closeListenSocket();
+                return false;
+            }
+
+            // Read back the port chosen by the system
+            socklen_t addressLength{sizeof(address)};
+            getsockname(m_ListenSocket, reinterpret_cast<sockaddr*>(&address), &addressLength);
+            m_Port = ntohs(address.sin_port);
+            startServing();
+            return true;
+        };
+
+        /**
+        * @brief  Starts serving on a Unix domain socket at path, replacing any file there. Returns false if the socket could not be bound
+        */
+        bool startUnixSocket(const string& path){
+            stop();
+            sockaddr_un address{};
+            if(path.empty() || path.size() >= sizeof(address.sun_path)){
+                error("MetricsExporter Error: Invalid socket path: {}", path);
+                return false;
+            }
+            m_ListenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+            if(m_ListenSocket < 0){
+                error("MetricsExporter Error: Socket could not be created: {}", strerror(errno));
+                return false;
+            }
+
+            address.sun_family = AF_UNIX;
+            memcpy(address.sun_path, path.c_str(), path.size());
+            unlink(path.c_str());
+            if(bind(m_ListenSocket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(m_ListenSocket, 16) != 0){
+                error("MetricsExporter Error: Socket {} could not be bound: {}", path, strerror(errno));
+                closeListenSocket();
+                return false;
+            }
+            m_SocketPath = path;
+            startServing();
+            return true;
+        };
+
+        /**
+        * @brief  Stops serving and closes the socket, removing the Unix domain socket file
+        */
+        void stop(){
+            m_Running.store(false);
+            if(m_ServeThread.joinable()){
+                m_ServeThread.join();
+            }
+            closeListenSocket();
+            if(!m_SocketPath.empty()){
+                unlink(m_SocketPath.c_str());
+                m_SocketPath.clear();
+            }
+            m_Port = 0;
+        };
+
+        /**
+        * @brief  Returns the TCP port served on, 0 if not serving on a TCP port
+        */
+        uint16_t getPort() const {
+            return m_Port;
+        };
+
+        /**
+        * @brief  Returns true while serving
+        */
+        bool isRunning() const {
+            return m_Running.load();
+        };
+
+    private:
+        /**
+        * @brief  Longest time the serving thread waits for a connection before checking whether it was stopped
+        */
+        static constexpr int POLL_TIMEOUT_MS{50};
+
+        /**
+        * @brief  Largest request read, the rest of a longer request is ignored
+        */
+        static constexpr size_t MAX_REQUEST_SIZE{4096};
+
+        /**
+        * @brief  Metrics served
+        */
+        LiveMetrics& m_LiveMetrics;
+
+        /**
+        * @brief  Listening socket, -1 when closed
+        */
+        int m_ListenSocket;
+
+        /**
+        * @brief  TCP port served on, 0 if not serving on a TCP port
+        */
+        uint16_t m_Port;
+
+        /**
+        * @brief  Path of the Unix domain socket served on, empty if not serving on one
+        */
+        string m_SocketPath;
+
+        /**
+        * @brief  True while serving
+        */
+        atomic<bool> m_Running;
+
+        /**
+        * @brief  Thread accepting and answering requests
+        */
+        thread m_ServeThread;
+
+        /**
+        * @brief  Starts the serving thread on the bound listening socket
+        */
+        void startServing(){
+            m_Running.store(true);
+            m_ServeThread = thread([this](){ serve(); });
+        };
+
+        /**
+        * @brief  Closes the listening socket
+        */
+        void closeListenSocket(){
+            if(m_ListenSocket >= 0){
+                close(m_ListenSocket);
+                m_ListenSocket = -1;
+            }
+        };
+
+        /**
+        * @brief  Answers one connection at a time until stopped
+        */
+        void serve(){
+            while(m_Running.load()){
+                pollfd listenPoll{m_ListenSocket, POLLIN, 0};
+                if(poll(&listenPoll, 1, POLL_TIMEOUT_MS) <= 0){
+                    continue;
+                }
+                const int connection{accept(m_ListenSocket, nullptr, nullptr)};
+                if(connection < 0){
+                    continue;
+                }
+                handleConnection(connection);
+                close(connection);
+            }
+        };
+
+        /**
+        * @brief  Reads an HTTP request and answers GET /metrics with the metrics, any other request with 404
+        */
+        void handleConnection(const int connection){
+            // Read until the end of the request headers, giving up on clients that stop sending
+            string request{};
+            char buffer[512];
+            while(request.size() < MAX_REQUEST_SIZE && request.find("\r\n\r\n") == string::npos){
+                pollfd connectionPoll{connection, POLLIN, 0};
+                if(poll(&connectionPoll, 1, 1000) <= 0){
+                    break;
+                }
+                const ssize_t numRead{recv(connection, buffer, sizeof(buffer), 0)};
+                if(numRead <= 0){
+                    break;
+                }
+                request.append(buffer, numRead);
+            }
+
+            if(request.rfind("GET /metrics ", 0) == 0 || request.rfind("GET / ", 0) == 0){
+                m_LiveMetrics.requestSnapshot(SNAPSHOT_TIMEOUT);
+                sendResponse(connection, "200 OK", "text/plain; version=0.0.4", m_LiveMetrics.toPrometheusText());
+            }
+            else{
+                sendResponse(connection, "404 Not Found", "text/plain", "Not Found\n");
+            }
+        };
+
+        /**
+        * @brief  Sends an HTTP response and closes the exchange
+        */
+        static void sendResponse(const int connection, const string& status, const string& contentType, const string& body){
+            const string response{"HTTP/1.1 " + status + "\r\nContent-Type: " + contentType + "\r\nContent-Length: " + to_string(body.size()) +
+                                    "\r\nConnection: close\r\n\r\n" + body};
+            size_t numSent{0};
+            while(numSent < response.size()){
+                const ssize_t sent{send(connection, response.data() + numSent, response.size() - numSent, MSG_NOSIGNAL)};
+                if(sent <= 0){
+                    return;
+                }
+                numSent += sent;
+            }
+        };
+};
+
+#endif // METRICS_EXPORTER_H
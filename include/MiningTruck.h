@@ -1,6 +1,9 @@
 #ifndef MINING_TRUCK_H
 #define MINING_TRUCK_H
 
+#include <SimulationTime.h>
+#include <StateMachine.h>
+
 using namespace std;
 
  /**
@@ -12,22 +15,80 @@ enum TruckStates {
     UNLOAD
     };
 
+ /**
+  * @brief Defines the durations a truck state can last, indexing the durations passed to the truck state machine
+  */
+enum TruckStateDurations {
+    STATE_MINING_DURATION,      // Truck's own mining cycle duration
+    STATE_TRAVEL_DURATION,      // Travel duration shared by all trucks
+    STATE_UNLOAD_DURATION,      // Unload duration shared by all trucks
+    NUM_STATE_DURATIONS
+    };
+
+ /**
+  * @brief Defines the cycle counts of a truck, the one counted per time step in a state
+  */
+enum TruckCycleCounts {
+    MINING_CYCLES,              // numMiningCycles
+    TRAVEL_CYCLES,              // numTravelCycles
+    UNLOAD_CYCLES,              // numUnloads
+    NO_CYCLES                   // Nothing counted while waiting
+    };
+
+/**
+* @brief  Row of the truck transition table. Describes a truck in one state and load status, and the state it moves to once
+*         its countdown ends
+*/
+struct TruckTransition{
+    int state;              // Truck state the row applies to
+    int condition;          // Truck load status the row applies to (0 unloaded, 1 loaded)
+    int counting;           // 1 if the truck counts down each time step, 0 if it waits
+    int cycleCount;         // Cycle count incremented each time step (TruckCycleCounts)
+    int nextState;          // State once the countdown ends
+    int nextIsLoaded;       // Load status once the countdown ends
+    int nextDuration;       // Duration of the next state (TruckStateDurations)
+    int awaitingStation;    // 1 if the next state needs an unloading station
+};
+
+/**
+* @brief  Truck cycle MINING -> TRAVEL (loaded) -> UNLOAD -> TRAVEL (unloaded) -> MINING. Loaded trucks in unload state wait for
+*         their station to unload them without counting down. New states (refuelling, maintenance) are new rows of the table
+*/
+struct TruckCyclePolicy{
+    static constexpr size_t NUM_STATES{3};
+    static constexpr size_t NUM_CONDITIONS{2};
+    static constexpr array<TruckTransition, NUM_STATES * NUM_CONDITIONS> TRANSITIONS{{
+        // state, loaded, counting, cycle count, next state, next loaded, next duration, awaiting station
+        {TruckStates::MINING, 0, 1, MINING_CYCLES, TruckStates::TRAVEL, 1, STATE_TRAVEL_DURATION, 0},
+        {TruckStates::MINING, 1, 1, MINING_CYCLES, TruckStates::TRAVEL, 1, STATE_TRAVEL_DURATION, 0},
+        {TruckStates::TRAVEL, 0, 1, TRAVEL_CYCLES, TruckStates::MINING, 0, STATE_MINING_DURATION, 0},
+        {TruckStates::TRAVEL, 1, 1, TRAVEL_CYCLES, TruckStates::UNLOAD, 1, STATE_UNLOAD_DURATION, 1},
+        {TruckStates::UNLOAD, 0, 1, UNLOAD_CYCLES, TruckStates::TRAVEL, 0, STATE_TRAVEL_DURATION, 0},
+        {TruckStates::UNLOAD, 1, 0, NO_CYCLES, TruckStates::TRAVEL, 1, STATE_TRAVEL_DURATION, 0},
+    }};
+};
+
+/**
+* @brief  State machine of the mining trucks
+*/
+using TruckStateMachine = StateMachine<TruckCyclePolicy>;
+
 /**
 * @brief  Constructs new 'Truck' object
 */
 struct Truck{
     const int id;                       // Truck ID
-    const float miningCycleDuration;    // Truck Mining time (min)
+    const int miningCycleDuration;      // Truck Mining time (ticks)
     int state;                          // Current truck state
-    float timeUntilNextState;           // Time until next state (min)
+    int timeUntilNextState;             // Time until next state (ticks)
     bool isLoaded;                      // Truck load status
     bool isAssignedStation;             // Truck assignment status
-    float numTravelCycles;              // Number of travel cycles completed by truck
-    float numMiningCycles;              // Number of mining cycles completed by truck
+    int numTravelCycles;                // Number of travel cycles completed by truck
+    int numMiningCycles;                // Number of mining cycles completed by truck
     int numUnloads;                     // Number of truck unloads
 
     // Parameterized constructor
-    Truck(const int id, const float mining_time) : id(id), miningCycleDuration(mining_time), state(TruckStates::MINING),
+    Truck(const int id, const int mining_time) : id(id), miningCycleDuration(mining_time), state(TruckStates::MINING),
                                         timeUntilNextState(mining_time), isLoaded(false), isAssignedStation(false), numTravelCycles(0), 
                                         numMiningCycles(0), numUnloads(0) {}
 };
@@ -0,0 +1,119 @@
+#ifndef MINING_TRUCK_FLEET_H
+#define MINING_TRUCK_FLEET_H
+
+#include <MiningTruck.h>
+#include <vector>
+#include <array>
+#include <cstdint>
+
+using namespace std;
+
+/**
+* @brief  Reference to the fields of one truck stored in a 'MiningTruckFleet'. Has the same field names as 'Truck'
+*         so the truck and station processors can act on either layout
+*/
+struct TruckReference{
+    const int id;                       // Truck ID
+    const int& miningCycleDuration;     // Truck Mining time (ticks)
+    int& state;                         // Current truck state
+    int& timeUntilNextState;            // Time until next state (ticks)
+    uint8_t& isLoaded;                  // Truck load status
+    uint8_t& isAssignedStation;         // Truck assignment status
+    int& numTravelCycles;               // Number of travel cycles completed by truck
+    int& numMiningCycles;               // Number of mining cycles completed by truck
+    int& numUnloads;                    // Number of truck unloads
+};
+
+/**
+* @brief  Constructs new 'MiningTruckFleet' object. Stores every truck field in its own contiguous array (struct-of-arrays)
+*         so per-step updates stream through memory and vectorize
+*/
+struct MiningTruckFleet{
+    vector<int> miningCycleDuration;    // Truck Mining times (ticks)
+    vector<int> state;                  // Current truck states
+    vector<int> timeUntilNextState;     // Times until next state (ticks)
+    vector<uint8_t> isLoaded;           // Truck load statuses
+    vector<uint8_t> isAssignedStation;  // Truck assignment statuses
+    vector<int> numTravelCycles;        // Number of travel cycles completed by each truck
+    vector<int> numMiningCycles;        // Number of mining cycles completed by each truck
+    vector<int> numUnloads;             // Number of unloads of each truck
+    vector<uint8_t> requiresStateChange; // Set by the countdown kernel for trucks whose state is complete
+
+    // Default constructor
+    MiningTruckFleet() {}
+
+    // Parameterized constructor, copies a list of trucks into the fleet
+    MiningTruckFleet(const vector<Truck>& miningTrucksList) : miningCycleDuration(miningTrucksList.size()), state(miningTrucksList.size()),
+                        timeUntilNextState(miningTrucksList.size()), isLoaded(miningTrucksList.size()), isAssignedStation(miningTrucksList.size()),
+                        numTravelCycles(miningTrucksList.size()), numMiningCycles(miningTrucksList.size()), numUnloads(miningTrucksList.size()),
+                        requiresStateChange(miningTrucksList.size()) {
+        for(size_t i = 0; i < miningTrucksList.size(); i++){
+            const Truck& truck{miningTrucksList[i]};
+            miningCycleDuration[i] = truck.miningCycleDuration;
+            state[i] = truck.state;
+            timeUntilNextState[i] = truck.timeUntilNextState;
+            isLoaded[i] = truck.isLoaded;
+            isAssignedStation[i] = truck.isAssignedStation;
+            numTravelCycles[i] = truck.numTravelCycles;
+            numMiningCycles[i] = truck.numMiningCycles;
+            numUnloads[i] = truck.numUnloads;
+        }
+    }
+
+    // Copies the fleet back into a list of trucks with the same ids
+    void copyTo(vector<Truck>& miningTrucksList) const {
+        for(size_t i = 0; i < miningTrucksList.size(); i++){
+            Truck& truck{miningTrucksList[i]};
+            truck.state = state[i];
+            truck.timeUntilNextState = timeUntilNextState[i];
+            truck.isLoaded = isLoaded[i];
+            truck.isAssignedStation = isAssignedStation[i];
+            truck.numTravelCycles = numTravelCycles[i];
+            truck.numMiningCycles = numMiningCycles[i];
+            truck.numUnloads = numUnloads[i];
+        }
+    }
+
+    // Returns number of trucks in fleet
+    size_t size() const {
+        return state.size();
+    }
+
+    // Returns reference to the fields of the truck with the given id
+    TruckReference operator[](const size_t idx){
+        return TruckReference{static_cast<int>(idx), miningCycleDuration[idx], state[idx], timeUntilNextState[idx], isLoaded[idx],
+                                isAssignedStation[idx], numTravelCycles[idx], numMiningCycles[idx], numUnloads[idx]};
+    }
+};
+
+/**
+* @brief  Returns the state of a truck in a list of trucks
+*/
+inline int getTruckState(const vector<Truck>& miningTrucksList, const size_t idx){
+    return miningTrucksList[idx].state;
+}
+
+/**
+* @brief  Returns the state of a truck in a struct-of-arrays fleet
+*/
+inline int getTruckState(const MiningTruckFleet& miningTruckFleet, const size_t idx){
+    return miningTruckFleet.state[idx];
+}
+
+/**
+* @brief  Returns the number of trucks of a list of trucks or a struct-of-arrays fleet in each of the first NUM_STATES states,
+*         trucks in other states are not counted
+*/
+template<size_t NUM_STATES, typename TruckList>
+array<size_t, NUM_STATES> countTruckStates(const TruckList& miningTrucksList){
+    array<size_t, NUM_STATES> stateCounts{};
+    for(size_t i = 0; i < miningTrucksList.size(); i++){
+        const int state{getTruckState(miningTrucksList, i)};
+        if(state >= 0 && static_cast<size_t>(state) < NUM_STATES){
+            stateCounts[state]++;
+        }
+    }
+    return stateCounts;
+}
+
+#endif // MINING_TRUCK_FLEET_H
\ No newline at end of file
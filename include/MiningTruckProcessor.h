@@ -2,10 +2,21 @@
 #define MINING_TRUCK_PROCESSOR_H
 
 #include <MiningTruck.h>
+#include <MiningTruckFleet.h>
+#include <RandomStream.h>
+#include <ThreadPool.h>
+#include <EventTrace.h>
+#include <RuntimeMetrics.h>
+#include <SimulationTime.h>
+#include <FleetImage.h>
 #include <random>
+#include <limits>
+#include <cstring>
 #include <iostream>
+#include "spdlog/spdlog.h"
 
 using namespace std;
+using namespace spdlog;
 
 /**
 * @class MiningTrucksProcessor 
@@ -16,102 +27,287 @@ class MiningTrucksProcessor{
     // ****IF MORE TIME NOTE 2: Would add more error checking
     public:
         /**
-        * @brief  Constructs new 'MiningTrucksProcessor' object
+        * @brief  Constructs new 'MiningTrucksProcessor' object. If fleetImageFileName is set, mining durations are loaded from that fleet
+        *         image, which is first written if missing or generated with other fleet parameters
         */
         MiningTrucksProcessor(const size_t numMiningTrucks, const float min_mining_duration_hrs, const float max_mining_duration_hrs, 
-                                const float travel_duration_hrs, const float unload_duration_min): m_NumMiningTrucks(numMiningTrucks), m_TravelDuration(travel_duration_hrs * 60), 
-                                m_UnloadDuration(unload_duration_min), m_MiningTrucksList(initMiningTrucks(numMiningTrucks, min_mining_duration_hrs, max_mining_duration_hrs)), 
-                                m_LoadedTrucksIdx(){};
+                                const float travel_duration_hrs, const float unload_duration_min, const uint64_t seed = random_device{}(), 
+                                const uint32_t replication = 0, const string& fleetImageFileName = ""): 
+                                m_MiningTrucksList(initMiningTrucks(initMiningTimes(numMiningTrucks, min_mining_duration_hrs, max_mining_duration_hrs, seed, replication, fleetImageFileName))), 
+                                m_NumMiningTrucks(numMiningTrucks), m_TravelDuration(hoursToTicks(travel_duration_hrs)), m_UnloadDuration(minutesToTicks(unload_duration_min)), 
+                                m_EventTrace(nullptr), m_LoadedTrucksIdx(), m_TruckCounters(), m_UpdateThreadPool(), m_UpdateBuffers(){};
 
         /**
         * @brief  Construct all mining trucks in simulation
         * @param numMiningTrucks Number of mining trucks in the simulation
         * @param minMiningDuration_hrs Minimum length of a truck's mining cycle in hours
         * @param maxMiningDuration_hrs Maximum length of a truck's mining cycle in hours
+        * @param seed Seed of the random number generator used to generate mining durations
+        * @param replication Index of the replication, gives each replication of a seed its own random stream
+        * @param numThreads Number of threads used to generate mining durations of large fleets. Results do not depend on it
         */
-        static vector<Truck> initMiningTrucks(const size_t numMiningTrucks, float minMiningDuration_hrs, const float maxMiningDuration_hrs){
+        static vector<Truck> initMiningTrucks(const size_t numMiningTrucks, float minMiningDuration_hrs, const float maxMiningDuration_hrs, 
+                                                const uint64_t seed = random_device{}(), const uint32_t replication = 0, 
+                                                const size_t numThreads = thread::hardware_concurrency()){
+            return initMiningTrucks(generateMiningTimes(numMiningTrucks, minMiningDuration_hrs, maxMiningDuration_hrs, seed, replication, numThreads));
+        };
+
+        /**
+        * @brief  Construct mining trucks with the given mining durations, truck i mining for miningDurations[i] ticks
+        */
+        static vector<Truck> initMiningTrucks(const vector<int>& miningDurations){
+            // Size storage once, trucks are built in place
             vector<Truck> miningTrucks{};
-            // Create Truck objects with randomly generated mining durations between min and max
-            for(int i = 0; i < numMiningTrucks; i++){
-                miningTrucks.push_back(Truck(i, generateMiningTime(minMiningDuration_hrs, maxMiningDuration_hrs)));
+            miningTrucks.reserve(miningDurations.size());
+            for(size_t i = 0; i < miningDurations.size(); i++){
+                miningTrucks.emplace_back(static_cast<int>(i), miningDurations[i]);
             }
             return miningTrucks;
         };
 
+        /**
+        * @brief  Generates the mining durations of all trucks (ticks). Durations are drawn in batches of MINING_TIME_BATCH_SIZE trucks
+        *         on each thread, and each truck's duration depends only on its id, so results do not depend on the number of threads
+        * @param numMiningTrucks Number of mining trucks in the simulation
+        * @param minMiningDuration_hrs Minimum length of a truck's mining cycle in hours
+        * @param maxMiningDuration_hrs Maximum length of a truck's mining cycle in hours
+        * @param seed Seed of the random number generator used to generate mining durations
+        * @param replication Index of the replication, gives each replication of a seed its own random stream
+        * @param numThreads Number of threads used to generate mining durations of large fleets
+        */
+        static vector<int> generateMiningTimes(const size_t numMiningTrucks, const float minMiningDuration_hrs, const float maxMiningDuration_hrs, 
+                                                const uint64_t seed, const uint32_t replication, const size_t numThreads = thread::hardware_concurrency()){
+            vector<int> miningDurations(numMiningTrucks);
+            const size_t numInitThreads{numMiningTrucks >= PARALLEL_INIT_MIN_TRUCKS ? numThreads : 1};
+            parallelFor(numMiningTrucks, numInitThreads, [&](const size_t begin, const size_t end){
+                float miningDurations_hrs[MINING_TIME_BATCH_SIZE];
+                for(size_t batchBegin = begin; batchBegin < end; batchBegin += MINING_TIME_BATCH_SIZE){
+                    const size_t batchSize{min(MINING_TIME_BATCH_SIZE, end - batchBegin)};
+                    RandomStream::uniformFloats(seed, replication, RandomStreams::MINING_DURATION, static_cast<uint32_t>(batchBegin), 0, 
+                                                minMiningDuration_hrs, maxMiningDuration_hrs, batchSize, miningDurations_hrs);
+                    for(size_t i = 0; i < batchSize; i++){
+                        miningDurations[batchBegin + i] = static_cast<int>(hoursToTicks(miningDurations_hrs[i]));
+                    }
+                }
+            });
+            return miningDurations;
+        };
+
+        /**
+        * @brief  Returns the mining durations of all trucks (ticks), loaded from a fleet image if fleetImageFileName is set. A missing fleet image,
+        *         or one generated with other fleet parameters, is replaced by the generated durations
+        * @param fleetImageFileName Name of the fleet image file, empty to always generate
+        */
+        static vector<int> initMiningTimes(const size_t numMiningTrucks, const float minMiningDuration_hrs, const float maxMiningDuration_hrs, 
+                                            const uint64_t seed, const uint32_t replication, const string& fleetImageFileName){
+            if(fleetImageFileName.empty()){
+                return generateMiningTimes(numMiningTrucks, minMiningDuration_hrs, maxMiningDuration_hrs, seed, replication);
+            }
+
+            FleetImageHeader header{};
+            header.replication = replication;
+            header.seed = seed;
+            header.numMiningTrucks = numMiningTrucks;
+            header.minMiningDuration_hrs = minMiningDuration_hrs;
+            header.maxMiningDuration_hrs = maxMiningDuration_hrs;
+            vector<int> miningDurations{};
+            if(FleetImage::read(fleetImageFileName, header, miningDurations)){
+                return miningDurations;
+            }
+            miningDurations = generateMiningTimes(numMiningTrucks, minMiningDuration_hrs, maxMiningDuration_hrs, seed, replication);
+            if(!FleetImage::write(fleetImageFileName, header, miningDurations)){
+                error("initMiningTimes Error: Fleet image {} could not be written.", fleetImageFileName);
+            }
+            return miningDurations;
+        };
+
         /**
         * @brief  Updates the states of the mining trucks
-        * @param timestep_minutes Length of one timestep in minutes
+        * @param timestep_ticks Length of one timestep in ticks
         */
-        void updateMiningTrucks(const float timestep_minutes){
-            // Vector to hold newly loaded truck indices
-            vector<int> loadedTrucksIds{};
+        void updateMiningTrucks(const SimulationTicks timestep_ticks){
+            // Split large fleets across the update threads
+            if(useParallelUpdate()){
+                updateInParallel([this, timestep_ticks](const size_t begin, const size_t end, TruckUpdateBuffer& buffer){
+                    for(size_t i = begin; i < end; i++){
+                        Truck& truck{m_MiningTrucksList[i]};
+                        if(runTruckTimestep(truck, timestep_ticks)){
+                            bufferTruckStateChange(truck, buffer);
+                        }
+                    }
+                });
+                return;
+            }
+
+            // Reuse vector of trucks awaiting unloading station assignment, so steady-state time steps do not allocate
+            m_LoadedTrucksIdx.clear();
 
             // Iterate through all trucks to update state
             for(Truck& truck : m_MiningTrucksList){
-                bool stateChange{false};
-                // Change state of variable according to current state
-                switch(truck.state){
-                    case TruckStates::MINING:
-                        stateChange = runTruckCycle(truck, timestep_minutes);
-                        truck.numMiningCycles++;
-                        if(stateChange){
-                            // After Mining, 
-                            // change state to travel
-                            truck.state = TruckStates::TRAVEL;
-            
-                            // Mark Truck as loaded
-                            truck.isLoaded = true;
-
-                            // Increment time until next state
-                            truck.timeUntilNextState += m_TravelDuration;  // IDEALLY WOULD MAKE TIMES FOR EACH STATE CONFIGURABLE
-                        }
-                        break;
-                    case TruckStates::TRAVEL:
-                        stateChange = runTruckCycle(truck, timestep_minutes);
-                        truck.numTravelCycles++; // increment travel cycle
-                        if(stateChange){
-                            // After Travelling and if unloaded, start mining
-                            if(truck.isLoaded){
-                                // After Travelling and if loaded, change to unload
-                                // Change State to Unload
-                                truck.state = TruckStates::UNLOAD;
-
-                                // Add truck id to list of trucks to be assigned an unloading station
-                                loadedTrucksIds.push_back(truck.id);
-
-                                // Increment time until next state
-                                truck.timeUntilNextState += m_UnloadDuration;
-                            }
-                            else{
-                                // Change state to mining
-                                truck.state = TruckStates::MINING;
-
-                                // Increment time until next state
-                                truck.timeUntilNextState += truck.miningCycleDuration;
-                            }
-                        }    
-                        break;
-                    case TruckStates::UNLOAD:
-                        // if unloaded, begin travel back to mining station
-                        if(!truck.isLoaded){
-                            stateChange = runTruckCycle(truck, timestep_minutes);
-                            truck.numUnloads++;
-
-                            if (stateChange){
-                                // change state to travel
-                            truck.state = TruckStates::TRAVEL;
-
-                            // Increment time until next state
-                            truck.timeUntilNextState += m_TravelDuration;
-                            }    
-                        }
-                        // If loaded, stay in unload state
-                        break;
+                // Add truck id to list of trucks to be assigned an unloading station
+                if(runTruckTimestep(truck, timestep_ticks) && changeTruckState(truck)){
+                    m_LoadedTrucksIdx.push_back(truck.id);
+                }
+            }
+        };
+
+        /**
+        * @brief  Updates the states of the mining trucks stored in the struct-of-arrays fleet. Equivalent to updateMiningTrucks run
+        *         numTimesteps times, as long as no truck's state ends before the last of them. With TrackStateChanges the update also
+        *         tracks the time until the next truck state change (see getTimestepsUntilFleetStateChange)
+        * @param timestep_ticks Length of one timestep in ticks
+        * @param numTimesteps Number of time steps to run at once
+        */
+        template<bool TrackStateChanges = false>
+        void updateMiningTruckFleet(const SimulationTicks timestep_ticks, const long numTimesteps = 1){
+            // Split large fleets across the update threads
+            if(useParallelUpdate()){
+                updateInParallel([this, timestep_ticks, numTimesteps](const size_t begin, const size_t end, TruckUpdateBuffer& buffer){
+                    buffer.timeUntilStateChange = updateTruckFleetRange<TrackStateChanges>(begin, end, timestep_ticks, numTimesteps, [this, &buffer](const size_t i){
+                        bufferTruckStateChange(m_MiningTruckFleet[i], buffer);
+                    });
+                });
+                m_FleetTimeUntilStateChange = NO_STATE_CHANGE;
+                for(const TruckUpdateBuffer& buffer : m_UpdateBuffers){
+                    m_FleetTimeUntilStateChange = min(m_FleetTimeUntilStateChange, buffer.timeUntilStateChange);
+                }
+                return;
+            }
+
+            // Reuse vector of trucks awaiting unloading station assignment
+            m_LoadedTrucksIdx.clear();
+
+            m_FleetTimeUntilStateChange = updateTruckFleetRange<TrackStateChanges>(0, m_MiningTruckFleet.size(), timestep_ticks, numTimesteps, [this](const size_t i){
+                if(changeTruckState(m_MiningTruckFleet[i])){
+                    m_LoadedTrucksIdx.push_back(i);
                 }
+            });
+        };
+
+        /**
+        * @brief  Returns the number of time steps from the last updateMiningTruckFleet<true> to the first time step in which a truck of the
+        *         fleet reaches the end of its state, tracked by the fleet updates without rescanning the fleet. Returns maxTimesteps if
+        *         no truck does within maxTimesteps time steps. Trucks unloaded at a station afterwards are not included
+        * @param timestep_ticks Length of one timestep in ticks
+        * @param maxTimesteps Largest number of time steps to return
+        */
+        long getTimestepsUntilFleetStateChange(const SimulationTicks timestep_ticks, const long maxTimesteps) const {
+            if(m_FleetTimeUntilStateChange <= 0){
+                return min(1L, maxTimesteps);
+            }
+            return min((m_FleetTimeUntilStateChange + timestep_ticks - 1) / timestep_ticks, static_cast<SimulationTicks>(maxTimesteps));
+        };
+
+        /**
+        * @brief  Sets the number of threads trucks are updated on. Fleets of at least PARALLEL_UPDATE_MIN_TRUCKS trucks are split into
+        *         one contiguous range of trucks per thread, and the results are identical to updating on one thread
+        * @param numThreads Number of threads, 1 to update on the calling thread only
+        */
+        void setNumUpdateThreads(const size_t numThreads){
+            if(numThreads == getNumUpdateThreads()){
+                return;
             }
+            m_UpdateThreadPool = numThreads > 1 ? make_shared<ThreadPool>(numThreads - 1) : nullptr;
+            m_UpdateBuffers.assign(max<size_t>(numThreads, 1), TruckUpdateBuffer{});
+        };
+
+        /**
+        * @brief  Returns the number of threads trucks are updated on
+        */
+        const size_t getNumUpdateThreads(){
+            return m_UpdateThreadPool ? m_UpdateThreadPool->getNumThreads() + 1 : 1;
+        };
+
+        /**
+        * @brief  Copies the list of mining trucks into the struct-of-arrays fleet
+        */
+        void loadTruckFleet(){
+            m_MiningTruckFleet = MiningTruckFleet(m_MiningTrucksList);
+        };
+
+        /**
+        * @brief  Copies the struct-of-arrays fleet back into the list of mining trucks
+        */
+        void storeTruckFleet(){
+            m_MiningTruckFleet.copyTo(m_MiningTrucksList);
+        };
+
+        /**
+        * @brief  Changes truck to its next state once its current state is complete. Returns true if truck is awaiting an unloading station
+        * @param truck Truck (or reference to a fleet truck) that has completed its current state
+        */
+        template<typename TruckT>
+        bool changeTruckState(TruckT&& truck){
+            const int previousState{truck.state};
+            const bool awaitingStation{advanceTruckState(truck)};
+            recordTruckStateChange(truck.id, previousState, truck.state);
+            return awaitingStation;
+        };
+
+        /**
+        * @brief  Moves truck to its next state without recording the state change. Returns true if truck is awaiting an unloading station
+        */
+        template<typename TruckT>
+        bool advanceTruckState(TruckT&& truck){
+            // Look up the transition of the truck's state and load status, and start the next state's countdown
+            const TruckTransition& transition{TruckStateMachine::getTransition(truck.state, truck.isLoaded)};
+            const array<int, NUM_STATE_DURATIONS> durations{truck.miningCycleDuration, m_TravelDuration, m_UnloadDuration};
+            truck.state = transition.nextState;
+            truck.isLoaded = transition.nextIsLoaded;
+            truck.timeUntilNextState += durations[transition.nextDuration];
+            return transition.awaitingStation;
+        };
+
+        /**
+        * @brief  Returns true if truck counts down in its current state, false if it waits for its station to unload it
+        */
+        template<typename TruckT>
+        static bool isTruckCounting(const TruckT& truck){
+            return TruckStateMachine::getTransition(truck.state, truck.isLoaded).counting;
+        };
+
+        /**
+        * @brief  Records a truck state change in the event trace and runtime metrics
+        */
+        void recordTruckStateChange(const int truckId, const int previousState, const int state){
+            if(m_EventTrace != nullptr){
+                m_EventTrace->record(TraceEventTypes::TRUCK_STATE_CHANGED, truckId, previousState, state);
+            }
+            m_TruckCounters.numStateChanges++;
+        };
+
+        /**
+        * @brief  Runs consecutive time steps for truck in its current state until it requires a state change or maxCycles is reached.
+        *         Returns true if truck requires state change, otherwise false
+        * @param truck Truck to run time steps for (must not be awaiting unload at a station)
+        * @param timestep_ticks Length of one timestep in ticks
+        * @param maxCycles Maximum number of time steps to run
+        * @param numCycles Set to the number of time steps run
+        */
+        bool runTruckCycles(Truck& truck, const SimulationTicks timestep_ticks, const long maxCycles, long& numCycles){
+            // Integer countdown, so running the time steps at once is identical to running them one at a time as updateMiningTrucks does
+            const long numCyclesUntilStateChange{getNumCyclesUntilStateChange(truck, timestep_ticks, maxCycles)};
+            const bool stateChange{numCyclesUntilStateChange > 0};
+            numCycles = stateChange ? numCyclesUntilStateChange : max(maxCycles, 0L);
+            truck.timeUntilNextState -= numCycles * timestep_ticks;
 
-            // Save vector of trucks awaiting unloading station assignment
-            m_LoadedTrucksIdx = loadedTrucksIds;
+            // Increment cycle count of current state
+            addTruckCycles(truck, TruckStateMachine::getTransition(truck.state, truck.isLoaded).cycleCount, numCycles);
+
+            return stateChange;
+        };
+
+        /**
+        * @brief  Returns the number of time steps until truck requires a state change when counting down from its current time until
+        *         next state as runTruckCycle does, without changing the truck. Returns 0 if more than maxCycles
+        * @param truck Truck in a counting state (not awaiting unload at a station)
+        * @param timestep_ticks Length of one timestep in ticks
+        * @param maxCycles Maximum number of time steps to count
+        */
+        static long getNumCyclesUntilStateChange(const Truck& truck, const SimulationTicks timestep_ticks, const long maxCycles){
+            // The state ends in the first time step that counts down to 0 or below, at least one time step from now
+            const long numCycles{truck.timeUntilNextState <= 0 ? 1 : static_cast<long>((truck.timeUntilNextState + timestep_ticks - 1) / timestep_ticks)};
+            return numCycles <= maxCycles ? numCycles : 0;
         };
 
         /**
@@ -119,7 +315,7 @@ class MiningTrucksProcessor{
         */
         void printTrucks() {
             for (const auto& truck : m_MiningTrucksList) {
-                cout << "Truck ID: " << truck.id << ", Mining Time: " << truck.miningCycleDuration << " min \n" << endl;
+                cout << "Truck ID: " << truck.id << ", Mining Time: " << ticksToMinutes(truck.miningCycleDuration) << " min \n" << endl;
             }
         };
 
@@ -131,16 +327,30 @@ class MiningTrucksProcessor{
         };
 
          /**
-        * @brief  Returns the travel duration of the mining trucks in minutes
+        * @brief  Returns the travel duration of the mining trucks in ticks
         */
-        const float getTravelDuration(){
+        const int getTravelDuration(){
             return m_TravelDuration;
         };
 
+        /**
+        * @brief  Sets the event trace truck state changes are recorded to, or nullptr to stop recording
+        */
+        void setEventTrace(EventTraceWriter* eventTrace){
+            m_EventTrace = eventTrace;
+        };
+
+        /**
+        * @brief  Returns the truck counters, counted in every build for the live metrics
+        */
+        const TruckCounters getTruckCounters(){
+            return m_TruckCounters;
+        };
+
         /**
         * @brief  Returns vector with all newly loaded trucks
         */
-        const vector<int> getLoadedTrucks(){
+        const vector<int>& getLoadedTrucks(){
             return m_LoadedTrucksIdx;
         };
 
@@ -149,6 +359,11 @@ class MiningTrucksProcessor{
          */
         vector<Truck> m_MiningTrucksList;
 
+        /**
+         * @brief Struct-of-arrays copy of all mining trucks, used by updateMiningTruckFleet
+         */
+        MiningTruckFleet m_MiningTruckFleet;
+
     private:
         /**
         * @brief  Number of mining trucks in simulation
@@ -156,14 +371,29 @@ class MiningTrucksProcessor{
         const size_t m_NumMiningTrucks;
 
         /**
-        * @brief  Duration of travel process (minutes)
+        * @brief  Minimum fleet size for which mining durations are generated on multiple threads
+        */
+        static constexpr size_t PARALLEL_INIT_MIN_TRUCKS{65536};
+
+        /**
+        * @brief  Number of mining durations drawn at once
+        */
+        static constexpr size_t MINING_TIME_BATCH_SIZE{1024};
+
+        /**
+        * @brief  Duration of travel process (ticks)
+        */
+        const int m_TravelDuration;
+
+        /**
+        * @brief  Duration of unload process (ticks)
         */
-        const float m_TravelDuration;
+        const int m_UnloadDuration;
 
         /**
-        * @brief  Duration of unload process (minutes)
+        * @brief  Event trace truck state changes are recorded to, nullptr if not tracing
         */
-        const float m_UnloadDuration;
+        EventTraceWriter* m_EventTrace;
 
         /**
         * @brief  Indices of trucks awaiting assignment to unloading station
@@ -171,24 +401,236 @@ class MiningTrucksProcessor{
         vector<int> m_LoadedTrucksIdx;
 
         /**
-        * @brief  Generates random mining time between min and max hours --> IF MORE TIME, GENERATE RANDOM FLOAT
+        * @brief  Truck counters
+        */
+        TruckCounters m_TruckCounters;
+
+        /**
+        * @brief  Minimum fleet size for which trucks are updated on multiple threads
+        */
+        static constexpr size_t PARALLEL_UPDATE_MIN_TRUCKS{65536};
+
+        /**
+        * @brief  State change of a truck made on an update thread
+        */
+        struct TruckStateChange{
+            int truckId;
+            int previousState;
+            int state;
+        };
+
+        /**
+        * @brief  Results of updating one range of trucks on an update thread, merged in truck id order once every range is updated
+        */
+        struct TruckUpdateBuffer{
+            vector<int> loadedTrucksIds;
+            vector<TruckStateChange> stateChanges;
+            int timeUntilStateChange{NO_STATE_CHANGE};
+        };
+
+        /**
+        * @brief  Worker threads of the parallel update, shared by copies of the processor. nullptr when updating on one thread
+        */
+        shared_ptr<ThreadPool> m_UpdateThreadPool;
+
+        /**
+        * @brief  Results of each update thread, reused every time step
+        */
+        vector<TruckUpdateBuffer> m_UpdateBuffers;
+
+        /**
+        * @brief  Returns true if the fleet is large enough and update threads are set
+        */
+        bool useParallelUpdate(){
+            return m_UpdateThreadPool != nullptr && m_NumMiningTrucks >= PARALLEL_UPDATE_MIN_TRUCKS;
+        };
+
+        /**
+        * @brief  Runs updateRange(begin, end, buffer) over one contiguous range of trucks per update thread, then records the buffered
+        *         state changes and collects the newly loaded trucks range by range, so both are in truck id order as in a serial update
+        */
+        template<typename UpdateRange>
+        void updateInParallel(UpdateRange&& updateRange){
+            const size_t numRanges{m_UpdateBuffers.size()};
+            const size_t rangeSize{(m_NumMiningTrucks + numRanges - 1) / numRanges};
+            m_UpdateThreadPool->runTasks(numRanges, [&](const size_t rangeIdx){
+                TruckUpdateBuffer& buffer{m_UpdateBuffers[rangeIdx]};
+                buffer.loadedTrucksIds.clear();
+                buffer.stateChanges.clear();
+                updateRange(min(rangeIdx * rangeSize, m_NumMiningTrucks), min((rangeIdx + 1) * rangeSize, m_NumMiningTrucks), buffer);
+            });
+
+            // Merge in range order, event trace and counters are only touched by this thread
+            m_LoadedTrucksIdx.clear();
+            for(const TruckUpdateBuffer& buffer : m_UpdateBuffers){
+                for(const TruckStateChange& stateChange : buffer.stateChanges){
+                    recordTruckStateChange(stateChange.truckId, stateChange.previousState, stateChange.state);
+                }
+                m_LoadedTrucksIdx.insert(m_LoadedTrucksIdx.end(), buffer.loadedTrucksIds.begin(), buffer.loadedTrucksIds.end());
+            }
+        };
+
+        /**
+        * @brief  Moves a truck to its next state on an update thread, buffering the state change and the truck id if it is newly loaded
+        */
+        template<typename TruckT>
+        void bufferTruckStateChange(TruckT&& truck, TruckUpdateBuffer& buffer){
+            const int previousState{truck.state};
+            if(advanceTruckState(truck)){
+                buffer.loadedTrucksIds.push_back(truck.id);
+            }
+            buffer.stateChanges.push_back(TruckStateChange{truck.id, previousState, truck.state});
+        };
+
+        /**
+        * @brief  Time until the next state change when no truck is counting down (ticks)
+        */
+        static constexpr int NO_STATE_CHANGE{numeric_limits<int>::max()};
+
+        /**
+        * @brief  Shortest time until the end of its state of the trucks counting down after the last updateMiningTruckFleet<true> (ticks)
+        */
+        int m_FleetTimeUntilStateChange{NO_STATE_CHANGE};
+
+        /**
+        * @brief  Runs numTimesteps time steps for trucks [begin, end) of the struct-of-arrays fleet and calls changeState(i) for every
+        *         truck whose countdown crossed zero, in truck id order. With TrackStateChanges returns the shortest time until the end of
+        *         its state of the trucks counting down afterwards, otherwise (or if there are none) NO_STATE_CHANGE
+        */
+        template<bool TrackStateChanges, typename ChangeState>
+        int updateTruckFleetRange(const size_t begin, const size_t end, const SimulationTicks timestep_ticks, const long numTimesteps, 
+                                    ChangeState&& changeState){
+            uint8_t* requiresStateChange{m_MiningTruckFleet.requiresStateChange.data()};
+
+            // Count down all trucks in range at once
+            int timeUntilStateChange{countdownTruckFleet<TrackStateChanges>(end - begin, static_cast<int>(timestep_ticks), static_cast<int>(numTimesteps), 
+                                m_MiningTruckFleet.state.data() + begin, m_MiningTruckFleet.isLoaded.data() + begin, 
+                                m_MiningTruckFleet.timeUntilNextState.data() + begin, m_MiningTruckFleet.numMiningCycles.data() + begin, 
+                                m_MiningTruckFleet.numTravelCycles.data() + begin, m_MiningTruckFleet.numUnloads.data() + begin, requiresStateChange + begin)};
+
+            // Change states of the trucks whose countdown crossed zero, skipping 8 trucks at a time when none did
+            size_t i{begin};
+            while(i < end){
+                if(i + 8 <= end){
+                    uint64_t flags{};
+                    memcpy(&flags, requiresStateChange + i, sizeof(flags));
+                    if(flags == 0){
+                        i += 8;
+                        continue;
+                    }
+                }
+                if(requiresStateChange[i]){
+                    changeState(i);
+                    if(TrackStateChanges && isTruckCounting(m_MiningTruckFleet[i])){
+                        timeUntilStateChange = min(timeUntilStateChange, m_MiningTruckFleet.timeUntilNextState[i]);
+                    }
+                }
+                i++;
+            }
+            return timeUntilStateChange;
+        };
+
+        /**
+        * @brief  Runs one time step for truck according to its current state. Returns true if truck requires state change
         */
-        static const float generateMiningTime(const float& minMiningDuration_hrs, const float& maxMiningDuration_hrs){
-            // Initialize random number generator to assign mining times
-            random_device rd;
-            mt19937 gen(rd());
-            uniform_real_distribution<float> distrib(minMiningDuration_hrs, maxMiningDuration_hrs); // Generates random int between min and max
-            return distrib(gen) * 60; // convert hours to minutes
+        bool runTruckTimestep(Truck& truck, const SimulationTicks timestep_ticks){
+            // Dispatch on the truck's state, the rows of each state are constants so each case inlines to its countdown
+            return TruckStateMachine::visitState(truck.state, [this, &truck, timestep_ticks](auto state){
+                constexpr TruckTransition unloadedTransition{TruckStateMachine::getTransition(decltype(state)::value, 0)};
+                constexpr TruckTransition loadedTransition{TruckStateMachine::getTransition(decltype(state)::value, 1)};
+                if constexpr(unloadedTransition.counting == loadedTransition.counting && unloadedTransition.cycleCount == loadedTransition.cycleCount){
+                    return runTruckTransitionTimestep<unloadedTransition.counting, unloadedTransition.cycleCount>(truck, timestep_ticks);
+                }
+                else{
+                    // Loaded trucks in unload state stay in it without counting down
+                    return truck.isLoaded ? runTruckTransitionTimestep<loadedTransition.counting, loadedTransition.cycleCount>(truck, timestep_ticks)
+                                          : runTruckTransitionTimestep<unloadedTransition.counting, unloadedTransition.cycleCount>(truck, timestep_ticks);
+                }
+            });
+        };
+
+        /**
+        * @brief  Runs one time step for truck in a transition table row known at compile time. Returns true if truck requires state change
+        */
+        template<int Counting, int CycleCount>
+        bool runTruckTransitionTimestep(Truck& truck, const SimulationTicks timestep_ticks){
+            if constexpr(Counting == 0){
+                return false;
+            }
+            else{
+                addTruckCycles(truck, CycleCount, 1);
+                return runTruckCycle(truck, timestep_ticks);
+            }
+        };
+
+        /**
+        * @brief  Adds numCycles to the cycle count of a truck (TruckCycleCounts)
+        */
+        template<typename TruckT>
+        static void addTruckCycles(TruckT&& truck, const int cycleCount, const long numCycles){
+            switch(cycleCount){
+                case TruckCycleCounts::MINING_CYCLES:
+                    truck.numMiningCycles += numCycles;
+                    break;
+                case TruckCycleCounts::TRAVEL_CYCLES:
+                    truck.numTravelCycles += numCycles;
+                    break;
+                case TruckCycleCounts::UNLOAD_CYCLES:
+                    truck.numUnloads += numCycles;
+                    break;
+            }
+        };
+
+        /**
+        * @brief  Runs numTimesteps time steps for every truck in a struct-of-arrays fleet and flags the trucks that require a state change.
+        *         With TrackStateChanges returns the shortest time until the end of its state of the counting trucks that do not, otherwise
+        *         (or if there are none) NO_STATE_CHANGE. Branch-free (bitwise operators, no short-circuits, the transition table unrolled
+        *         into compares), integer-only and non-aliasing so the compiler vectorizes it
+        */
+        template<bool TrackStateChanges>
+        static int countdownTruckFleet(const size_t numTrucks, const int timestep_ticks, const int numTimesteps, const int* __restrict state, 
+                                        const uint8_t* __restrict isLoaded, int* __restrict timeUntilNextState, int* __restrict numMiningCycles, 
+                                        int* __restrict numTravelCycles, int* __restrict numUnloads, uint8_t* __restrict requiresStateChange){
+            const int countdown_ticks{timestep_ticks * numTimesteps};
+            int timeUntilStateChange{NO_STATE_CHANGE};
+            for(size_t i = 0; i < numTrucks; i++){
+                // Select the truck's row of the transition table by comparing against every row, the row loop unrolls at compile time
+                const int transitionIdx{state[i] * static_cast<int>(TruckStateMachine::NUM_CONDITIONS) + isLoaded[i]};
+                int mining{0}, travel{0}, unloading{0}, counting{0};
+                for(size_t row = 0; row < TruckStateMachine::NUM_TRANSITIONS; row++){
+                    const int match{-static_cast<int>(transitionIdx == static_cast<int>(row))};
+                    const TruckTransition& transition{TruckCyclePolicy::TRANSITIONS[row]};
+                    mining |= match & (transition.cycleCount == TruckCycleCounts::MINING_CYCLES);
+                    travel |= match & (transition.cycleCount == TruckCycleCounts::TRAVEL_CYCLES);
+                    unloading |= match & (transition.cycleCount == TruckCycleCounts::UNLOAD_CYCLES);
+                    counting |= match & transition.counting;
+                }
+
+                // Loaded trucks in unload state wait for their station without counting down
+                const int remaining{timeUntilNextState[i] - (-counting & countdown_ticks)};
+                timeUntilNextState[i] = remaining;
+                numMiningCycles[i] += -mining & numTimesteps;
+                numTravelCycles[i] += -travel & numTimesteps;
+                numUnloads[i] += -unloading & numTimesteps;
+                requiresStateChange[i] = static_cast<uint8_t>(counting & (remaining <= 0));
+
+                // Shortest countdown of the trucks still counting, selected with masks so the loop stays vectorized
+                if constexpr(TrackStateChanges){
+                    const int pending{-(counting & (remaining > 0))};
+                    timeUntilStateChange = min(timeUntilStateChange, (remaining & pending) | (NO_STATE_CHANGE & ~pending));
+                }
+            }
+            return timeUntilStateChange;
         };
 
         /**
         * @brief  Runs one time step for truck. Returns true if truck requires state change, otherwise false
         */
-        bool runTruckCycle(Truck& truck, const float& timestep_minutes){
+        bool runTruckCycle(Truck& truck, const SimulationTicks timestep_ticks){
             bool stateChange{false};
 
             // Decrement time until next step by timestep, if not already 0
-            truck.timeUntilNextState -= timestep_minutes;
+            truck.timeUntilNextState -= timestep_ticks;
 
             // Check if state change necessary
             // If timeUntilNextState <= 0 --> change state
@@ -0,0 +1,87 @@
+#ifndef RANDOM_STREAM_H
+#define RANDOM_STREAM_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+ /**
+  * @brief Defines the independent random streams drawn from by the simulation
+  */
+enum RandomStreams {
+    MINING_DURATION
+    };
+
+/**
+* @class RandomStream
+* @brief Counter-based random number generator (Philox4x32-10). Each value is a pure function of
+*        (seed, replication, stream, entity id, draw index), so draws need no shared state, can be made in
+*        any order on any thread, and are reproducible
+*/
+class RandomStream{
+    public:
+        /**
+        * @brief  Returns 4 random 32-bit words for a counter and key using 10 Philox rounds
+        */
+        static array<uint32_t, 4> philox4x32(array<uint32_t, 4> counter, array<uint32_t, 2> key){
+            for(int round = 0; round < 10; round++){
+                if(round > 0){
+                    key[0] += PHILOX_W0;
+                    key[1] += PHILOX_W1;
+                }
+                const uint64_t product0{static_cast<uint64_t>(PHILOX_M0) * counter[0]};
+                const uint64_t product1{static_cast<uint64_t>(PHILOX_M1) * counter[2]};
+                counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0], static_cast<uint32_t>(product1),
+                            static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1], static_cast<uint32_t>(product0)};
+            }
+            return counter;
+        };
+
+        /**
+        * @brief  Returns a random 32-bit word
+        * @param seed Seed of the simulation
+        * @param replication Index of the replication of the seed
+        * @param stream Random stream being drawn from
+        * @param entityId Id of the truck or station the value is drawn for
+        * @param drawIdx Index of the draw for the entity in the stream
+        */
+        static uint32_t generate(const uint64_t seed, const uint32_t replication, const RandomStreams stream, const uint32_t entityId, const uint32_t drawIdx){
+            const array<uint32_t, 4> counter{drawIdx, entityId, static_cast<uint32_t>(stream), replication};
+            const array<uint32_t, 2> key{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+            return philox4x32(counter, key)[0];
+        };
+
+        /**
+        * @brief  Returns a random float uniformly distributed in [min, max)
+        */
+        static float uniformFloat(const uint64_t seed, const uint32_t replication, const RandomStreams stream, const uint32_t entityId,
+                                    const uint32_t drawIdx, const float min, const float max){
+            // Use the top 24 bits so every value is exactly representable as a float in [0, 1)
+            const float unit{static_cast<float>(generate(seed, replication, stream, entityId, drawIdx) >> 8) * (1.0f / 16777216.0f)};
+            return min + unit * (max - min);
+        };
+
+        /**
+        * @brief  Fills values with random floats uniformly distributed in [min, max), values[i] drawn for entity firstEntityId + i.
+        *         Same values as uniformFloat, generated in a loop the compiler vectorizes across entities
+        */
+        static void uniformFloats(const uint64_t seed, const uint32_t replication, const RandomStreams stream, const uint32_t firstEntityId,
+                                    const uint32_t drawIdx, const float min, const float max, const size_t numValues, float* __restrict values){
+            for(size_t i = 0; i < numValues; i++){
+                values[i] = uniformFloat(seed, replication, stream, firstEntityId + static_cast<uint32_t>(i), drawIdx, min, max);
+            }
+        };
+
+    private:
+        /**
+        * @brief  Philox multipliers and key increments (Salmon et al., 2011)
+        */
+        static constexpr uint32_t PHILOX_M0{0xD2511F53};
+        static constexpr uint32_t PHILOX_M1{0xCD9E8D57};
+        static constexpr uint32_t PHILOX_W0{0x9E3779B9};
+        static constexpr uint32_t PHILOX_W1{0xBB67AE85};
+};
+
+#endif // RANDOM_STREAM_H
\ No newline at end of file
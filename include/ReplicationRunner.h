@@ -0,0 +1,495 @@
+#ifndef REPLICATION_RUNNER_H
+#define REPLICATION_RUNNER_H
+
+#include <Simulation.h>
+#include <ThreadPool.h>
+#include <StreamingStatistics.h>
+#include <array>
+#include <exception>
+#include <map>
+#include <cmath>
+#include "spdlog/spdlog.h"
+
+using namespace std;
+using namespace spdlog;
+
+ /**
+  * @brief Defines the truck performance metrics aggregated across replications
+  */
+enum TruckMetrics {
+    TRUCK_PERCENT_MINING_TIME,
+    TRUCK_PERCENT_TRAVEL_TIME,
+    TRUCK_PERCENT_UNLOADING_TIME,
+    TRUCK_PERCENT_IDLE_TIME,
+    TRUCK_TOTAL_MINING_TIME_HRS,
+    TRUCK_TOTAL_UNLOADS,
+    NUM_TRUCK_METRICS
+    };
+
+ /**
+  * @brief Defines the station performance metrics aggregated across replications
+  */
+enum StationMetrics {
+    STATION_PERCENT_UNLOADING_TIME,
+    STATION_PERCENT_IDLE_TIME,
+    STATION_TOTAL_IDLE_TIME_HRS,
+    STATION_TOTAL_UNLOADING_TIME_HRS,
+    STATION_TOTAL_UNLOADS,
+    NUM_STATION_METRICS
+    };
+
+/**
+* @brief  Names of the truck metrics, matching the truck performance CSV header
+*/
+static const array<const char*, NUM_TRUCK_METRICS> TRUCK_METRIC_NAMES{"Percent Mining Time", "Percent Travel Time", "Percent Unloading Time",
+                                                                        "Percent Idle Time", "Total Mining Time (hrs)", "Total Unloads"};
+
+/**
+* @brief  Names of the station metrics, matching the station performance CSV header
+*/
+static const array<const char*, NUM_STATION_METRICS> STATION_METRIC_NAMES{"Percent Unloading Time", "Percent Idle Time", "Total Idle Time (hrs)",
+                                                                            "Total Unloading Time (hrs)", "Total Unloads"};
+
+/**
+* @brief  Constructs new 'ReplicationStatistic' object. Summary of one metric across replications
+*/
+struct ReplicationStatistic{
+    double mean;                    // Sample mean
+    double stdDev;                  // Sample standard deviation
+    double confidenceHalfWidth;     // Half width of the 95% confidence interval of the mean
+    double percentile5;             // Estimated 5th percentile (P-squared)
+    double median;                  // Estimated median (P-squared)
+    double percentile95;            // Estimated 95th percentile (P-squared)
+
+    // Default constructor
+    ReplicationStatistic() : mean(0), stdDev(0), confidenceHalfWidth(0), percentile5(0), median(0), percentile95(0) {}
+};
+
+/**
+* @brief  Constructs new 'SequentialStoppingConfig' object. Stops launching replications once the 95% confidence interval of every
+*         target metric of every truck and station is narrow enough
+*/
+struct SequentialStoppingConfig{
+    double maxConfidenceHalfWidth{0};                                   // Largest accepted half width, in the units of each metric
+    size_t minReplications{5};                                          // Replications run before the half widths are checked
+    vector<TruckMetrics> truckMetrics{TRUCK_PERCENT_IDLE_TIME};         // Truck metrics that must meet the half width
+    vector<StationMetrics> stationMetrics{STATION_PERCENT_UNLOADING_TIME}; // Station metrics that must meet the half width
+};
+
+/**
+* @class ReplicationRunner
+* @brief Runs independent, reproducibly seeded replications of a simulation across a thread pool and aggregates
+*        the per-truck and per-station performance statistics. Results are added to streaming accumulators as replications
+*        finish, in replication order, so statistics and the stopping point do not depend on the number of threads
+*/
+class ReplicationRunner{
+    public:
+        /**
+        * @brief  Constructs new 'ReplicationRunner' object
+        * @param parameters Parameters of the simulation, replication i runs with parameters.seed and replication index i
+        * @param numReplications Number of replications to run, the most run in sequential mode
+        * @param numThreads Number of worker threads, defaults to the number of hardware threads
+        */
+        ReplicationRunner(const SimulationParameters& parameters, const size_t numReplications, const size_t numThreads = thread::hardware_concurrency()) :
+                            m_Parameters(parameters), m_NumReplications(numReplications), m_NumThreads(numThreads > 0 ? numThreads : 1),
+                            m_SequentialStopping(), m_SequentialStoppingEnabled(false), m_NumReplicationsRun(0), m_TruckAccumulators(), m_StationAccumulators(),
+                            m_TruckStatistics(parameters.numMiningTrucks), m_StationStatistics(parameters.numUnloadingStations), m_LiveMetrics(nullptr) {};
+
+        /**
+        * @brief  Enables sequential mode: replications are launched one at a time per worker and no more are launched once every
+        *         target metric's confidence interval half width is within config.maxConfidenceHalfWidth. The stopping point is
+        *         checked after each replication in replication order, so it is the same for any number of threads
+        */
+        void setSequentialStopping(const SequentialStoppingConfig& config){
+            m_SequentialStopping = config;
+            m_SequentialStoppingEnabled = true;
+        };
+
+        /**
+        * @brief  Sets the live metrics the replications publish their time steps and progress to, or nullptr to stop publishing
+        */
+        void setLiveMetrics(LiveMetrics* liveMetrics){
+            m_LiveMetrics = liveMetrics;
+        };
+
+        /**
+        * @brief  Destroys 'ReplicationRunner' object
+        */
+        virtual ~ReplicationRunner() = default;
+
+        /**
+        * @brief  Runs the replications and aggregates their results. If a replication throws, no more replications are launched
+        *         and the exception of the lowest failed replication is rethrown once the running ones have finished
+        */
+        void run(){
+            m_TruckAccumulators.assign(m_Parameters.numMiningTrucks, {});
+            m_StationAccumulators.assign(m_Parameters.numUnloadingStations, {});
+            m_NumReplicationsRun = 0;
+            if(m_LiveMetrics != nullptr){
+                m_LiveMetrics->setNumRuns(m_NumReplications);
+            }
+
+            // Finished replications wait here until every earlier replication has been added to the accumulators
+            mutex resultsMutex{};
+            condition_variable resultsCondition{};
+            map<uint32_t, ReplicationSamples> finishedReplications{};
+            size_t numFinished{0};
+            uint32_t failedReplication{0};
+            exception_ptr replicationException{};
+            {
+                ThreadPool threadPool(m_NumThreads);
+                uint32_t nextReplication{0};
+                size_t numSeenFinished{0};
+                bool stopped{false};
+                unique_lock<mutex> lock(resultsMutex);
+                while(true){
+                    // Add finished replications in order, checking the stopping rule after each
+                    map<uint32_t, ReplicationSamples>::iterator nextResult{finishedReplications.find(m_NumReplicationsRun)};
+                    while(!stopped && nextResult != finishedReplications.end()){
+                        ReplicationSamples samples{move(nextResult->second)};
+                        finishedReplications.erase(nextResult);
+                        lock.unlock();
+                        addReplication(samples);
+                        lock.lock();
+                        stopped = shouldStop();
+                        nextResult = finishedReplications.find(m_NumReplicationsRun);
+                    }
+                    if(stopped || replicationException != nullptr || m_NumReplicationsRun == m_NumReplications){
+                        break;
+                    }
+
+                    // Keep every worker busy with the next replications
+                    while(nextReplication < m_NumReplications && nextReplication - numFinished < m_NumThreads){
+                        const uint32_t replication{nextReplication++};
+                        threadPool.submit([this, replication, &resultsMutex, &resultsCondition, &finishedReplications, &numFinished,
+                                           &failedReplication, &replicationException](){
+                            ReplicationSamples samples{};
+                            exception_ptr exception{};
+                            try{
+                                samples = runReplication(replication);
+                            }
+                            catch(...){
+                                exception = current_exception();
+                            }
+
+                            // The count always moves on, so the loop wakes up even when a replication failed
+                            lock_guard<mutex> resultLock(resultsMutex);
+                            if(exception == nullptr){
+                                finishedReplications.emplace(replication, move(samples));
+                            }
+                            else if(replicationException == nullptr || replication < failedReplication){
+                                failedReplication = replication;
+                                replicationException = exception;
+                            }
+                            numFinished++;
+                            resultsCondition.notify_one();
+                        });
+                    }
+
+                    resultsCondition.wait(lock, [&](){ return numFinished > numSeenFinished; });
+                    numSeenFinished = numFinished;
+                }
+            }
+            if(replicationException != nullptr){
+                rethrow_exception(replicationException);
+            }
+
+            // Replications finished after the stopping point are discarded
+            computeStatistics();
+        };
+
+        /**
+        * @brief  Returns the aggregated statistics of every truck metric, indexed by truck id. The statistics keep their storage
+        *         across runs, each run overwrites them in place
+        */
+        const vector<array<ReplicationStatistic, NUM_TRUCK_METRICS>>& getTruckStatistics(){
+            return m_TruckStatistics;
+        };
+
+        /**
+        * @brief  Returns the aggregated statistics of every station metric, indexed by station id
+        */
+        const vector<array<ReplicationStatistic, NUM_STATION_METRICS>>& getStationStatistics(){
+            return m_StationStatistics;
+        };
+
+        /**
+        * @brief  Returns the number of replications aggregated by the last run, fewer than requested if sequential mode stopped early
+        */
+        const size_t getNumReplications(){
+            return m_NumReplicationsRun;
+        };
+
+        /**
+        * @brief  Prints the aggregated statistics of all trucks and stations
+        */
+        void printResults(){
+            cout << "Mining Truck Performance (" << m_NumReplicationsRun << " replications, mean +/- 95% CI): " << endl;
+            for(size_t i = 0; i < m_TruckStatistics.size(); i++){
+                cout << " - Truck ID: " << i;
+                for(int metric = 0; metric < NUM_TRUCK_METRICS; metric++){
+                    printStatistic(TRUCK_METRIC_NAMES[metric], m_TruckStatistics[i][metric]);
+                }
+                cout << endl;
+            }
+
+            cout << "Unloading Station Performance (" << m_NumReplicationsRun << " replications, mean +/- 95% CI): " << endl;
+            for(size_t i = 0; i < m_StationStatistics.size(); i++){
+                cout << " - Station ID: " << i;
+                for(int metric = 0; metric < NUM_STATION_METRICS; metric++){
+                    printStatistic(STATION_METRIC_NAMES[metric], m_StationStatistics[i][metric]);
+                }
+                cout << endl;
+            }
+        };
+
+        /**
+         * @brief Writes the aggregated statistics of all trucks and stations to one CSV file.
+         * @param fileName Base name of the file to save.
+         * @param resultsDir Name of the results directory to save file in.
+         */
+        void writeResultsToCSV(const string& fileName, const string& resultsDir){
+            // Check that results directory exists
+            if (!Simulation::createResultsDirectory(resultsDir)) {
+                return;
+            }
+
+            // Append date and time to fileName
+            string fullFileName = getUniqueResultFileName(resultsDir, fileName, ".csv");
+
+            // Open file in write mode
+            CsvWriter csvWriter(fullFileName);
+            if (!csvWriter.good()) {
+                error("Error: Could not open file {} for writing.", fullFileName);
+                return;
+            }
+
+            // Write CSV header
+            csvWriter.write("Entity,ID,Metric,Replications,Mean,Std Dev,CI95 Lower,CI95 Upper,P5,Median,P95").endRow();
+
+            // Write data to csv file
+            for(size_t i = 0; i < m_TruckStatistics.size(); i++){
+                for(int metric = 0; metric < NUM_TRUCK_METRICS; metric++){
+                    writeStatistic(csvWriter, "Truck", i, TRUCK_METRIC_NAMES[metric], m_TruckStatistics[i][metric]);
+                }
+            }
+            for(size_t i = 0; i < m_StationStatistics.size(); i++){
+                for(int metric = 0; metric < NUM_STATION_METRICS; metric++){
+                    writeStatistic(csvWriter, "Station", i, STATION_METRIC_NAMES[metric], m_StationStatistics[i][metric]);
+                }
+            }
+            if (!csvWriter.close()) {
+                error("Error: Could not write file {}", fullFileName);
+                return;
+            }
+            info("Replication results written to file: {}", fullFileName);
+        };
+
+        /**
+        * @brief  Returns the 97.5th percentile of the Student's t distribution, used for two-sided 95% confidence intervals
+        * @param degreesOfFreedom Degrees of freedom (number of replications - 1)
+        */
+        static double studentTQuantile975(const size_t degreesOfFreedom){
+            static const array<double, 30> quantiles{12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                                    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                                    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+            if(degreesOfFreedom == 0){
+                return 0;
+            }
+            if(degreesOfFreedom <= quantiles.size()){
+                return quantiles[degreesOfFreedom - 1];
+            }
+
+            // Cornish-Fisher expansion around the normal quantile for larger degrees of freedom
+            const double z{1.959963985};
+            const double v{static_cast<double>(degreesOfFreedom)};
+            return z + (pow(z, 3) + z) / (4 * v) + (5 * pow(z, 5) + 16 * pow(z, 3) + 3 * z) / (96 * v * v)
+                    + (3 * pow(z, 7) + 19 * pow(z, 5) + 17 * pow(z, 3) - 15 * z) / (384 * v * v * v);
+        };
+
+    protected:
+        /**
+        * @brief  Performance metrics of every truck and station of one replication
+        */
+        struct ReplicationSamples{
+            vector<array<float, NUM_TRUCK_METRICS>> trucks;
+            vector<array<float, NUM_STATION_METRICS>> stations;
+        };
+
+        /**
+        * @brief  Runs one replication and returns its performance metrics, may throw
+        */
+        virtual ReplicationSamples runReplication(const uint32_t replication){
+            SimulationParameters parameters{m_Parameters};
+            parameters.replication = replication;
+            Simulation simulation(parameters);
+            simulation.setLiveMetrics(m_LiveMetrics);
+            simulation.run();
+            if(m_LiveMetrics != nullptr){
+                m_LiveMetrics->completeRun();
+            }
+
+            ReplicationSamples samples{};
+            for(const TruckPerformanceStats& stats : simulation.getMiningTruckPerformances()){
+                samples.trucks.push_back({stats.percentMiningTime, stats.percentTravelTime, stats.percentUnloadingTime,
+                                            stats.percentIdleTime, stats.totalMiningTime_hrs, stats.totalUnloads});
+            }
+            for(const StationPerformanceStats& stats : simulation.getUnloadingStationPerformances()){
+                samples.stations.push_back({stats.percentUnloadingTime, stats.percentIdleTime, stats.totalIdleTime_hrs,
+                                            stats.totalUnloadingTime_hrs, stats.totalUnloads});
+            }
+            return samples;
+        };
+
+    private:
+        /**
+        * @brief  Parameters of the simulation
+        */
+        const SimulationParameters m_Parameters;
+
+        /**
+        * @brief  Number of replications to run, the most run in sequential mode
+        */
+        const size_t m_NumReplications;
+
+        /**
+        * @brief  Number of worker threads
+        */
+        const size_t m_NumThreads;
+
+        /**
+        * @brief  Stopping rule of sequential mode
+        */
+        SequentialStoppingConfig m_SequentialStopping;
+
+        /**
+        * @brief  True if sequential mode is enabled
+        */
+        bool m_SequentialStoppingEnabled;
+
+        /**
+        * @brief  Number of replications added to the accumulators
+        */
+        size_t m_NumReplicationsRun;
+
+        /**
+        * @brief  Streaming accumulators of every truck metric, indexed by truck id
+        */
+        vector<array<MetricAccumulator, NUM_TRUCK_METRICS>> m_TruckAccumulators;
+
+        /**
+        * @brief  Streaming accumulators of every station metric, indexed by station id
+        */
+        vector<array<MetricAccumulator, NUM_STATION_METRICS>> m_StationAccumulators;
+
+        /**
+        * @brief  Aggregated truck statistics, indexed by truck id
+        */
+        vector<array<ReplicationStatistic, NUM_TRUCK_METRICS>> m_TruckStatistics;
+
+        /**
+        * @brief  Aggregated station statistics, indexed by station id
+        */
+        vector<array<ReplicationStatistic, NUM_STATION_METRICS>> m_StationStatistics;
+
+        /**
+        * @brief  Live metrics the replications publish to, nullptr if not publishing
+        */
+        LiveMetrics* m_LiveMetrics;
+
+
+        /**
+        * @brief  Adds the metrics of the next replication to the accumulators
+        */
+        void addReplication(const ReplicationSamples& samples){
+            addSamples<NUM_TRUCK_METRICS>(m_TruckAccumulators, samples.trucks);
+            addSamples<NUM_STATION_METRICS>(m_StationAccumulators, samples.stations);
+            m_NumReplicationsRun++;
+        };
+
+        /**
+        * @brief  Adds the metrics of every entity of one replication to their accumulators
+        */
+        template<size_t NumMetrics>
+        static void addSamples(vector<array<MetricAccumulator, NumMetrics>>& accumulators, const vector<array<float, NumMetrics>>& samples){
+            for(size_t entity = 0; entity < accumulators.size() && entity < samples.size(); entity++){
+                for(size_t metric = 0; metric < NumMetrics; metric++){
+                    accumulators[entity][metric].add(samples[entity][metric]);
+                }
+            }
+        };
+
+        /**
+        * @brief  Returns true if sequential mode is enabled and every target metric's confidence interval is narrow enough
+        */
+        bool shouldStop(){
+            if(!m_SequentialStoppingEnabled || m_NumReplicationsRun < max<size_t>(m_SequentialStopping.minReplications, 2)){
+                return false;
+            }
+            const double tQuantile{studentTQuantile975(m_NumReplicationsRun - 1)};
+            for(const array<MetricAccumulator, NUM_TRUCK_METRICS>& accumulators : m_TruckAccumulators){
+                for(TruckMetrics metric : m_SequentialStopping.truckMetrics){
+                    if(accumulators[metric].getMoments().getConfidenceHalfWidth(tQuantile) > m_SequentialStopping.maxConfidenceHalfWidth){
+                        return false;
+                    }
+                }
+            }
+            for(const array<MetricAccumulator, NUM_STATION_METRICS>& accumulators : m_StationAccumulators){
+                for(StationMetrics metric : m_SequentialStopping.stationMetrics){
+                    if(accumulators[metric].getMoments().getConfidenceHalfWidth(tQuantile) > m_SequentialStopping.maxConfidenceHalfWidth){
+                        return false;
+                    }
+                }
+            }
+            return true;
+        };
+
+        /**
+        * @brief  Computes the statistics of every metric from the accumulators, in place so the statistics keep their storage
+        *         across runs
+        */
+        void computeStatistics(){
+            writeStatistics<NUM_TRUCK_METRICS>(m_TruckAccumulators, m_TruckStatistics);
+            writeStatistics<NUM_STATION_METRICS>(m_StationAccumulators, m_StationStatistics);
+        };
+
+        /**
+        * @brief  Writes the statistics of every metric of every entity
+        */
+        template<size_t NumMetrics>
+        void writeStatistics(const vector<array<MetricAccumulator, NumMetrics>>& accumulators, vector<array<ReplicationStatistic, NumMetrics>>& statistics){
+            const double tQuantile{studentTQuantile975(m_NumReplicationsRun > 0 ? m_NumReplicationsRun - 1 : 0)};
+            for(size_t entity = 0; entity < accumulators.size() && entity < statistics.size(); entity++){
+                for(size_t metric = 0; metric < NumMetrics; metric++){
+                    const MetricAccumulator& accumulator{accumulators[entity][metric]};
+                    ReplicationStatistic& statistic{statistics[entity][metric]};
+                    statistic.mean = accumulator.getMoments().getMean();
+                    statistic.stdDev = accumulator.getMoments().getStdDev();
+                    statistic.confidenceHalfWidth = accumulator.getMoments().getConfidenceHalfWidth(tQuantile);
+                    statistic.percentile5 = accumulator.getPercentile5();
+                    statistic.median = accumulator.getMedian();
+                    statistic.percentile95 = accumulator.getPercentile95();
+                }
+            }
+        };
+
+        /**
+        * @brief  Prints one aggregated statistic
+        */
+        static void printStatistic(const char* metricName, const ReplicationStatistic& statistic){
+            cout << ", " << metricName << ": " << fixed << setprecision(2) << statistic.mean << " +/- " << statistic.confidenceHalfWidth;
+        };
+
+        /**
+        * @brief  Writes one aggregated statistic as a CSV row
+        */
+        void writeStatistic(CsvWriter& csvWriter, const char* entity, const size_t id, const char* metricName, const ReplicationStatistic& statistic){
+            csvWriter.write(entity).write(id).write(metricName).write(m_NumReplicationsRun)
+                    .write(statistic.mean, 4).write(statistic.stdDev, 4)
+                    .write(statistic.mean - statistic.confidenceHalfWidth, 4)
+                    .write(statistic.mean + statistic.confidenceHalfWidth, 4)
+                    .write(statistic.percentile5, 4).write(statistic.median, 4).write(statistic.percentile95, 4).endRow();
+        };
+};
+
+#endif // REPLICATION_RUNNER_H
\ No newline at end of file
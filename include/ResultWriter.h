@@ -0,0 +1,331 @@
+#ifndef RESULT_WRITER_H
+#define RESULT_WRITER_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <fstream>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <atomic>
+#include <filesystem>
+#include <type_traits>
+#include <unistd.h>
+
+using namespace std;
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Columnar result files are written in little-endian byte order");
+
+/**
+* @brief  Returns a result file name "<resultsDir><fileName>_<YYYY-MM-DD_HH-MM-SS>_<pid>-<n><extension>" that no other file has.
+*         The process id and a per-process counter keep names unique between runs started in the same second and between
+*         files written by one run
+*/
+inline string getUniqueResultFileName(const string& resultsDir, const string& fileName, const string& extension){
+    static atomic<uint64_t> fileCount{0};
+
+    const time_t now{time(nullptr)};
+    tm localTime{};
+    localtime_r(&now, &localTime);
+    char dateTime[20];
+    strftime(dateTime, sizeof(dateTime), "%Y-%m-%d_%H-%M-%S", &localTime);
+
+    // A reused process id could still meet a file of an earlier run, so keep counting until the name is free
+    string fullFileName{};
+    do{
+        fullFileName = resultsDir + fileName + "_" + dateTime + "_" + to_string(getpid()) + "-" + to_string(fileCount++) + extension;
+    } while(filesystem::exists(fullFileName));
+    return fullFileName;
+}
+
+/**
+* @class CsvWriter
+* @brief Writes CSV rows into a large buffer with std::to_chars, independent of the locale, and writes the buffer to the
+*        file in blocks. Fields are separated by commas within a row
+*/
+class CsvWriter{
+    public:
+        /**
+        * @brief  Default size of the buffer written to the file in one block (1 MiB)
+        */
+        static constexpr size_t DEFAULT_BUFFER_SIZE{1 << 20};
+
+        /**
+        * @brief  Constructs new 'CsvWriter' object and opens the file
+        */
+        CsvWriter(const string& fileName, const size_t bufferSize = DEFAULT_BUFFER_SIZE) : m_OutFile(fileName, ios::binary | ios::trunc),
+                    m_Buffer(max(bufferSize, MIN_BUFFER_SIZE)), m_Size(0), m_RowStart(true) {};
+
+        CsvWriter(const CsvWriter&) = delete;
+        CsvWriter& operator=(const CsvWriter&) = delete;
+
+        /**
+        * @brief  Writes the rest of the buffer and closes the file
+        */
+        ~CsvWriter(){
+            close();
+        };
+
+        /**
+        * @brief  Writes a text field as is
+        */
+        CsvWriter& write(const string_view text){
+            separate();
+            if(text.size() > m_Buffer.size() - m_Size){
+                flush();
+                if(text.size() > m_Buffer.size()){
+                    m_OutFile.write(text.data(), text.size());
+                    return *this;
+                }
+            }
+            memcpy(m_Buffer.data() + m_Size, text.data(), text.size());
+            m_Size += text.size();
+            return *this;
+        };
+
+        /**
+        * @brief  Writes an integer field
+        */
+        template<typename T, typename enable_if<is_integral<T>::value, int>::type = 0>
+        CsvWriter& write(const T value){
+            separate();
+            reserve(MAX_NUMBER_SIZE);
+            m_Size = to_chars(m_Buffer.data() + m_Size, m_Buffer.data() + m_Buffer.size(), value).ptr - m_Buffer.data();
+            return *this;
+        };
+
+        /**
+        * @brief  Writes a floating point field with a fixed number of decimal places, like fixed << setprecision(precision)
+        */
+        CsvWriter& write(const double value, const int precision){
+            separate();
+            reserve(MAX_NUMBER_SIZE);
+            const to_chars_result result{to_chars(m_Buffer.data() + m_Size, m_Buffer.data() + m_Buffer.size(), value, chars_format::fixed, precision)};
+            if(result.ec != errc()){
+                // Only values too large for the buffer fail, fall back to the shortest representation
+                m_Size = to_chars(m_Buffer.data() + m_Size, m_Buffer.data() + m_Buffer.size(), value).ptr - m_Buffer.data();
+                return *this;
+            }
+            m_Size = result.ptr - m_Buffer.data();
+            return *this;
+        };
+
+        /**
+        * @brief  Ends the current row
+        */
+        CsvWriter& endRow(){
+            reserve(1);
+            m_Buffer[m_Size++] = '\n';
+            m_RowStart = true;
+            return *this;
+        };
+
+        /**
+        * @brief  Writes the buffer to the file
+        */
+        void flush(){
+            if(m_Size > 0){
+                m_OutFile.write(m_Buffer.data(), m_Size);
+                m_Size = 0;
+            }
+        };
+
+        /**
+        * @brief  Writes the rest of the buffer and closes the file. Returns true if every write succeeded
+        */
+        bool close(){
+            if(m_OutFile.is_open()){
+                flush();
+                m_OutFile.close();
+                m_Good = !m_OutFile.fail();
+            }
+            return m_Good;
+        };
+
+        /**
+        * @brief  Returns true if the file is open and every write so far succeeded
+        */
+        bool good() const {
+            return m_OutFile.is_open() ? m_OutFile.good() : m_Good;
+        };
+
+    private:
+        /**
+        * @brief  Smallest buffer, fits the longest formatted number
+        */
+        static constexpr size_t MIN_BUFFER_SIZE{512};
+
+        /**
+        * @brief  Room reserved for one formatted number, fits any fixed-point float with a few decimal places
+        */
+        static constexpr size_t MAX_NUMBER_SIZE{400};
+
+        /**
+        * @brief  File being written
+        */
+        ofstream m_OutFile;
+
+        /**
+        * @brief  Formatted rows not yet written to the file
+        */
+        vector<char> m_Buffer;
+
+        /**
+        * @brief  Number of characters in the buffer
+        */
+        size_t m_Size;
+
+        /**
+        * @brief  True until the first field of the current row is written
+        */
+        bool m_RowStart;
+
+        /**
+        * @brief  Result of closing the file
+        */
+        bool m_Good{false};
+
+        /**
+        * @brief  Writes the buffer to the file if it has less than size characters of room
+        */
+        void reserve(const size_t size){
+            if(m_Buffer.size() - m_Size < size){
+                flush();
+            }
+        };
+
+        /**
+        * @brief  Writes a comma before every field but the first of a row
+        */
+        void separate(){
+            if(!m_RowStart){
+                reserve(1);
+                m_Buffer[m_Size++] = ',';
+            }
+            m_RowStart = false;
+        };
+};
+
+/**
+* @brief  Constructs new 'ColumnarFileHeader' object. Header at the start of a columnar result file, followed by one
+*         ColumnarColumnHeader per column and the column data
+*/
+struct ColumnarFileHeader{
+    char magic[8]{'M', 'S', 'C', 'O', 'L', 'S', '\0', '\0'};   // Identifies the file as a columnar result file
+    uint32_t version{1};                                        // Version of the columnar format
+    uint32_t numColumns{0};                                     // Number of columns
+    uint64_t numRows{0};                                        // Number of values in every column
+};
+
+/**
+* @brief  Constructs new 'ColumnarColumnHeader' object. Name, type and position of one column of a columnar result file
+*/
+struct ColumnarColumnHeader{
+    char name[48]{};            // Column name, null terminated
+    char dtype[8]{};            // NumPy type string of the values, e.g. "<f4"
+    uint64_t offset{0};         // Offset of the first value from the start of the file, a multiple of COLUMN_ALIGNMENT
+};
+
+/**
+* @class ColumnarWriter
+* @brief Writes equally long columns of fixed-width little-endian values to a binary file that can be memory-mapped (see
+*        scripts/utils/file_io.py). Every column starts on a 64-byte boundary
+*/
+class ColumnarWriter{
+    public:
+        /**
+        * @brief  Alignment of the first value of every column in bytes
+        */
+        static constexpr uint64_t COLUMN_ALIGNMENT{64};
+
+        /**
+        * @brief  Constructs new 'ColumnarWriter' object for columns of numRows values
+        */
+        ColumnarWriter(const size_t numRows) : m_NumRows(numRows), m_ColumnHeaders(), m_Columns() {};
+
+        /**
+        * @brief  Adds a column. Returns false if the name is too long or the column has the wrong number of values
+        */
+        template<typename T>
+        bool addColumn(const string& name, const vector<T>& values){
+            static_assert(is_arithmetic<T>::value, "Columns hold numbers");
+            ColumnarColumnHeader columnHeader{};
+            if(values.size() != m_NumRows || name.size() >= sizeof(columnHeader.name)){
+                return false;
+            }
+            memcpy(columnHeader.name, name.data(), name.size());
+            const string dtype{getTypeName<T>()};
+            memcpy(columnHeader.dtype, dtype.data(), dtype.size());
+            m_ColumnHeaders.push_back(columnHeader);
+
+            vector<char> column(values.size() * sizeof(T));
+            memcpy(column.data(), values.data(), column.size());
+            m_Columns.push_back(move(column));
+            return true;
+        };
+
+        /**
+        * @brief  Writes the header and all columns to a file. Returns true if every write succeeded
+        */
+        bool write(const string& fileName){
+            ColumnarFileHeader header{};
+            header.numColumns = m_ColumnHeaders.size();
+            header.numRows = m_NumRows;
+
+            // Lay the columns out after the headers
+            uint64_t offset{alignOffset(sizeof(header) + m_ColumnHeaders.size() * sizeof(ColumnarColumnHeader))};
+            for(size_t i = 0; i < m_Columns.size(); i++){
+                m_ColumnHeaders[i].offset = offset;
+                offset = alignOffset(offset + m_Columns[i].size());
+            }
+
+            ofstream outFile(fileName, ios::binary | ios::trunc);
+            outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            outFile.write(reinterpret_cast<const char*>(m_ColumnHeaders.data()), m_ColumnHeaders.size() * sizeof(ColumnarColumnHeader));
+            uint64_t position{sizeof(header) + m_ColumnHeaders.size() * sizeof(ColumnarColumnHeader)};
+            const char padding[COLUMN_ALIGNMENT]{};
+            for(size_t i = 0; i < m_Columns.size(); i++){
+                outFile.write(padding, m_ColumnHeaders[i].offset - position);
+                outFile.write(m_Columns[i].data(), m_Columns[i].size());
+                position = m_ColumnHeaders[i].offset + m_Columns[i].size();
+            }
+            outFile.flush();
+            return outFile.good();
+        };
+
+        /**
+        * @brief  Returns the NumPy type string of a value type
+        */
+        template<typename T>
+        static string getTypeName(){
+            const char kind{is_floating_point<T>::value ? 'f' : (is_signed<T>::value ? 'i' : 'u')};
+            return string(sizeof(T) == 1 ? "|" : "<") + kind + to_string(sizeof(T));
+        };
+
+    private:
+        /**
+        * @brief  Number of values in every column
+        */
+        const size_t m_NumRows;
+
+        /**
+        * @brief  Headers of the columns added so far
+        */
+        vector<ColumnarColumnHeader> m_ColumnHeaders;
+
+        /**
+        * @brief  Values of the columns added so far
+        */
+        vector<vector<char>> m_Columns;
+
+        /**
+        * @brief  Rounds an offset up to the column alignment
+        */
+        static uint64_t alignOffset(const uint64_t offset){
+            return (offset + COLUMN_ALIGNMENT - 1) / COLUMN_ALIGNMENT * COLUMN_ALIGNMENT;
+        };
+};
+
+#endif // RESULT_WRITER_H
@@ -0,0 +1,145 @@
+#ifndef RUNTIME_METRICS_H
+#define RUNTIME_METRICS_H
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+
+using namespace std;
+
+/**
+* @brief  Runs its arguments only when the simulation is compiled with ENABLE_RUNTIME_METRICS, otherwise compiles to nothing,
+*         so instrumentation can stay in the hot paths of production builds at no cost
+*/
+#ifdef ENABLE_RUNTIME_METRICS
+#define RUNTIME_METRICS(...) __VA_ARGS__
+#else
+#define RUNTIME_METRICS(...)
+#endif
+
+/**
+* @brief  Constructs new 'PhaseMetrics' object. Cumulative wall time and number of calls of one phase of a time step
+*/
+struct PhaseMetrics{
+    double totalTime_s{0};      // Cumulative wall time spent in the phase (s)
+    uint64_t numCalls{0};       // Number of times the phase ran
+
+    /**
+    * @brief  Returns the mean wall time of one call in microseconds
+    */
+    double getMeanTime_us() const {
+        return numCalls > 0 ? totalTime_s * 1e6 / numCalls : 0;
+    };
+};
+
+/**
+* @brief  Constructs new 'TruckCounters' object. Counters kept by the mining truck processor
+*/
+struct TruckCounters{
+    uint64_t numStateChanges{0};    // Number of truck state changes
+};
+
+/**
+* @brief  Constructs new 'DispatchCounters' object. Counters kept by the unloading station processor
+*/
+struct DispatchCounters{
+    uint64_t numAssignedToAvailableStation{0};      // Trucks dispatched to an available station
+    uint64_t numAssignedToShortestWaitStation{0};   // Trucks dispatched to the busy station with the shortest wait, as no station was available
+    uint64_t numUnassignedTrucks{0};                // Loaded trucks the dispatcher could not assign
+    size_t maxStationQueueLength{0};                // Longest station queue (high-water mark)
+};
+
+/**
+* @brief  Constructs new 'RuntimeMetrics' object. Runtime metrics of the runs of a simulation, all zero unless the simulation
+*         is compiled with ENABLE_RUNTIME_METRICS
+*/
+struct RuntimeMetrics{
+    bool enabled{false};                            // True if compiled with ENABLE_RUNTIME_METRICS
+    PhaseMetrics stationUpdate{};                   // Station update phase
+    PhaseMetrics truckUpdate{};                     // Truck update phase
+    PhaseMetrics assignment{};                      // Assignment of loaded trucks to stations phase
+    uint64_t numTimesteps{0};                       // Time steps processed (the discrete-event engine skips time steps without events)
+    uint64_t maxTruckStateChangesPerTimestep{0};    // Most truck state changes in one time step
+    TruckCounters trucks{};                         // Truck counters
+    DispatchCounters dispatch{};                    // Dispatcher counters
+
+    /**
+    * @brief  Returns the mean number of truck state changes per processed time step
+    */
+    double getMeanTruckStateChangesPerTimestep() const {
+        return numTimesteps > 0 ? static_cast<double>(trucks.numStateChanges) / numTimesteps : 0;
+    };
+
+    /**
+    * @brief  Prints the runtime metrics
+    */
+    void print() const {
+        if(!enabled){
+            cout << "Runtime Metrics: disabled (build with ENABLE_RUNTIME_METRICS)" << endl;
+            return;
+        }
+
+        const double totalTime_s{stationUpdate.totalTime_s + truckUpdate.totalTime_s + assignment.totalTime_s};
+        cout << "Runtime Metrics: " << endl;
+        printPhase("Station Update", stationUpdate, totalTime_s);
+        printPhase("Truck Update", truckUpdate, totalTime_s);
+        printPhase("Assignment", assignment, totalTime_s);
+        cout << " - Time Steps: " << numTimesteps
+        << ", Truck State Changes: " << trucks.numStateChanges
+        << ", Per Time Step: " << fixed << setprecision(2) << getMeanTruckStateChangesPerTimestep()
+        << " (max " << maxTruckStateChangesPerTimestep << ")" << endl;
+        cout << " - Dispatched To Available Station: " << dispatch.numAssignedToAvailableStation
+        << ", To Shortest Wait Station: " << dispatch.numAssignedToShortestWaitStation
+        << ", Unassigned: " << dispatch.numUnassignedTrucks
+        << ", Max Station Queue Length: " << dispatch.maxStationQueueLength << endl;
+    };
+
+    private:
+        /**
+        * @brief  Prints the metrics of one phase
+        */
+        static void printPhase(const char* name, const PhaseMetrics& phase, const double totalTime_s){
+            cout << " - " << name << ": " << fixed << setprecision(3) << phase.totalTime_s * 1e3 << " ms"
+            << " (" << setprecision(2) << (totalTime_s > 0 ? phase.totalTime_s / totalTime_s * 100 : 0) << "%)"
+            << ", Calls: " << phase.numCalls
+            << ", Mean: " << phase.getMeanTime_us() << " us" << endl;
+        };
+};
+
+/**
+* @class PhaseClock
+* @brief Measures consecutive phases of a time step, each lap adds the time since the previous lap to a phase
+*/
+class PhaseClock{
+    public:
+        /**
+        * @brief  Constructs new 'PhaseClock' object and starts the first phase
+        */
+        PhaseClock() : m_LastLap(chrono::steady_clock::now()) {};
+
+        /**
+        * @brief  Starts the next phase now
+        */
+        void start(){
+            m_LastLap = chrono::steady_clock::now();
+        };
+
+        /**
+        * @brief  Ends the current phase, adding its duration and one call to phase, and starts the next phase
+        */
+        void lap(PhaseMetrics& phase){
+            const chrono::steady_clock::time_point now{chrono::steady_clock::now()};
+            phase.totalTime_s += chrono::duration<double>(now - m_LastLap).count();
+            phase.numCalls++;
+            m_LastLap = now;
+        };
+
+    private:
+        /**
+        * @brief  Start time of the current phase
+        */
+        chrono::steady_clock::time_point m_LastLap;
+};
+
+#endif // RUNTIME_METRICS_H
@@ -3,15 +3,53 @@
 
 #include <MiningTruckProcessor.h>
 #include <UnloadingStationProcessor.h>
+#include <SimulationEvent.h>
+#include <SimulationCheckpoint.h>
+#include <RuntimeMetrics.h>
+#include <ResultWriter.h>
+#include <TimeSeriesRecorder.h>
+#include <TimingWheel.h>
+#include <ArrayView.h>
+#include <LiveMetrics.h>
 #include <iomanip>
 #include <fstream>
 #include <ctime>
 #include <filesystem>
+#include <memory>
 #include "spdlog/spdlog.h"
 
 using namespace std;
 using namespace spdlog;
 
+ /**
+  * @brief Defines the different engines that can be used to run the simulation
+  */
+enum SimulationEngines {
+    FIXED_STEP,         // Advances every truck and station by one time step per step
+    DISCRETE_EVENT,     // Jumps directly between time steps in which a truck or station changes state
+    STRUCT_OF_ARRAYS,   // Same as FIXED_STEP, with trucks stored as a struct-of-arrays fleet and counted down by a vectorized kernel
+    TIMING_WHEEL,       // Advances one time step at a time, but only touches the trucks whose state ends in that time step
+    ADAPTIVE_STEP       // Same as STRUCT_OF_ARRAYS, skipping the time steps in which no truck or station changes state in one jump
+    };
+
+/**
+* @brief  Constructs new 'SimulationParameters' object. Holds all inputs used to construct a 'Simulation'
+*/
+struct SimulationParameters{
+    size_t numMiningTrucks{1};                                  // Number of mining trucks
+    size_t numUnloadingStations{1};                             // Number of unloading stations
+    float minMiningDuration_hrs{1};                             // Minimum mining duration (hrs)
+    float maxMiningDuration_hrs{5};                             // Maximum mining duration (hrs)
+    float travelDuration_hrs{0.5};                              // Travel duration (hrs)
+    float unloadDuration_min{5};                                // Unload duration (min)
+    double simulationTime_hrs{72};                              // Full duration of simulation (hrs)
+    double simulationTimestep_min{5};                           // Length of a single timestep (min)
+    SimulationEngines simulationEngine{SimulationEngines::FIXED_STEP}; // Engine used to run the simulation
+    uint64_t seed{0};                                           // Seed of the random number generator
+    uint32_t replication{0};                                    // Index of the replication of the seed
+    string fleetImageFileName{};                                // Fleet image mining durations are loaded from, empty to generate them
+};
+
 /**
  * @class Simulation
  * @brief Manages the simulation of mining truck and unloading stations
@@ -24,86 +62,496 @@ class Simulation{
         */
         Simulation(const size_t numMiningTrucks, const size_t numUnloadingStations, const float min_mining_duration_hrs,
                     const float max_mining_duration_hrs, const float travel_duration_hrs, const float unload_duration_hrs, 
-                    const double simulation_time_hrs, const double simulation_timestep_min) : m_SimulationTime(simulation_time_hrs * 60), 
-                    m_SimulationTimestep(simulation_timestep_min), m_CurrentSimulationTime(0),
-                    m_MiningTrucksProcessor(numMiningTrucks, min_mining_duration_hrs, max_mining_duration_hrs, travel_duration_hrs, unload_duration_hrs),
-                    m_UnloadingStationProcessor(numUnloadingStations, unload_duration_hrs), m_MiningTrucksPerformance(), m_UnloadingStationsPerformance() {}
+                    const double simulation_time_hrs, const double simulation_timestep_min, const SimulationEngines simulation_engine = SimulationEngines::FIXED_STEP,
+                    const uint64_t seed = random_device{}(), const uint32_t replication = 0, const string& fleet_image_file_name = "") : 
+                    m_SimulationTime(hoursToTicks(simulation_time_hrs)), m_SimulationTimestep(max<SimulationTicks>(minutesToTicks(simulation_timestep_min), 1)), m_CurrentSimulationTime(0), m_SimulationEngine(simulation_engine),
+                    m_Seed(seed), m_Replication(replication),
+                    m_MiningTrucksProcessor(numMiningTrucks, min_mining_duration_hrs, max_mining_duration_hrs, travel_duration_hrs, unload_duration_hrs, seed, replication, fleet_image_file_name),
+                    m_UnloadingStationProcessor(numUnloadingStations, unload_duration_hrs, numMiningTrucks), m_MiningTrucksPerformance(), m_UnloadingStationsPerformance(),
+                    m_PerformanceStatsDirty(true), m_EventTraceFileName(), m_EventTrace(nullptr), m_RuntimeMetrics(), m_NumTruckStateChanges(0), m_TimeSeriesRecorder(),
+                    m_LiveMetrics(nullptr), m_LiveMetricsTime(0), m_LiveMetricsStateChanges(0) {}
+
+        /**
+        * @brief  Constructs new 'Simulation' object from a set of simulation parameters
+        */
+        Simulation(const SimulationParameters& parameters) : Simulation(parameters.numMiningTrucks, parameters.numUnloadingStations, 
+                    parameters.minMiningDuration_hrs, parameters.maxMiningDuration_hrs, parameters.travelDuration_hrs, parameters.unloadDuration_min, 
+                    parameters.simulationTime_hrs, parameters.simulationTimestep_min, parameters.simulationEngine, parameters.seed, parameters.replication, parameters.fleetImageFileName) {}
 
         /**
         * @brief  Runs the full simulation to completion
         */
         void run(){
-            while(m_CurrentSimulationTime <= m_SimulationTime){
-                // Simulate step : update stations --> Update vehicles --> Assign vehicles to stations if applicable
-                m_UnloadingStationProcessor.updateUnloadingStations(m_SimulationTimestep, m_MiningTrucksProcessor.m_MiningTrucksList); // update unloading stations
-                m_MiningTrucksProcessor.updateMiningTrucks(m_SimulationTimestep); // update vehicles
-                m_UnloadingStationProcessor.assignVehiclesToStations(m_MiningTrucksProcessor.m_MiningTrucksList, m_MiningTrucksProcessor.getLoadedTrucks());
+            m_PerformanceStatsDirty = true;
+            resetLiveMetrics();
 
-                // Increment simulation time
-                m_CurrentSimulationTime += m_SimulationTimestep;
+            // Open event trace for the duration of the run
+            unique_ptr<EventTraceWriter> eventTrace{};
+            if(!m_EventTraceFileName.empty()){
+                eventTrace = make_unique<EventTraceWriter>(m_EventTraceFileName, ticksToMinutes(m_SimulationTimestep), ticksToMinutes(m_CurrentSimulationTime));
+                m_EventTrace = eventTrace.get();
+                m_MiningTrucksProcessor.setEventTrace(m_EventTrace);
+                m_UnloadingStationProcessor.setEventTrace(m_EventTrace);
             }
+
+            switch(m_SimulationEngine){
+                case SimulationEngines::FIXED_STEP:
+                    runFixedStep();
+                    break;
+                case SimulationEngines::DISCRETE_EVENT:
+                    // The discrete-event engine skips the time steps between events, time series are sampled by the fixed-step engine
+                    // instead, which produces the same results
+                    if(m_TimeSeriesRecorder.isEnabled()){
+                        runFixedStep();
+                        break;
+                    }
+                    runDiscreteEvent();
+                    break;
+                case SimulationEngines::STRUCT_OF_ARRAYS:
+                    runStructOfArrays();
+                    break;
+                case SimulationEngines::TIMING_WHEEL:
+                    runTimingWheel();
+                    break;
+                case SimulationEngines::ADAPTIVE_STEP:
+                    // Skipped time steps are not sampled, time series are sampled by the struct-of-arrays engine instead
+                    if(m_TimeSeriesRecorder.isEnabled()){
+                        runStructOfArrays();
+                        break;
+                    }
+                    runAdaptiveStep();
+                    break;
+            }
+
+            if(eventTrace){
+                info("{} events written to event trace: {}", eventTrace->getNumEvents(), m_EventTraceFileName);
+                m_MiningTrucksProcessor.setEventTrace(nullptr);
+                m_UnloadingStationProcessor.setEventTrace(nullptr);
+                m_EventTrace = nullptr;
+            }
+        };
+
+        /**
+        * @brief  Advances every truck and station by one time step, as the fixed-step engine does. Once the station queues have grown
+        *         to their longest length a step does not allocate memory (when trucks are updated on one thread)
+        */
+        void step(){
+            m_PerformanceStatsDirty = true;
+            vector<Truck>& miningTrucksList{m_MiningTrucksProcessor.m_MiningTrucksList};
+            simulateTimestep(m_CurrentSimulationTime, miningTrucksList,
+                [&](){ m_UnloadingStationProcessor.updateUnloadingStations(m_SimulationTimestep, miningTrucksList); },
+                [&](){ m_MiningTrucksProcessor.updateMiningTrucks(m_SimulationTimestep); },
+                [&](){ m_UnloadingStationProcessor.assignVehiclesToStations(miningTrucksList, m_MiningTrucksProcessor.getLoadedTrucks()); });
+
+            // Increment simulation time
+            m_CurrentSimulationTime += m_SimulationTimestep;
+        };
+
+        /**
+        * @brief  Starts sampling truck state counts and station queue lengths and busy states every config.sampleInterval_min
+        *         minutes of the following runs, into time series of constant size. Replaces any series recorded so far
+        */
+        void enableTimeSeries(const TimeSeriesConfig& config){
+            m_TimeSeriesRecorder = TimeSeriesRecorder(m_UnloadingStationProcessor.m_UnloadingStationsList.size(), config);
         };
 
-         /**
-        * @brief  Computes simulation performance statistics for mining trucks and unload stations
+        /**
+        * @brief  Returns the recorded time series, disabled unless enableTimeSeries was called
+        */
+        const TimeSeriesRecorder& getTimeSeries(){
+            return m_TimeSeriesRecorder;
+        };
+
+        /**
+         * @brief Writes every bucket of every recorded time series at every resolution level to a CSV file. Returns the name of the
+         *        file, or an empty string if it could not be written.
+         * @param fileName Base name of the file to save.
+         * @param resultsDir Name of the results directory to save file in.
+         */
+        string writeTimeSeriesToCSV(const string& fileName, const string& resultsDir) {
+            // Check that results directory exists
+            if (!createResultsDirectory(resultsDir)) {
+                return "";
+            }
+
+            // Append date and time to fileName
+            string fullFileName = getUniqueResultFileName(resultsDir, fileName, ".csv");
+
+            // Open file in write mode
+            CsvWriter csvWriter(fullFileName);
+            if (!csvWriter.good()) {
+                error("Error: Could not open file {} for writing.", fullFileName);
+                return "";
+            }
+
+            // Write CSV header
+            csvWriter.write("Level,Series,Start Time (min),Samples,Min,Max,Mean").endRow();
+
+            // Write data to csv file
+            for (size_t level = 0; level < m_TimeSeriesRecorder.getNumLevels(); level++) {
+                for (size_t seriesIdx = 0; seriesIdx < m_TimeSeriesRecorder.getNumSeries(); seriesIdx++) {
+                    const string seriesName{m_TimeSeriesRecorder.getSeriesName(seriesIdx)};
+                    for (const TimeSeriesPoint& point : m_TimeSeriesRecorder.getSeries(seriesIdx, level)) {
+                        csvWriter.write(level).write(seriesName).write(point.startTime_min, 2).write(point.numSamples)
+                                .write(point.min, 2).write(point.max, 2).write(point.mean, 4).endRow();
+                    }
+                }
+            }
+            if (!csvWriter.close()) {
+                error("Error: Could not write file {}", fullFileName);
+                return "";
+            }
+            info("Time series written to file: {}", fullFileName);
+            return fullFileName;
+        }
+
+        /**
+        * @brief  Saves the complete state of the simulation (time, trucks, stations with their queues, available stations and
+        *         random number generator) to a versioned binary checkpoint. Returns true on success
+        * @param fileName Path of the checkpoint file, replaced if it exists
+        */
+        bool saveCheckpoint(const string& fileName){
+            CheckpointWriter checkpoint(fileName);
+            checkpoint.write(m_CurrentSimulationTime);
+
+            // Mining durations are drawn from counter-based streams at initialization, so the seed and replication are the full generator state
+            checkpoint.write(m_Seed);
+            checkpoint.write(m_Replication);
+
+            // Write trucks one field at a time, indexed by truck id
+            const vector<Truck>& trucks{m_MiningTrucksProcessor.m_MiningTrucksList};
+            vector<int32_t> miningCycleDurations{}, truckStates{}, timesUntilNextState{}, numTravelCycles{}, numMiningCycles{}, numUnloads{};
+            vector<uint8_t> isLoaded{}, isAssignedStation{};
+            for(const Truck& truck : trucks){
+                miningCycleDurations.push_back(truck.miningCycleDuration);
+                truckStates.push_back(truck.state);
+                timesUntilNextState.push_back(truck.timeUntilNextState);
+                isLoaded.push_back(truck.isLoaded);
+                isAssignedStation.push_back(truck.isAssignedStation);
+                numTravelCycles.push_back(truck.numTravelCycles);
+                numMiningCycles.push_back(truck.numMiningCycles);
+                numUnloads.push_back(truck.numUnloads);
+            }
+            checkpoint.writeArray(miningCycleDurations);
+            checkpoint.writeArray(truckStates);
+            checkpoint.writeArray(timesUntilNextState);
+            checkpoint.writeArray(isLoaded);
+            checkpoint.writeArray(isAssignedStation);
+            checkpoint.writeArray(numTravelCycles);
+            checkpoint.writeArray(numMiningCycles);
+            checkpoint.writeArray(numUnloads);
+
+            // Write stations one field at a time, indexed by station id, with all vehicle queues stored back to back
+            vector<int32_t> stationStates{}, waitTimes{}, numVehiclesUnloaded{}, queuedVehicleIds{};
+            vector<uint64_t> queueSizes{};
+            for(const Station& station : m_UnloadingStationProcessor.m_UnloadingStationsList){
+                stationStates.push_back(station.state);
+                waitTimes.push_back(station.waitTime);
+                numVehiclesUnloaded.push_back(station.numVehiclesUnloaded);
+                queueSizes.push_back(station.vehicleIdQueue.size());
+                for(size_t i = 0; i < station.vehicleIdQueue.size(); i++){
+                    queuedVehicleIds.push_back(station.vehicleIdQueue[i]);
+                }
+            }
+            checkpoint.writeArray(stationStates);
+            checkpoint.writeArray(waitTimes);
+            checkpoint.writeArray(numVehiclesUnloaded);
+            checkpoint.writeArray(queueSizes);
+            checkpoint.writeArray(queuedVehicleIds);
+
+            // Write available stations
+            vector<int32_t> availableStationIdxs{};
+            queue<int> availableStations{m_UnloadingStationProcessor.getAvailableLoadingStations()};
+            while(!availableStations.empty()){
+                availableStationIdxs.push_back(availableStations.front());
+                availableStations.pop();
+            }
+            checkpoint.writeArray(availableStationIdxs);
+
+            if(!checkpoint.good()){
+                error("Error: Could not write checkpoint file {}", fileName);
+                return false;
+            }
+            return true;
+        };
+
+        /**
+        * @brief  Restores the complete state of the simulation from a checkpoint saved by a simulation with the same number of
+        *         trucks and stations. The simulation horizon, engine and durations of this simulation are kept, so one warmed up
+        *         checkpoint can be resumed or forked into many experiments. Returns true on success, otherwise leaves the state unchanged
+        * @param fileName Path of the checkpoint file
+        */
+        bool restoreCheckpoint(const string& fileName){
+            CheckpointReader checkpoint(fileName);
+            if(!checkpoint.good()){
+                error("Error: {} is not a version {} simulation checkpoint.", fileName, CheckpointHeader{}.version);
+                return false;
+            }
+
+            SimulationTicks currentSimulationTime{0};
+            uint64_t seed{0};
+            uint32_t replication{0};
+            checkpoint.read(currentSimulationTime);
+            checkpoint.read(seed);
+            checkpoint.read(replication);
+
+            // Read trucks
+            const size_t numTrucks{m_MiningTrucksProcessor.m_MiningTrucksList.size()};
+            vector<int32_t> miningCycleDurations{}, truckStates{}, timesUntilNextState{}, numTravelCycles{}, numMiningCycles{}, numUnloads{};
+            vector<uint8_t> isLoaded{}, isAssignedStation{};
+            checkpoint.readArray(miningCycleDurations, numTrucks);
+            checkpoint.readArray(truckStates, numTrucks);
+            checkpoint.readArray(timesUntilNextState, numTrucks);
+            checkpoint.readArray(isLoaded, numTrucks);
+            checkpoint.readArray(isAssignedStation, numTrucks);
+            checkpoint.readArray(numTravelCycles, numTrucks);
+            checkpoint.readArray(numMiningCycles, numTrucks);
+            checkpoint.readArray(numUnloads, numTrucks);
+
+            // Read stations
+            const size_t numStations{m_UnloadingStationProcessor.m_UnloadingStationsList.size()};
+            vector<int32_t> stationStates{}, waitTimes{}, numVehiclesUnloaded{}, queuedVehicleIds{}, availableStationIdxs{};
+            vector<uint64_t> queueSizes{};
+            checkpoint.readArray(stationStates, numStations);
+            checkpoint.readArray(waitTimes, numStations);
+            checkpoint.readArray(numVehiclesUnloaded, numStations);
+            checkpoint.readArray(queueSizes, numStations);
+            checkpoint.readArray(queuedVehicleIds, numTrucks);
+            checkpoint.readArray(availableStationIdxs, numStations);
+            if(!checkpoint.good()){
+                error("Error: Could not read checkpoint file {}, or it has more than {} trucks or {} stations.", fileName, numTrucks, numStations);
+                return false;
+            }
+
+            // Validate checkpoint matches this simulation
+            if(miningCycleDurations.size() != numTrucks || stationStates.size() != numStations){
+                error("Error: Checkpoint has {} trucks and {} stations, simulation has {} trucks and {} stations.",
+                        miningCycleDurations.size(), stationStates.size(), numTrucks, numStations);
+                return false;
+            }
+            const bool validStates{all_of(truckStates.begin(), truckStates.end(), [](int32_t state){ return TruckStateMachine::isValidState(state); })
+                                && all_of(timesUntilNextState.begin(), timesUntilNextState.end(), [](int32_t time){ return time >= 0; })
+                                && all_of(stationStates.begin(), stationStates.end(), [](int32_t state){ return StationStateMachine::isValidState(state); })};
+            if(!validStates){
+                error("Error: Checkpoint file {} has invalid truck or station states.", fileName);
+                return false;
+            }
+
+            // Queues hold at most every truck, which also keeps the sum of their sizes from overflowing
+            uint64_t numQueuedVehicles{0};
+            bool validQueues{true};
+            for(uint64_t queueSize : queueSizes){
+                if(queueSize > queuedVehicleIds.size() - numQueuedVehicles){
+                    validQueues = false;
+                    break;
+                }
+                numQueuedVehicles += queueSize;
+            }
+            const bool validIds{all_of(queuedVehicleIds.begin(), queuedVehicleIds.end(), [numTrucks](int32_t id){ return id >= 0 && static_cast<size_t>(id) < numTrucks; })
+                                && all_of(availableStationIdxs.begin(), availableStationIdxs.end(), [numStations](int32_t id){ return id >= 0 && static_cast<size_t>(id) < numStations; })};
+            if(!validQueues || numQueuedVehicles != queuedVehicleIds.size() || !validIds){
+                error("Error: Checkpoint file {} has invalid station queues.", fileName);
+                return false;
+            }
+
+            // Rebuild trucks
+            vector<Truck> trucks{};
+            trucks.reserve(numTrucks);
+            for(size_t i = 0; i < numTrucks; i++){
+                Truck truck(static_cast<int>(i), miningCycleDurations[i]);
+                truck.state = truckStates[i];
+                truck.timeUntilNextState = timesUntilNextState[i];
+                truck.isLoaded = isLoaded[i];
+                truck.isAssignedStation = isAssignedStation[i];
+                truck.numTravelCycles = numTravelCycles[i];
+                truck.numMiningCycles = numMiningCycles[i];
+                truck.numUnloads = numUnloads[i];
+                trucks.push_back(truck);
+            }
+
+            // Rebuild stations
+            vector<Station> stations{};
+            stations.reserve(numStations);
+            size_t queuedVehicleIdx{0};
+            for(size_t i = 0; i < numStations; i++){
+                Station station(static_cast<int>(i));
+                station.state = stationStates[i];
+                station.waitTime = waitTimes[i];
+                station.numVehiclesUnloaded = numVehiclesUnloaded[i];
+                for(uint64_t j = 0; j < queueSizes[i]; j++){
+                    station.vehicleIdQueue.push(queuedVehicleIds[queuedVehicleIdx++]);
+                }
+                stations.push_back(station);
+            }
+
+            // Replace state
+            m_CurrentSimulationTime = currentSimulationTime;
+            m_Seed = seed;
+            m_Replication = replication;
+            m_MiningTrucksProcessor.m_MiningTrucksList = move(trucks);
+            m_UnloadingStationProcessor.m_UnloadingStationsList = move(stations);
+            m_UnloadingStationProcessor.poolStationQueues();
+            queue<int> availableStations{};
+            for(int32_t stationIdx : availableStationIdxs){
+                availableStations.push(stationIdx);
+            }
+            m_UnloadingStationProcessor.setAvailableLoadingStations(availableStations);
+            m_PerformanceStatsDirty = true;
+            return true;
+        };
+
+        /**
+        * @brief  Sets the number of threads the fixed-step engines update trucks on. Fleets of at least 65536 trucks are split across
+        *         the threads, and results are identical for any number of threads
+        */
+        void setNumThreads(const size_t numThreads){
+            m_MiningTrucksProcessor.setNumUpdateThreads(numThreads);
+        };
+
+        /**
+        * @brief  Returns the runtime metrics of every run of the simulation (time and calls of each phase, truck state changes,
+        *         dispatcher decisions and queue high-water mark). All zero unless compiled with ENABLE_RUNTIME_METRICS
+        */
+        const RuntimeMetrics getRuntimeMetrics(){
+            RuntimeMetrics runtimeMetrics{m_RuntimeMetrics};
+            RUNTIME_METRICS(runtimeMetrics.enabled = true;)
+            RUNTIME_METRICS(runtimeMetrics.trucks = m_MiningTrucksProcessor.getTruckCounters();)
+            runtimeMetrics.dispatch = m_UnloadingStationProcessor.getDispatchCounters();
+            return runtimeMetrics;
+        };
+
+        /**
+        * @brief  Print runtime metrics of every run of the simulation
+        */
+        void printRuntimeMetrics(){
+            getRuntimeMetrics().print();
+        };
+
+        /**
+        * @brief  Sets the file every truck and station event of the next run is traced to. An empty file name disables tracing
+        */
+        void setEventTraceFileName(const string& fileName){
+            m_EventTraceFileName = fileName;
+        };
+
+        /**
+        * @brief  Sets the live metrics every time step is published to, read by a metrics exporter while the simulation runs, or
+        *         nullptr to stop publishing. The metrics must outlive the runs publishing to them
+        */
+        void setLiveMetrics(LiveMetrics* liveMetrics){
+            m_LiveMetrics = liveMetrics;
+            resetLiveMetrics();
+        };
+
+        /**
+        * @brief  Returns the seed of the random number generator
+        */
+        const uint64_t getSeed(){
+            return m_Seed;
+        };
+
+        /**
+        * @brief  Returns the index of the replication of the seed
+        */
+        const uint32_t getReplication(){
+            return m_Replication;
+        };
+
+        /**
+        * @brief  Sets the engine used to run the simulation
+        */
+        void setSimulationEngine(const SimulationEngines simulationEngine){
+            m_SimulationEngine = simulationEngine;
+        };
+
+        /**
+        * @brief  Computes simulation performance statistics for mining trucks and unload stations from the cycle counts the engines
+        *         keep up to date, replacing the previous statistics in place. Percentages are of the full simulation time, also mid-run
         */
         void computePerformanceStats(){
-            const float unloadDuration{m_UnloadingStationProcessor.getUnloadDuration()};
+            const int unloadDuration{m_UnloadingStationProcessor.getUnloadDuration()};
 
-            // Compute performance for all mining trucks
-            for (const Truck& truck : m_MiningTrucksProcessor.m_MiningTrucksList) {
-                TruckPerformanceStats truck_stats{computeTruckPerformance(truck, unloadDuration)};
-                m_MiningTrucksPerformance.push_back(truck_stats);
+            // Compute performance for all mining trucks, reusing the storage of the previous statistics
+            const vector<Truck>& miningTrucksList{m_MiningTrucksProcessor.m_MiningTrucksList};
+            m_MiningTrucksPerformance.clear();
+            m_MiningTrucksPerformance.reserve(miningTrucksList.size());
+            for (const Truck& truck : miningTrucksList) {
+                m_MiningTrucksPerformance.push_back(computeTruckPerformance(truck, unloadDuration));
             }
 
             // Compute performance for all unloading stations
-            for (const Station& station : m_UnloadingStationProcessor.m_UnloadingStationsList) {
-                StationPerformanceStats station_stats{computeStationPerformance(station, unloadDuration)};
-                m_UnloadingStationsPerformance.push_back(station_stats);
+            const vector<Station>& unloadingStationsList{m_UnloadingStationProcessor.m_UnloadingStationsList};
+            m_UnloadingStationsPerformance.clear();
+            m_UnloadingStationsPerformance.reserve(unloadingStationsList.size());
+            for (const Station& station : unloadingStationsList) {
+                m_UnloadingStationsPerformance.push_back(computeStationPerformance(station, unloadDuration));
             }
+            m_PerformanceStatsDirty = false;
         }
 
         /**
         * @brief  Returns vector Mining Truck objects
         */
-        const vector<Truck> getMiningTrucks(){
+        const vector<Truck>& getMiningTrucks(){
             return m_MiningTrucksProcessor.m_MiningTrucksList;
         };
 
+        /**
+        * @brief  Returns a read-only view of the mining trucks, valid until the trucks are replaced by restoreCheckpoint
+        */
+        ArrayView<const Truck> getMiningTrucksView(){
+            return ArrayView<const Truck>(m_MiningTrucksProcessor.m_MiningTrucksList);
+        };
+
         /**
         * @brief  Returns vector Mining Truck Performance objects
         */
-        const vector<TruckPerformanceStats> getMiningTruckPerformances(){
-            if(m_MiningTrucksPerformance.size() == 0){
-                computePerformanceStats();
-            }
+        const vector<TruckPerformanceStats>& getMiningTruckPerformances(){
+            finalizePerformanceStats();
             return m_MiningTrucksPerformance;
         };
 
+        /**
+        * @brief  Returns a read-only view of the mining truck performance statistics, up to date with the last time step run
+        */
+        ArrayView<const TruckPerformanceStats> getMiningTruckPerformancesView(){
+            return ArrayView<const TruckPerformanceStats>(getMiningTruckPerformances());
+        };
+
         /**
         * @brief  Returns vector Unloading Station objects
         */
-        const vector<Station> getUnloadingStations(){
+        const vector<Station>& getUnloadingStations(){
             return m_UnloadingStationProcessor.m_UnloadingStationsList;
         };
 
+        /**
+        * @brief  Returns a read-only view of the unloading stations, valid until the stations are replaced by restoreCheckpoint
+        */
+        ArrayView<const Station> getUnloadingStationsView(){
+            return ArrayView<const Station>(m_UnloadingStationProcessor.m_UnloadingStationsList);
+        };
+
         /**
         * @brief  Returns vector Unloading Station Performance objects
         */
-        const vector<StationPerformanceStats> getUnloadingStationPerformances(){
-            if(m_UnloadingStationsPerformance.size() == 0){
-                computePerformanceStats();
-            }
+        const vector<StationPerformanceStats>& getUnloadingStationPerformances(){
+            finalizePerformanceStats();
             return m_UnloadingStationsPerformance;
         };
 
+        /**
+        * @brief  Returns a read-only view of the unloading station performance statistics, up to date with the last time step run
+        */
+        ArrayView<const StationPerformanceStats> getUnloadingStationPerformancesView(){
+            return ArrayView<const StationPerformanceStats>(getUnloadingStationPerformances());
+        };
+
         /**
         * @brief  Print performance statistics of mining trucks
         */
         void printMiningTruckPerformanceStatistics(){
-            if(m_MiningTrucksPerformance.size() == 0){
-                computePerformanceStats();
-            }
+            finalizePerformanceStats();
 
             cout << "Mining Truck Performance: " << endl;
             for (const TruckPerformanceStats& stats : m_MiningTrucksPerformance) {
@@ -115,9 +563,7 @@ class Simulation{
         * @brief  Print performance statistics of unloading stations
         */
         void printUnloadingStationPerformanceStatistics(){
-            if(m_UnloadingStationsPerformance.size() == 0){
-                computePerformanceStats();
-            }
+            finalizePerformanceStats();
 
             cout << "Unloading Station Performance: " << endl;
             for (const StationPerformanceStats& stats : m_UnloadingStationsPerformance) {
@@ -126,112 +572,246 @@ class Simulation{
         };
 
         /**
-         * @brief Writes truck performance stats to a CSV file.
+         * @brief Writes truck performance stats to a CSV file. Returns the name of the file, or an empty string if it could not be written.
          * @param fileName Base name of the file to save.
+         * @param resultsDir Name of the results directory to save file in.
          */
-        void writeTruckPerformanceToCSV(const string& fileName, const string& resultsDir) {
+        string writeTruckPerformanceToCSV(const string& fileName, const string& resultsDir) {
             // Compute performance if not done already
-            if(m_MiningTrucksPerformance.size() == 0){
-                computePerformanceStats();
-            }
+            finalizePerformanceStats();
 
             // Check that results directory exists
-            if (!filesystem::exists(resultsDir)) {
-                if (!filesystem::create_directory(resultsDir)) {
-                    error("Error: Could not create directory {}", resultsDir);
-                    return;
-                }
+            if (!createResultsDirectory(resultsDir)) {
+                return "";
             }
 
             // Append date and time to fileName
-            string dateTime = getCurrentDateTime();
-            string fullFileName = resultsDir + fileName + "_" + dateTime + ".csv";
+            string fullFileName = getUniqueResultFileName(resultsDir, fileName, ".csv");
 
             // Open file in write mode
-            ofstream outFile(fullFileName);
-            if (!outFile) {
+            CsvWriter csvWriter(fullFileName);
+            if (!csvWriter.good()) {
                 error("Error: Could not open file {} for writing.", fullFileName);
-                return;
+                return "";
             }
 
             // Write CSV header
-            outFile << "Vehicle ID,Percent Mining Time,Percent Travel Time,Percent Unloading Time,Percent Idle Time,Total Mining Time (hrs),Total Unloads\n";
+            csvWriter.write("Vehicle ID,Percent Mining Time,Percent Travel Time,Percent Unloading Time,Percent Idle Time,Total Mining Time (hrs),Total Unloads").endRow();
 
             // Write data to csv file
             for (const TruckPerformanceStats& stats : m_MiningTrucksPerformance) {
-                outFile << stats.vehicleId << ","
-                        << fixed << setprecision(2)
-                        << stats.percentMiningTime << ","
-                        << stats.percentTravelTime << ","
-                        << stats.percentUnloadingTime << ","
-                        << stats.percentIdleTime << ","
-                        << stats.totalMiningTime_hrs << ","
-                        << stats.totalUnloads << "\n";
+                csvWriter.write(stats.vehicleId)
+                        .write(stats.percentMiningTime, 2)
+                        .write(stats.percentTravelTime, 2)
+                        .write(stats.percentUnloadingTime, 2)
+                        .write(stats.percentIdleTime, 2)
+                        .write(stats.totalMiningTime_hrs, 2)
+                        .write(stats.totalUnloads, 2).endRow();
+            }
+            if (!csvWriter.close()) {
+                error("Error: Could not write file {}", fullFileName);
+                return "";
             }
             info("Mining Truck Performance stats written to file: {}", fullFileName);
+            return fullFileName;
         }
 
         /**
-         * @brief Writes station performance stats to a CSV file.
+         * @brief Writes station performance stats to a CSV file. Returns the name of the file, or an empty string if it could not be written.
          * @param fileName Base name of the file to save.
          * @param resultsDir Name of the results directory to save file in.
          */
-        void writeStationPerformanceToCSV(const string& fileName, const string& resultsDir) {
+        string writeStationPerformanceToCSV(const string& fileName, const string& resultsDir) {
             // Compute performance if not done already
-            if(m_UnloadingStationsPerformance.size() == 0){
-                computePerformanceStats();
-            }
+            finalizePerformanceStats();
 
             // Check that results directory exists
-            if (!filesystem::exists(resultsDir)) {
-                if (!filesystem::create_directory(resultsDir)) {
-                    error("Error: Could not create directory {}", resultsDir);
-                    return;
-                }
+            if (!createResultsDirectory(resultsDir)) {
+                return "";
             }
 
             // Append date and time to fileName
-            string dateTime = getCurrentDateTime();
-            string fullFileName = resultsDir + fileName + "_" + dateTime + ".csv";
+            string fullFileName = getUniqueResultFileName(resultsDir, fileName, ".csv");
 
             // Open file in write mode
-            ofstream outFile(fullFileName);
-            if (!outFile) {
+            CsvWriter csvWriter(fullFileName);
+            if (!csvWriter.good()) {
                 error("Error: Could not open file {} for writing.", fullFileName);
-                return;
+                return "";
             }
 
             // Write CSV header
-            outFile << "Station ID,Percent Unloading Time,Percent Idle Time,Total Idle Time (hrs),Total Unloading Time (hrs),Total Unloads\n";
+            csvWriter.write("Station ID,Percent Unloading Time,Percent Idle Time,Total Idle Time (hrs),Total Unloading Time (hrs),Total Unloads").endRow();
 
             // Write data to csv file
             for (const StationPerformanceStats& stats : m_UnloadingStationsPerformance) {
-                outFile << stats.stationId << ","
-                        << fixed << setprecision(2)
-                        << stats.percentUnloadingTime << ","
-                        << stats.percentIdleTime << ","
-                        << stats.totalIdleTime_hrs << ","
-                        << stats.totalUnloadingTime_hrs << ","
-                        << stats.totalUnloads << "\n";
+                csvWriter.write(stats.stationId)
+                        .write(stats.percentUnloadingTime, 2)
+                        .write(stats.percentIdleTime, 2)
+                        .write(stats.totalIdleTime_hrs, 2)
+                        .write(stats.totalUnloadingTime_hrs, 2)
+                        .write(stats.totalUnloads, 2).endRow();
+            }
+            if (!csvWriter.close()) {
+                error("Error: Could not write file {}", fullFileName);
+                return "";
+            }
+            info("Unloading Station Performance stats written to file: {}", fullFileName);
+            return fullFileName;
+        }
+
+        /**
+         * @brief Writes truck performance stats to a binary columnar file with the same columns as the CSV file (see ResultWriter.h).
+         *        Returns the name of the file, or an empty string if it could not be written.
+         * @param fileName Base name of the file to save.
+         * @param resultsDir Name of the results directory to save file in.
+         */
+        string writeTruckPerformanceToColumns(const string& fileName, const string& resultsDir) {
+            // Compute performance if not done already
+            finalizePerformanceStats();
+
+            // Check that results directory exists
+            if (!createResultsDirectory(resultsDir)) {
+                return "";
+            }
+
+            // Gather columns
+            const size_t numTrucks{m_MiningTrucksPerformance.size()};
+            vector<int32_t> vehicleIds(numTrucks);
+            vector<float> percentMiningTime(numTrucks), percentTravelTime(numTrucks), percentUnloadingTime(numTrucks), percentIdleTime(numTrucks),
+                            totalMiningTime(numTrucks), totalUnloads(numTrucks);
+            for (size_t i = 0; i < numTrucks; i++) {
+                const TruckPerformanceStats& stats{m_MiningTrucksPerformance[i]};
+                vehicleIds[i] = stats.vehicleId;
+                percentMiningTime[i] = stats.percentMiningTime;
+                percentTravelTime[i] = stats.percentTravelTime;
+                percentUnloadingTime[i] = stats.percentUnloadingTime;
+                percentIdleTime[i] = stats.percentIdleTime;
+                totalMiningTime[i] = stats.totalMiningTime_hrs;
+                totalUnloads[i] = stats.totalUnloads;
+            }
+            ColumnarWriter columnarWriter(numTrucks);
+            columnarWriter.addColumn("Vehicle ID", vehicleIds);
+            columnarWriter.addColumn("Percent Mining Time", percentMiningTime);
+            columnarWriter.addColumn("Percent Travel Time", percentTravelTime);
+            columnarWriter.addColumn("Percent Unloading Time", percentUnloadingTime);
+            columnarWriter.addColumn("Percent Idle Time", percentIdleTime);
+            columnarWriter.addColumn("Total Mining Time (hrs)", totalMiningTime);
+            columnarWriter.addColumn("Total Unloads", totalUnloads);
+
+            // Write file
+            string fullFileName = getUniqueResultFileName(resultsDir, fileName, ".mscols");
+            if (!columnarWriter.write(fullFileName)) {
+                error("Error: Could not write file {}", fullFileName);
+                return "";
+            }
+            info("Mining Truck Performance stats written to file: {}", fullFileName);
+            return fullFileName;
+        }
+
+        /**
+         * @brief Writes station performance stats to a binary columnar file with the same columns as the CSV file (see ResultWriter.h).
+         *        Returns the name of the file, or an empty string if it could not be written.
+         * @param fileName Base name of the file to save.
+         * @param resultsDir Name of the results directory to save file in.
+         */
+        string writeStationPerformanceToColumns(const string& fileName, const string& resultsDir) {
+            // Compute performance if not done already
+            finalizePerformanceStats();
+
+            // Check that results directory exists
+            if (!createResultsDirectory(resultsDir)) {
+                return "";
+            }
+
+            // Gather columns
+            const size_t numStations{m_UnloadingStationsPerformance.size()};
+            vector<int32_t> stationIds(numStations);
+            vector<float> percentUnloadingTime(numStations), percentIdleTime(numStations), totalIdleTime(numStations), totalUnloadingTime(numStations),
+                            totalUnloads(numStations);
+            for (size_t i = 0; i < numStations; i++) {
+                const StationPerformanceStats& stats{m_UnloadingStationsPerformance[i]};
+                stationIds[i] = stats.stationId;
+                percentUnloadingTime[i] = stats.percentUnloadingTime;
+                percentIdleTime[i] = stats.percentIdleTime;
+                totalIdleTime[i] = stats.totalIdleTime_hrs;
+                totalUnloadingTime[i] = stats.totalUnloadingTime_hrs;
+                totalUnloads[i] = stats.totalUnloads;
+            }
+            ColumnarWriter columnarWriter(numStations);
+            columnarWriter.addColumn("Station ID", stationIds);
+            columnarWriter.addColumn("Percent Unloading Time", percentUnloadingTime);
+            columnarWriter.addColumn("Percent Idle Time", percentIdleTime);
+            columnarWriter.addColumn("Total Idle Time (hrs)", totalIdleTime);
+            columnarWriter.addColumn("Total Unloading Time (hrs)", totalUnloadingTime);
+            columnarWriter.addColumn("Total Unloads", totalUnloads);
+
+            // Write file
+            string fullFileName = getUniqueResultFileName(resultsDir, fileName, ".mscols");
+            if (!columnarWriter.write(fullFileName)) {
+                error("Error: Could not write file {}", fullFileName);
+                return "";
             }
             info("Unloading Station Performance stats written to file: {}", fullFileName);
+            return fullFileName;
+        }
+
+        /**
+         * @brief Creates the results directory if it does not exist. Returns false if it could not be created.
+         * @param resultsDir Name of the results directory.
+         */
+        static bool createResultsDirectory(const string& resultsDir) {
+            if (!filesystem::exists(resultsDir)) {
+                if (!filesystem::create_directory(resultsDir)) {
+                    error("Error: Could not create directory {}", resultsDir);
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Get current date and time as a string in "YYYY-MM-DD_HH-MM-SS" format.
+         */
+        static std::string getCurrentDateTime() {
+            time_t now = time(0);
+            tm* localTime = localtime(&now);
+
+            char buffer[20];
+            strftime(buffer, sizeof(buffer), "%Y-%m-%d_%H-%M-%S", localTime);
+            return std::string(buffer);
         }
         
     private:
         /**
-        * @brief  The full duration of the simulation (minutes)
+        * @brief  The full duration of the simulation (ticks)
+        */
+        const SimulationTicks m_SimulationTime;
+
+        /**
+        * @brief  Length of a single timestep of the simulation (ticks), at least one tick
+        */
+        const SimulationTicks m_SimulationTimestep;
+
+        /**
+        * @brief  Tracks the current elapsed time of the simulation (ticks)
+        */
+        SimulationTicks m_CurrentSimulationTime;
+
+        /**
+        * @brief  Engine used to run the simulation
         */
-        const double m_SimulationTime;
+        SimulationEngines m_SimulationEngine;
 
         /**
-        * @brief  Length of a single timestep of the simulation (minutes)
+        * @brief  Seed of the random number generator
         */
-        const double m_SimulationTimestep;
+        uint64_t m_Seed;
 
         /**
-        * @brief  Tracks the current elapsed time of the simulation (minutes)
+        * @brief  Index of the replication of the seed
         */
-        double m_CurrentSimulationTime;
+        uint32_t m_Replication;
 
         /**
         * @brief  Processor that manages mining trucks
@@ -253,16 +833,441 @@ class Simulation{
         */
         vector<StationPerformanceStats> m_UnloadingStationsPerformance;
 
+        /**
+        * @brief  True if trucks or stations changed since the performance statistics were computed
+        */
+        bool m_PerformanceStatsDirty;
+
+        /**
+        * @brief  File events are traced to, empty if not tracing
+        */
+        string m_EventTraceFileName;
+
+        /**
+        * @brief  Event trace of the current run, nullptr if not tracing
+        */
+        EventTraceWriter* m_EventTrace;
+
+        /**
+        * @brief  Phase and time step metrics of every run, only updated when compiled with ENABLE_RUNTIME_METRICS
+        */
+        RuntimeMetrics m_RuntimeMetrics;
+
+        /**
+        * @brief  Number of truck state changes at the end of the last time step, used to count state changes per time step
+        */
+        uint64_t m_NumTruckStateChanges;
+
+        /**
+        * @brief  Time series of truck state counts and station queues, disabled unless enableTimeSeries was called
+        */
+        TimeSeriesRecorder m_TimeSeriesRecorder;
+
+        /**
+        * @brief  Live metrics time steps are published to, nullptr if not publishing
+        */
+        LiveMetrics* m_LiveMetrics;
+
+        /**
+        * @brief  Simulation time up to which time steps were published to the live metrics (ticks)
+        */
+        SimulationTicks m_LiveMetricsTime;
+
+        /**
+        * @brief  Number of truck state changes at the last time step published to the live metrics
+        */
+        uint64_t m_LiveMetricsStateChanges;
+
+        /**
+        * @brief  Starts publishing to the live metrics from the current simulation time
+        */
+        void resetLiveMetrics(){
+            m_LiveMetricsTime = m_CurrentSimulationTime;
+            m_LiveMetricsStateChanges = m_MiningTrucksProcessor.getTruckCounters().numStateChanges;
+        };
+
+        /**
+        * @brief  Publishes a time step starting at simulationTime to the live metrics, with a snapshot of the trucks and stations if
+        *         one is requested. Costs one branch per time step when not publishing
+        */
+        template<typename TruckList>
+        void publishLiveMetrics(const SimulationTicks simulationTime, const TruckList& miningTrucksList){
+            if(m_LiveMetrics == nullptr){
+                return;
+            }
+
+            // Time steps skipped by the discrete-event and adaptive-step engines are included in the simulated ticks
+            const SimulationTicks endTime{simulationTime + m_SimulationTimestep};
+            const uint64_t numStateChanges{m_MiningTrucksProcessor.getTruckCounters().numStateChanges};
+            m_LiveMetrics->publishTimestep(simulationTime, max<SimulationTicks>(endTime - m_LiveMetricsTime, 0), numStateChanges - m_LiveMetricsStateChanges);
+            m_LiveMetricsTime = endTime;
+            m_LiveMetricsStateChanges = numStateChanges;
+            if(m_LiveMetrics->isSnapshotRequested()){
+                m_LiveMetrics->publishSnapshot(m_UnloadingStationProcessor.m_UnloadingStationsList, miningTrucksList);
+            }
+        };
+
+        /**
+        * @brief  Counts a processed time step and its truck state changes
+        */
+        void recordTimestepMetrics(){
+            const uint64_t numTruckStateChanges{m_MiningTrucksProcessor.getTruckCounters().numStateChanges};
+            m_RuntimeMetrics.maxTruckStateChangesPerTimestep = max(m_RuntimeMetrics.maxTruckStateChangesPerTimestep, numTruckStateChanges - m_NumTruckStateChanges);
+            m_NumTruckStateChanges = numTruckStateChanges;
+            m_RuntimeMetrics.numTimesteps++;
+        };
+
+        /**
+        * @brief  Simulates the time step starting at simulationTime, shared by every engine: updates the stations, then the trucks, then
+        *         assigns the newly loaded trucks to stations, timing each phase, and records the time step to the runtime metrics, time
+        *         series and live metrics
+        * @param miningTrucksList Trucks sampled by the time series and live metrics, the list of trucks or the struct-of-arrays fleet
+        * @param updateStations Updates the unloading stations
+        * @param updateTrucks Updates the trucks and collects the newly loaded ones
+        * @param assignTrucks Assigns the newly loaded trucks to stations
+        */
+        template<typename TruckList, typename UpdateStations, typename UpdateTrucks, typename AssignTrucks>
+        void simulateTimestep(const SimulationTicks simulationTime, const TruckList& miningTrucksList, UpdateStations&& updateStations,
+                              UpdateTrucks&& updateTrucks, AssignTrucks&& assignTrucks){
+            // Simulate step : update stations --> Update vehicles --> Assign vehicles to stations if applicable
+            RUNTIME_METRICS(PhaseClock phaseClock{};)
+            updateStations();
+            RUNTIME_METRICS(phaseClock.lap(m_RuntimeMetrics.stationUpdate);)
+            updateTrucks();
+            RUNTIME_METRICS(phaseClock.lap(m_RuntimeMetrics.truckUpdate);)
+            assignTrucks();
+            RUNTIME_METRICS(phaseClock.lap(m_RuntimeMetrics.assignment);)
+            RUNTIME_METRICS(recordTimestepMetrics();)
+            if(m_TimeSeriesRecorder.isEnabled()){
+                m_TimeSeriesRecorder.record(simulationTime, m_UnloadingStationProcessor.m_UnloadingStationsList, miningTrucksList);
+            }
+            publishLiveMetrics(simulationTime, miningTrucksList);
+        };
+
+        /**
+        * @brief  Runs the simulation by advancing every truck and station one time step at a time
+        */
+        void runFixedStep(){
+            uint32_t timestep{0};
+            while(m_CurrentSimulationTime <= m_SimulationTime){
+                if(m_EventTrace != nullptr){
+                    m_EventTrace->setTimestep(timestep++);
+                }
+                step();
+            }
+        };
+
+        /**
+        * @brief  Runs the simulation one time step at a time using the struct-of-arrays truck fleet
+        */
+        void runStructOfArrays(){
+            // Copy trucks into struct-of-arrays fleet for the duration of the run
+            m_MiningTrucksProcessor.loadTruckFleet();
+            MiningTruckFleet& miningTruckFleet{m_MiningTrucksProcessor.m_MiningTruckFleet};
+
+            uint32_t timestep{0};
+            while(m_CurrentSimulationTime <= m_SimulationTime){
+                if(m_EventTrace != nullptr){
+                    m_EventTrace->setTimestep(timestep++);
+                }
+                simulateTimestep(m_CurrentSimulationTime, miningTruckFleet,
+                    [&](){ m_UnloadingStationProcessor.updateUnloadingStations(m_SimulationTimestep, miningTruckFleet); },
+                    [&](){ m_MiningTrucksProcessor.updateMiningTruckFleet(m_SimulationTimestep); },
+                    [&](){ m_UnloadingStationProcessor.assignVehiclesToStations(miningTruckFleet, m_MiningTrucksProcessor.getLoadedTrucks()); });
+
+                // Increment simulation time
+                m_CurrentSimulationTime += m_SimulationTimestep;
+            }
+
+            // Copy fleet back into list of trucks
+            m_MiningTrucksProcessor.storeTruckFleet();
+        };
+
+        /**
+        * @brief  Runs the simulation as runStructOfArrays, but while every station is idle jumps over the time steps before the first
+        *         truck state change, counting the trucks down for all of them at once. Produces the same truck and station results as
+        *         runFixedStep. The time steps until the next state change are reduced inside the countdown pass of every executed time
+        *         step, with no separate rescan. That pass only skips time steps for sparse fleets: a year of one to ten trucks with 12 to
+        *         48 hour mining cycles runs 50 to 3 times faster than runStructOfArrays, while from about 100 trucks some truck changes
+        *         state almost every time step and the extra minimum in the countdown pass makes it slightly slower
+        */
+        void runAdaptiveStep(){
+            // Copy trucks into struct-of-arrays fleet for the duration of the run
+            m_MiningTrucksProcessor.loadTruckFleet();
+            MiningTruckFleet& miningTruckFleet{m_MiningTrucksProcessor.m_MiningTruckFleet};
+
+            // Count the time steps remaining in the simulation
+            SimulationTicks endSimulationTime{m_CurrentSimulationTime};
+            const long numTimesteps{countRemainingTimesteps(endSimulationTime)};
+
+            long timestep{0};
+            long numStepTimesteps{1};
+            while(timestep < numTimesteps){
+                // Run the skipped time steps together with the time step of the next state change
+                m_CurrentSimulationTime += (numStepTimesteps - 1) * m_SimulationTimestep;
+                timestep += numStepTimesteps - 1;
+                if(m_EventTrace != nullptr){
+                    m_EventTrace->setTimestep(timestep);
+                }
+
+                simulateTimestep(m_CurrentSimulationTime, miningTruckFleet,
+                    [&](){ m_UnloadingStationProcessor.updateUnloadingStations(m_SimulationTimestep, miningTruckFleet); },
+                    [&](){ m_MiningTrucksProcessor.updateMiningTruckFleet<true>(m_SimulationTimestep, numStepTimesteps); },
+                    [&](){ m_UnloadingStationProcessor.assignVehiclesToStations(miningTruckFleet, m_MiningTrucksProcessor.getLoadedTrucks()); });
+
+                // Increment simulation time
+                m_CurrentSimulationTime += m_SimulationTimestep;
+                timestep++;
+
+                // Stations with trucks queued or unloading change state every time step, otherwise nothing happens before a truck's
+                // state ends. Stations only become busy when a truck is assigned to one, after a truck state change
+                numStepTimesteps = m_UnloadingStationProcessor.areStationsIdle() 
+                                    ? m_MiningTrucksProcessor.getTimestepsUntilFleetStateChange(m_SimulationTimestep, numTimesteps - timestep) : 1;
+            }
+
+            // Copy fleet back into list of trucks
+            m_MiningTrucksProcessor.storeTruckFleet();
+        };
+
+        /**
+        * @brief  Runs the simulation by jumping between the time steps in which trucks and stations change state.
+        *         Produces the same truck and station results as runFixedStep
+        */
+        void runDiscreteEvent(){
+            vector<Truck>& miningTrucksList{m_MiningTrucksProcessor.m_MiningTrucksList};
+            vector<Station>& unloadingStationsList{m_UnloadingStationProcessor.m_UnloadingStationsList};
+
+            // Count the time steps remaining in the simulation
+            SimulationTicks endSimulationTime{m_CurrentSimulationTime};
+            const long lastTimestep{countRemainingTimesteps(endSimulationTime) - 1};
+
+            // Schedule the next state change of every truck and the next update of every busy station
+            SimulationEventQueue events{};
+            vector<bool> stationUpdateScheduled(unloadingStationsList.size(), false);
+            for(Truck& truck : miningTrucksList){
+                scheduleTruckStateChange(truck, 0, lastTimestep, events);
+            }
+            for(const Station& station : unloadingStationsList){
+                if(station.state == UnloadingStationStates::OCCUPIED || !station.vehicleIdQueue.empty()){
+                    scheduleStationUpdate(station.id, 0, lastTimestep, events, stationUpdateScheduled);
+                }
+            }
+
+            // Process events one time step at a time
+            vector<int> loadedTrucksIds{};
+            while(!events.empty()){
+                const long timestep{events.top().timestep};
+                loadedTrucksIds.clear();
+                if(m_EventTrace != nullptr){
+                    m_EventTrace->setTimestep(timestep);
+                }
+
+                // Station updates of a time step are ordered before its truck state changes, so each phase is one run of events
+                simulateTimestep(m_CurrentSimulationTime + timestep * m_SimulationTimestep, miningTrucksList,
+                    [&](){
+                        while(!events.empty() && events.top().timestep == timestep && events.top().type == SimulationEventTypes::STATION_UPDATE){
+                            Station& station{unloadingStationsList[events.top().entityId]};
+                            events.pop();
+                            stationUpdateScheduled[station.id] = false;
+                            const int unloadedVehicleId{m_UnloadingStationProcessor.updateUnloadingStation(station, miningTrucksList)};
+
+                            // Unloaded truck starts its unload countdown in this time step
+                            if(unloadedVehicleId != -1){
+                                scheduleTruckStateChange(miningTrucksList[unloadedVehicleId], timestep, lastTimestep, events);
+                            }
+
+                            // Busy stations are updated again in the next time step
+                            if(station.state == UnloadingStationStates::OCCUPIED || !station.vehicleIdQueue.empty()){
+                                scheduleStationUpdate(station.id, timestep + 1, lastTimestep, events, stationUpdateScheduled);
+                            }
+                        }
+                    },
+                    [&](){
+                        while(!events.empty() && events.top().timestep == timestep){
+                            Truck& truck{miningTrucksList[events.top().entityId]};
+                            events.pop();
+                            if(m_MiningTrucksProcessor.changeTruckState(truck)){
+                                loadedTrucksIds.push_back(truck.id);
+                            }
+                            else{
+                                scheduleTruckStateChange(truck, timestep + 1, lastTimestep, events);
+                            }
+                        }
+                    },
+                    [&](){
+                        // Assign newly loaded trucks (in truck id order) and update their stations in the next time step
+                        for(int idx : loadedTrucksIds){
+                            const int stationIdx{m_UnloadingStationProcessor.assignVehicleToStation(miningTrucksList[idx])};
+                            if(stationIdx != -1){
+                                scheduleStationUpdate(stationIdx, timestep + 1, lastTimestep, events, stationUpdateScheduled);
+                            }
+                        }
+                    });
+            }
+
+            // Set simulation time to the end of the last time step
+            m_CurrentSimulationTime = endSimulationTime;
+        };
+
+        /**
+        * @brief  Runs the simulation one time step at a time, keeping every counting truck in a timing wheel under the time step its
+        *         current state ends in. Each time step updates the stations and changes the state of the trucks filed under it, in truck
+        *         id order, and leaves every other truck untouched. A truck's countdown and cycle counts are brought up to date from the
+        *         time steps elapsed in its state when its state ends, or at the end of the simulation. Produces the same results as runFixedStep
+        */
+        void runTimingWheel(){
+            vector<Truck>& miningTrucksList{m_MiningTrucksProcessor.m_MiningTrucksList};
+            vector<Station>& unloadingStationsList{m_UnloadingStationProcessor.m_UnloadingStationsList};
+
+            // Count the time steps remaining in the simulation
+            SimulationTicks endSimulationTime{m_CurrentSimulationTime};
+            const long numTimesteps{countRemainingTimesteps(endSimulationTime)};
+
+            // File every counting truck under the time step its current state ends in
+            TimingWheel timingWheel{};
+            vector<long> stateStartTimesteps(miningTrucksList.size(), NOT_COUNTING);
+            for(Truck& truck : miningTrucksList){
+                fileTruckStateChange(truck, 0, numTimesteps, timingWheel, stateStartTimesteps);
+            }
+
+            vector<int> expiredTrucksIds{};
+            vector<int> loadedTrucksIds{};
+            for(long timestep = 0; timestep < numTimesteps; timestep++){
+                if(m_EventTrace != nullptr){
+                    m_EventTrace->setTimestep(timestep);
+                }
+
+                simulateTimestep(m_CurrentSimulationTime, miningTrucksList,
+                    [&](){
+                        for(Station& station : unloadingStationsList){
+                            // Unloaded truck starts its unload countdown in this time step
+                            const int unloadedVehicleId{m_UnloadingStationProcessor.updateUnloadingStation(station, miningTrucksList)};
+                            if(unloadedVehicleId != -1){
+                                fileTruckStateChange(miningTrucksList[unloadedVehicleId], timestep, numTimesteps, timingWheel, stateStartTimesteps);
+                            }
+                        }
+                    },
+                    [&](){
+                        // Change the state of the trucks whose state ends in this time step, in truck id order
+                        expiredTrucksIds.clear();
+                        loadedTrucksIds.clear();
+                        timingWheel.collectCurrent(expiredTrucksIds);
+                        sort(expiredTrucksIds.begin(), expiredTrucksIds.end());
+                        for(int idx : expiredTrucksIds){
+                            Truck& truck{miningTrucksList[idx]};
+                            countDownTruck(truck, timestep + 1, stateStartTimesteps);
+                            if(m_MiningTrucksProcessor.changeTruckState(truck)){
+                                loadedTrucksIds.push_back(truck.id);
+                            }
+                            else{
+                                fileTruckStateChange(truck, timestep + 1, numTimesteps, timingWheel, stateStartTimesteps);
+                            }
+                        }
+                    },
+                    [&](){ m_UnloadingStationProcessor.assignVehiclesToStations(miningTrucksList, loadedTrucksIds); });
+
+                // Increment simulation time
+                m_CurrentSimulationTime += m_SimulationTimestep;
+                timingWheel.advance();
+            }
+
+            // Count down the trucks still in their state at the end of the simulation
+            for(Truck& truck : miningTrucksList){
+                countDownTruck(truck, numTimesteps, stateStartTimesteps);
+            }
+        };
+
+        /**
+        * @brief  Marks a truck that is not counting down in runTimingWheel (loaded truck awaiting unload at a station)
+        */
+        static constexpr long NOT_COUNTING{-1};
+
+        /**
+        * @brief  Starts the countdown of a truck's current state in firstTimestep and files the truck under the time step the state ends
+        *         in, if within the simulation. Loaded trucks in unload state wait for their station and are not filed
+        */
+        void fileTruckStateChange(const Truck& truck, const long firstTimestep, const long numTimesteps, TimingWheel& timingWheel, 
+                                    vector<long>& stateStartTimesteps){
+            if(!MiningTrucksProcessor::isTruckCounting(truck)){
+                stateStartTimesteps[truck.id] = NOT_COUNTING;
+                return;
+            }
+            stateStartTimesteps[truck.id] = firstTimestep;
+            const long numCycles{MiningTrucksProcessor::getNumCyclesUntilStateChange(truck, m_SimulationTimestep, numTimesteps - firstTimestep)};
+            if(numCycles > 0){
+                timingWheel.insert(truck.id, firstTimestep + numCycles - 1);
+            }
+        };
+
+        /**
+        * @brief  Runs the time steps a counting truck has spent in its current state before endTimestep, updating its countdown and cycle counts
+        */
+        void countDownTruck(Truck& truck, const long endTimestep, vector<long>& stateStartTimesteps){
+            if(stateStartTimesteps[truck.id] == NOT_COUNTING){
+                return;
+            }
+            long numCycles{0};
+            m_MiningTrucksProcessor.runTruckCycles(truck, m_SimulationTimestep, endTimestep - stateStartTimesteps[truck.id], numCycles);
+            stateStartTimesteps[truck.id] = NOT_COUNTING;
+        };
+
+        /**
+        * @brief  Counts the time steps remaining in the simulation and advances endSimulationTime to the end of the last of them
+        */
+        long countRemainingTimesteps(SimulationTicks& endSimulationTime){
+            // Time steps start at every multiple of the timestep from the current time up to and including the simulation time
+            const long numTimesteps{endSimulationTime <= m_SimulationTime ? static_cast<long>((m_SimulationTime - endSimulationTime) / m_SimulationTimestep) + 1 : 0};
+            endSimulationTime += numTimesteps * m_SimulationTimestep;
+            return numTimesteps;
+        };
+
+        /**
+        * @brief  Runs a truck's current state forward from firstTimestep and schedules its state change, if within the simulation
+        */
+        void scheduleTruckStateChange(Truck& truck, const long firstTimestep, const long lastTimestep, SimulationEventQueue& events){
+            // Loaded trucks in unload state wait for their station
+            if(!MiningTrucksProcessor::isTruckCounting(truck)){
+                return;
+            }
+
+            long numCycles{0};
+            if(m_MiningTrucksProcessor.runTruckCycles(truck, m_SimulationTimestep, lastTimestep - firstTimestep + 1, numCycles)){
+                events.push(SimulationEvent(firstTimestep + numCycles - 1, SimulationEventTypes::TRUCK_STATE_CHANGE, truck.id));
+            }
+        };
+
+        /**
+        * @brief  Schedules an update of a station in a time step, if within the simulation and not already scheduled
+        */
+        void scheduleStationUpdate(const int stationIdx, const long timestep, const long lastTimestep, SimulationEventQueue& events, 
+                                    vector<bool>& stationUpdateScheduled){
+            if(timestep > lastTimestep || stationUpdateScheduled[stationIdx]){
+                return;
+            }
+            events.push(SimulationEvent(timestep, SimulationEventTypes::STATION_UPDATE, stationIdx));
+            stationUpdateScheduled[stationIdx] = true;
+        };
+
+        /**
+        * @brief  Computes the performance statistics if trucks or stations changed since they were last computed
+        */
+        void finalizePerformanceStats(){
+            if(m_PerformanceStatsDirty){
+                computePerformanceStats();
+            }
+        };
+
         /**
         * @brief  Computes and returns the performance statistics of a truck
         */
-        TruckPerformanceStats computeTruckPerformance(const Truck& truck, const float& unloadDuration_min){
+        TruckPerformanceStats computeTruckPerformance(const Truck& truck, const int unloadDuration){
+            const double simulationTime{static_cast<double>(m_SimulationTime)};
             TruckPerformanceStats stats(truck.id);
-            stats.percentMiningTime = (truck.numMiningCycles * m_SimulationTimestep/ m_SimulationTime) * 100;
-            stats.percentTravelTime = (truck.numTravelCycles * m_SimulationTimestep/ m_SimulationTime) * 100;
-            stats.percentUnloadingTime = (truck.numUnloads * unloadDuration_min/ m_SimulationTime) * 100;
+            stats.percentMiningTime = (truck.numMiningCycles * m_SimulationTimestep/ simulationTime) * 100;
+            stats.percentTravelTime = (truck.numTravelCycles * m_SimulationTimestep/ simulationTime) * 100;
+            stats.percentUnloadingTime = (static_cast<SimulationTicks>(truck.numUnloads) * unloadDuration/ simulationTime) * 100;
             stats.percentIdleTime = 100.0 - stats.percentMiningTime - stats.percentTravelTime - stats.percentUnloadingTime;
-            stats.totalMiningTime_hrs = (truck.numMiningCycles *  m_SimulationTimestep)/60;
+            stats.totalMiningTime_hrs = ticksToHours(truck.numMiningCycles * m_SimulationTimestep);
             stats.totalUnloads = truck.numUnloads;
             return stats;
         };
@@ -270,12 +1275,12 @@ class Simulation{
         /**
         * @brief  Computes and returns the performance statistics of an unloading station
         */
-        StationPerformanceStats computeStationPerformance(const Station& station, const float& unloadDuration_min){
+        StationPerformanceStats computeStationPerformance(const Station& station, const int unloadDuration){
             StationPerformanceStats stats(station.id);
-            stats.percentUnloadingTime = (station.numVehiclesUnloaded * unloadDuration_min/ m_SimulationTime) * 100;
+            stats.percentUnloadingTime = (static_cast<SimulationTicks>(station.numVehiclesUnloaded) * unloadDuration/ static_cast<double>(m_SimulationTime)) * 100;
             stats.percentIdleTime = 100.0 - stats.percentUnloadingTime;
-            stats.totalUnloadingTime_hrs = (station.numVehiclesUnloaded * unloadDuration_min)/ 60;
-            stats.totalIdleTime_hrs = (m_SimulationTime/60) - stats.totalUnloadingTime_hrs;
+            stats.totalUnloadingTime_hrs = ticksToHours(static_cast<SimulationTicks>(station.numVehiclesUnloaded) * unloadDuration);
+            stats.totalIdleTime_hrs = ticksToHours(m_SimulationTime) - stats.totalUnloadingTime_hrs;
             stats.totalUnloads = station.numVehiclesUnloaded;
             return stats;
         };
@@ -307,18 +1312,6 @@ class Simulation{
                     << std::endl;
                     }
 
-        /**
-         * @brief Get current date and time as a string in "YYYY-MM-DD_HH-MM-SS" format.
-         */
-        std::string getCurrentDateTime() {
-            time_t now = time(0);
-            tm* localTime = localtime(&now);
-
-            char buffer[20];
-            strftime(buffer, sizeof(buffer), "%Y-%m-%d_%H-%M-%S", localTime);
-            return std::string(buffer);
-        }
-
 };
 
 #endif // SIMULATION_H
\ No newline at end of file
@@ -0,0 +1,139 @@
+#ifndef SIMULATION_CHECKPOINT_H
+#define SIMULATION_CHECKPOINT_H
+
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+using namespace std;
+
+/**
+* @brief  Constructs new 'CheckpointHeader' object. Header at the start of a simulation checkpoint file
+*/
+struct CheckpointHeader{
+    char magic[8]{'M', 'S', 'C', 'H', 'K', 'P', 'T', '\0'};    // Identifies the file as a simulation checkpoint
+    uint32_t version{2};                                        // Version of the checkpoint format (2: times in integer ticks)
+    uint32_t reserved{0};                                       // Unused, keeps the header 8-byte aligned
+};
+
+/**
+* @class CheckpointWriter
+* @brief Writes values and arrays of trivially copyable values to a binary checkpoint file
+*/
+class CheckpointWriter{
+    public:
+        /**
+        * @brief  Constructs new 'CheckpointWriter' object, opens the file and writes the checkpoint header
+        */
+        CheckpointWriter(const string& fileName) : m_OutFile(fileName, ios::binary | ios::trunc) {
+            write(CheckpointHeader{});
+        };
+
+        /**
+        * @brief  Writes one value
+        */
+        template<typename T>
+        void write(const T& value){
+            static_assert(is_trivially_copyable<T>::value, "Checkpoint values must be trivially copyable");
+            m_OutFile.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        };
+
+        /**
+        * @brief  Writes the size of an array followed by its values
+        */
+        template<typename T>
+        void writeArray(const vector<T>& values){
+            static_assert(is_trivially_copyable<T>::value, "Checkpoint values must be trivially copyable");
+            write(static_cast<uint64_t>(values.size()));
+            m_OutFile.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+        };
+
+        /**
+        * @brief  Returns true if every write succeeded
+        */
+        bool good(){
+            m_OutFile.flush();
+            return m_OutFile.good();
+        };
+
+    private:
+        /**
+        * @brief  Checkpoint file being written
+        */
+        ofstream m_OutFile;
+};
+
+/**
+* @class CheckpointReader
+* @brief Reads values and arrays written by a CheckpointWriter. Any failed read or invalid header sets the reader to failed
+*/
+class CheckpointReader{
+    public:
+        /**
+        * @brief  Constructs new 'CheckpointReader' object, opens the file and checks the checkpoint header
+        */
+        CheckpointReader(const string& fileName) : m_InFile(fileName, ios::binary), m_Good(false), m_Version(0) {
+            CheckpointHeader header{};
+            const CheckpointHeader expectedHeader{};
+            m_Good = static_cast<bool>(m_InFile);
+            read(header);
+            m_Version = header.version;
+            m_Good = m_Good && memcmp(header.magic, expectedHeader.magic, sizeof(header.magic)) == 0 && header.version == expectedHeader.version;
+        };
+
+        /**
+        * @brief  Reads one value
+        */
+        template<typename T>
+        void read(T& value){
+            static_assert(is_trivially_copyable<T>::value, "Checkpoint values must be trivially copyable");
+            m_Good = m_Good && m_InFile.read(reinterpret_cast<char*>(&value), sizeof(T));
+        };
+
+        /**
+        * @brief  Reads the size of an array followed by its values. Fails if the array has more than maxSize values
+        */
+        template<typename T>
+        void readArray(vector<T>& values, const uint64_t maxSize){
+            static_assert(is_trivially_copyable<T>::value, "Checkpoint values must be trivially copyable");
+            uint64_t size{0};
+            read(size);
+            m_Good = m_Good && size <= maxSize;
+            values.resize(m_Good ? size : 0);
+            m_Good = m_Good && m_InFile.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(T));
+        };
+
+        /**
+        * @brief  Returns true if the header was valid and every read succeeded
+        */
+        bool good(){
+            return m_Good;
+        };
+
+        /**
+        * @brief  Returns the version in the checkpoint header
+        */
+        uint32_t getVersion(){
+            return m_Version;
+        };
+
+    private:
+        /**
+        * @brief  Checkpoint file being read
+        */
+        ifstream m_InFile;
+
+        /**
+        * @brief  True while the header is valid and every read has succeeded
+        */
+        bool m_Good;
+
+        /**
+        * @brief  Version in the checkpoint header
+        */
+        uint32_t m_Version;
+};
+
+#endif // SIMULATION_CHECKPOINT_H
@@ -0,0 +1,47 @@
+#ifndef SIMULATION_EVENT_H
+#define SIMULATION_EVENT_H
+
+#include <queue>
+#include <vector>
+#include <functional>
+
+using namespace std;
+
+ /**
+  * @brief Defines the different types of events in the discrete-event simulation. Events in the same
+  *        time step are processed in this order, matching the fixed-step update order
+  */
+enum SimulationEventTypes {
+    STATION_UPDATE,
+    TRUCK_STATE_CHANGE
+    };
+
+/**
+* @brief  Constructs new 'SimulationEvent' object
+*/
+struct SimulationEvent{
+    long timestep;      // Index of the time step the event occurs in
+    int type;           // Type of event
+    int entityId;       // Id of the truck or station the event applies to
+
+    // Parameterized constructor
+    SimulationEvent(const long timestep, const int type, const int entityId) : timestep(timestep), type(type), entityId(entityId) {}
+
+    // Orders events by time step, then event type, then entity id
+    bool operator>(const SimulationEvent& other) const {
+        if(timestep != other.timestep){
+            return timestep > other.timestep;
+        }
+        if(type != other.type){
+            return type > other.type;
+        }
+        return entityId > other.entityId;
+    }
+};
+
+/**
+* @brief  Time-ordered queue of simulation events, with the earliest event at the top
+*/
+using SimulationEventQueue = priority_queue<SimulationEvent, vector<SimulationEvent>, greater<SimulationEvent>>;
+
+#endif // SIMULATION_EVENT_H
@@ -0,0 +1,297 @@
+#ifndef SIMULATION_LOG_H
+#define SIMULATION_LOG_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "spdlog/spdlog.h"
+#include "spdlog/async.h"
+#include "spdlog/sinks/stdout_color_sinks.h"
+
+using namespace std;
+using namespace spdlog;
+
+/**
+* @brief Lowest level compiled into the simulation core log macros (an SPDLOG_LEVEL_* value). Calls of lower levels expand to
+*        nothing, so their arguments are never evaluated
+*/
+#ifndef SIMULATION_LOG_ACTIVE_LEVEL
+#define SIMULATION_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#endif
+
+/**
+* @struct SimulationLogSite
+* @brief Counters of one log call site. Every site is a function-local static created by the SIMULATION_LOG macros
+*/
+struct SimulationLogSite{
+    /**
+    * @brief  Source file of the call site
+    */
+    const char* fileName;
+
+    /**
+    * @brief  Source line of the call site
+    */
+    int line;
+
+    /**
+    * @brief  Level of the call site
+    */
+    level::level_enum logLevel;
+
+    /**
+    * @brief  Number of times the call site was reached
+    */
+    atomic<uint64_t> numCalls;
+
+    /**
+    * @brief  Number of messages of the call site that were logged
+    */
+    atomic<uint64_t> numLogged;
+
+    /**
+    * @brief  Earliest steady clock time (ns) the next repeated message may be logged
+    */
+    atomic<int64_t> nextLogTime_ns;
+
+    /**
+    * @brief  Constructs new 'SimulationLogSite' object, registering it for the report of suppressed messages
+    */
+    SimulationLogSite(const char* fileName, const int line, const level::level_enum logLevel);
+};
+
+/**
+* @class SimulationLog
+* @brief Logging of the simulation core. Messages go through an spdlog async logger with a bounded queue, so a call never waits
+*        for the console: when the queue is full the oldest message is dropped. Repeated messages of the same call site are
+*        rate limited: the first MAX_BURST are logged, afterwards at most one every REPEAT_INTERVAL, and the rest are only
+*        counted and reported once by reportSuppressed. The limit is per call site, not per message: once one truck has used up
+*        the burst of a call site, the messages of other trucks at that call site are suppressed as well
+*/
+class SimulationLog{
+    public:
+        /**
+        * @brief  Messages of a call site logged before rate limiting starts
+        */
+        static constexpr uint64_t MAX_BURST{5};
+
+        /**
+        * @brief  Shortest time between two logged messages of a rate-limited call site
+        */
+        static constexpr chrono::seconds REPEAT_INTERVAL{10};
+
+        /**
+        * @brief  Most messages waiting in the queue of the async logger
+        */
+        static constexpr size_t QUEUE_SIZE{8192};
+
+        /**
+        * @brief  Logs a message of a call site unless it is rate limited. Formatting only happens for logged messages
+        */
+        template<typename... Args>
+        static void log(SimulationLogSite& site, format_string_t<Args...> format, Args&&... args){
+            const uint64_t numCalls{site.numCalls.fetch_add(1, memory_order_relaxed)};
+            if(numCalls >= MAX_BURST && !takeRepeatSlot(site)){
+                return;
+            }
+            site.numLogged.fetch_add(1, memory_order_relaxed);
+            getLogger()->log(site.logLevel, format, forward<Args>(args)...);
+        };
+
+        /**
+        * @brief  Returns the async logger, creating it and its worker thread on first use
+        */
+        static shared_ptr<logger> getLogger(){
+            State& state{getState()};
+            lock_guard<mutex> lock(state.stateMutex);
+            if(state.asyncLogger == nullptr){
+                if(state.sinks.empty()){
+                    state.sinks.push_back(make_shared<sinks::stdout_color_sink_mt>());
+                }
+                state.threadPool = make_shared<details::thread_pool>(QUEUE_SIZE, 1);
+                state.asyncLogger = make_shared<async_logger>("simulation", state.sinks.begin(), state.sinks.end(), state.threadPool,
+                                                              async_overflow_policy::overrun_oldest);
+                state.asyncLogger->set_level(level::trace);
+            }
+            return state.asyncLogger;
+        };
+
+        /**
+        * @brief  Writes every queued message to the sinks and stops the worker thread, the next message starts a new one. Must
+        *         not be called while simulations are logging
+        */
+        static void flush(){
+            State& state{getState()};
+            lock_guard<mutex> lock(state.stateMutex);
+            flushUnlocked(state);
+        };
+
+        /**
+        * @brief  Replaces the sinks messages are written to, after writing the queued messages to the previous sinks
+        */
+        static void setSinks(const vector<sink_ptr>& sinks){
+            State& state{getState()};
+            lock_guard<mutex> lock(state.stateMutex);
+            flushUnlocked(state);
+            state.sinks = sinks;
+        };
+
+        /**
+        * @brief  Returns the number of messages of all call sites that were rate limited
+        */
+        static uint64_t getNumSuppressed(){
+            State& state{getState()};
+            lock_guard<mutex> lock(state.stateMutex);
+            uint64_t numSuppressed{0};
+            for(const SimulationLogSite* site : state.sites){
+                numSuppressed += site->numCalls.load(memory_order_relaxed) - site->numLogged.load(memory_order_relaxed);
+            }
+            return numSuppressed;
+        };
+
+        /**
+        * @brief  Logs the number of rate-limited messages of every call site, then resets the counters of all call sites
+        */
+        static void reportSuppressed(){
+            State& state{getState()};
+            vector<SimulationLogSite*> sites{};
+            {
+                lock_guard<mutex> lock(state.stateMutex);
+                sites = state.sites;
+            }
+            for(SimulationLogSite* site : sites){
+                const uint64_t numSuppressed{site->numCalls.load(memory_order_relaxed) - site->numLogged.load(memory_order_relaxed)};
+                if(numSuppressed > 0){
+                    getLogger()->log(site->logLevel, "{} messages from {}:{} were suppressed ({} logged)", numSuppressed, site->fileName,
+                                     site->line, site->numLogged.load(memory_order_relaxed));
+                }
+            }
+            flush();
+            reset();
+        };
+
+        /**
+        * @brief  Resets the counters of all call sites
+        */
+        static void reset(){
+            State& state{getState()};
+            lock_guard<mutex> lock(state.stateMutex);
+            for(SimulationLogSite* site : state.sites){
+                site->numCalls.store(0, memory_order_relaxed);
+                site->numLogged.store(0, memory_order_relaxed);
+                site->nextLogTime_ns.store(0, memory_order_relaxed);
+            }
+        };
+
+        /**
+        * @brief  Registers a call site for the report of suppressed messages
+        */
+        static void registerSite(SimulationLogSite& site){
+            State& state{getState()};
+            lock_guard<mutex> lock(state.stateMutex);
+            state.sites.push_back(&site);
+        };
+
+    private:
+        /**
+        * @struct State
+        * @brief Process-wide logger and call sites
+        */
+        struct State{
+            mutex stateMutex;
+            vector<sink_ptr> sinks;
+            shared_ptr<details::thread_pool> threadPool;
+            shared_ptr<logger> asyncLogger;
+            vector<SimulationLogSite*> sites;
+        };
+
+        /**
+        * @brief  Returns the process-wide state
+        */
+        static State& getState(){
+            static State state{};
+            return state;
+        };
+
+        /**
+        * @brief  Writes every queued message by destroying the worker thread, which drains the queue before it stops
+        */
+        static void flushUnlocked(State& state){
+            state.asyncLogger.reset();
+            state.threadPool.reset();
+        };
+
+        /**
+        * @brief  Returns true if a rate-limited call site may log a message now, at most one thread wins each interval
+        */
+        static bool takeRepeatSlot(SimulationLogSite& site){
+            const int64_t now_ns{chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count()};
+            const int64_t interval_ns{chrono::duration_cast<chrono::nanoseconds>(REPEAT_INTERVAL).count()};
+            int64_t nextLogTime_ns{site.nextLogTime_ns.load(memory_order_relaxed)};
+
+            // The first interval starts at the end of the burst
+            if(nextLogTime_ns == 0){
+                site.nextLogTime_ns.compare_exchange_strong(nextLogTime_ns, now_ns + interval_ns, memory_order_relaxed);
+                return false;
+            }
+            if(now_ns < nextLogTime_ns){
+                return false;
+            }
+            return site.nextLogTime_ns.compare_exchange_strong(nextLogTime_ns, now_ns + interval_ns, memory_order_relaxed);
+        };
+};
+
+inline SimulationLogSite::SimulationLogSite(const char* fileName, const int line, const level::level_enum logLevel)
+    : fileName(fileName), line(line), logLevel(logLevel), numCalls(0), numLogged(0), nextLogTime_ns(0) {
+    SimulationLog::registerSite(*this);
+}
+
+/**
+* @brief Logs a rate-limited message of a call site through the simulation core logger
+*/
+#define SIMULATION_LOG(logLevel, ...)                                                          \
+    do{                                                                                        \
+        static SimulationLogSite simulationLogSite{__FILE__, __LINE__, logLevel};             \
+        SimulationLog::log(simulationLogSite, __VA_ARGS__);                                    \
+    } while(0)
+
+#if SIMULATION_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define SIMULATION_LOG_TRACE(...) SIMULATION_LOG(level::trace, __VA_ARGS__)
+#else
+#define SIMULATION_LOG_TRACE(...) (void)0
+#endif
+
+#if SIMULATION_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define SIMULATION_LOG_DEBUG(...) SIMULATION_LOG(level::debug, __VA_ARGS__)
+#else
+#define SIMULATION_LOG_DEBUG(...) (void)0
+#endif
+
+#if SIMULATION_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+#define SIMULATION_LOG_INFO(...) SIMULATION_LOG(level::info, __VA_ARGS__)
+#else
+#define SIMULATION_LOG_INFO(...) (void)0
+#endif
+
+#if SIMULATION_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_WARN
+#define SIMULATION_LOG_WARN(...) SIMULATION_LOG(level::warn, __VA_ARGS__)
+#else
+#define SIMULATION_LOG_WARN(...) (void)0
+#endif
+
+#if SIMULATION_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_ERROR
+#define SIMULATION_LOG_ERROR(...) SIMULATION_LOG(level::err, __VA_ARGS__)
+#else
+#define SIMULATION_LOG_ERROR(...) (void)0
+#endif
+
+#if SIMULATION_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_CRITICAL
+#define SIMULATION_LOG_CRITICAL(...) SIMULATION_LOG(level::critical, __VA_ARGS__)
+#else
+#define SIMULATION_LOG_CRITICAL(...) (void)0
+#endif
+
+#endif // SIMULATION_LOG_H
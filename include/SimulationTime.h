@@ -0,0 +1,62 @@
+#ifndef SIMULATION_TIME_H
+#define SIMULATION_TIME_H
+
+#include <cstdint>
+
+using namespace std;
+
+/**
+* @brief  Simulation time and durations, in whole ticks of one second. Times are only ever added, subtracted and compared as
+*         integers, so they do not drift over long horizons and every engine and build computes bit-identical results
+*/
+using SimulationTicks = int64_t;
+
+/**
+* @brief  Number of ticks in one minute
+*/
+constexpr SimulationTicks TICKS_PER_MINUTE{60};
+
+/**
+* @brief  Number of ticks in one hour
+*/
+constexpr SimulationTicks TICKS_PER_HOUR{60 * TICKS_PER_MINUTE};
+
+/**
+* @brief  Rounds a number of ticks to the nearest whole tick, halfway cases away from zero as llround does, without a library call
+*/
+inline SimulationTicks roundToTicks(const double ticks){
+    const double magnitude{ticks < 0 ? -ticks : ticks};
+    const SimulationTicks whole{static_cast<SimulationTicks>(magnitude)};
+    const SimulationTicks rounded{whole + (magnitude - static_cast<double>(whole) >= 0.5)};
+    return ticks < 0 ? -rounded : rounded;
+}
+
+/**
+* @brief  Converts a duration in minutes to the nearest whole number of ticks
+*/
+inline SimulationTicks minutesToTicks(const double minutes){
+    return roundToTicks(minutes * TICKS_PER_MINUTE);
+}
+
+/**
+* @brief  Converts a duration in hours to the nearest whole number of ticks
+*/
+inline SimulationTicks hoursToTicks(const double hours){
+    return roundToTicks(hours * TICKS_PER_HOUR);
+}
+
+/**
+* @brief  Converts ticks to minutes
+*/
+inline double ticksToMinutes(const SimulationTicks ticks){
+    return static_cast<double>(ticks) / TICKS_PER_MINUTE;
+}
+
+/**
+* @brief  Converts ticks to hours
+*/
+inline double ticksToHours(const SimulationTicks ticks){
+    return static_cast<double>(ticks) / TICKS_PER_HOUR;
+}
+
+#endif // SIMULATION_TIME_H
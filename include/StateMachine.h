@@ -0,0 +1,97 @@
+#ifndef STATE_MACHINE_H
+#define STATE_MACHINE_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+using namespace std;
+
+/**
+* @brief  Returns true if every row of the transition table of a state machine policy holds the state and condition of its position
+*/
+template<typename Policy>
+constexpr bool isTransitionTableOrdered(){
+    for(size_t i = 0; i < Policy::TRANSITIONS.size(); i++){
+        const size_t idx{static_cast<size_t>(Policy::TRANSITIONS[i].state) * Policy::NUM_CONDITIONS + static_cast<size_t>(Policy::TRANSITIONS[i].condition)};
+        if(idx != i){
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+* @class StateMachine
+* @brief Compile-time state machine core. A policy type describes the machine with
+*        - NUM_STATES, the number of states, and NUM_CONDITIONS, the number of values of the condition a transition depends on
+*        - TRANSITIONS, a constexpr array of NUM_STATES * NUM_CONDITIONS rows ordered by state then condition, each row holding the
+*          'state' and 'condition' it applies to followed by whatever durations and actions the machine needs
+*        The table is checked when the machine is instantiated, and finding a row is one index computation, so dispatch inlines to
+*        table loads and rows of states known at compile time fold away
+*/
+template<typename Policy>
+class StateMachine{
+    public:
+        /**
+        * @brief  Row type of the transition table
+        */
+        using Transition = typename decltype(Policy::TRANSITIONS)::value_type;
+
+        /**
+        * @brief  Number of states
+        */
+        static constexpr size_t NUM_STATES{Policy::NUM_STATES};
+
+        /**
+        * @brief  Number of values of the condition a transition depends on
+        */
+        static constexpr size_t NUM_CONDITIONS{Policy::NUM_CONDITIONS};
+
+        /**
+        * @brief  Number of rows of the transition table
+        */
+        static constexpr size_t NUM_TRANSITIONS{NUM_STATES * NUM_CONDITIONS};
+
+        static_assert(Policy::TRANSITIONS.size() == NUM_TRANSITIONS, "Transition table must have one row per state and condition");
+        static_assert(isTransitionTableOrdered<Policy>(), "Transition table rows must be ordered by state then condition");
+
+        /**
+        * @brief  Returns true if state is one of the states of the table, for states read from outside the simulation
+        */
+        static constexpr bool isValidState(const int state){
+            return state >= 0 && static_cast<size_t>(state) < NUM_STATES;
+        };
+
+        /**
+        * @brief  Returns the index of the row of a state and condition
+        */
+        static constexpr size_t getTransitionIdx(const int state, const int condition){
+            return static_cast<size_t>(state) * NUM_CONDITIONS + static_cast<size_t>(condition);
+        };
+
+        /**
+        * @brief  Returns the row of a state and condition
+        */
+        static constexpr const Transition& getTransition(const int state, const int condition){
+            return Policy::TRANSITIONS[getTransitionIdx(state, condition)];
+        };
+
+        /**
+        * @brief  Calls visitor(integral_constant<int, state>{}) for a state only known at run time, so the visitor reads the rows of
+        *         the state as constants. Unrolls into one compare per state, each case inlined
+        */
+        template<typename Visitor, int State = 0>
+        static constexpr decltype(auto) visitState(const int state, Visitor&& visitor){
+            if constexpr(State + 1 < static_cast<int>(NUM_STATES)){
+                if(state != State){
+                    return visitState<Visitor, State + 1>(state, forward<Visitor>(visitor));
+                }
+            }
+            return visitor(integral_constant<int, State>{});
+        };
+};
+
+#endif // STATE_MACHINE_H
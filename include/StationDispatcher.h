@@ -0,0 +1,221 @@
+#ifndef STATION_DISPATCHER_H
+#define STATION_DISPATCHER_H
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+/**
+* @class StationDispatcher
+* @brief Index used to pick the unloading station for a newly loaded truck. Tracks available stations in a bitset
+*        (lowest available id found with find-first-set) and all stations in an indexed min-heap keyed on wait time
+*/
+class StationDispatcher{
+    public:
+        /**
+        * @brief  Constructs new 'StationDispatcher' object with every station available and a wait time of 0
+        */
+        StationDispatcher(const size_t numStations) : m_AvailableStations((numStations + 63) / 64, 0),
+                            m_AvailableWords((m_AvailableStations.size() + 63) / 64, 0), m_WaitTimes(numStations, 0),
+                            m_Heap(numStations), m_HeapPosition(numStations), m_NumAvailable(0) {
+            for(size_t i = 0; i < numStations; i++){
+                m_Heap[i] = static_cast<int>(i);
+                m_HeapPosition[i] = static_cast<int>(i);
+                setAvailable(static_cast<int>(i), true);
+            }
+        };
+
+        /**
+        * @brief  Returns the index of the station to assign the next truck to: the lowest available station id, otherwise
+        *         the station with the shortest wait time (lowest id on ties). Returns -1 if there are no stations
+        */
+        int getNextStationIdx() const {
+            const int availableStationIdx{getFirstAvailableIdx()};
+            if(availableStationIdx != -1){
+                return availableStationIdx;
+            }
+            return m_Heap.empty() ? -1 : m_Heap[0];
+        };
+
+        /**
+        * @brief  Marks a station as available or unavailable
+        */
+        void setAvailable(const int stationIdx, const bool available){
+            const size_t wordIdx{static_cast<size_t>(stationIdx) / 64};
+            const uint64_t bit{uint64_t{1} << (stationIdx % 64)};
+            if(((m_AvailableStations[wordIdx] & bit) != 0) != available){
+                m_NumAvailable += available ? 1 : -1;
+            }
+            if(available){
+                m_AvailableStations[wordIdx] |= bit;
+            }
+            else{
+                m_AvailableStations[wordIdx] &= ~bit;
+            }
+
+            // Keep summary of non-empty words up to date
+            const uint64_t wordBit{uint64_t{1} << (wordIdx % 64)};
+            if(m_AvailableStations[wordIdx] != 0){
+                m_AvailableWords[wordIdx / 64] |= wordBit;
+            }
+            else{
+                m_AvailableWords[wordIdx / 64] &= ~wordBit;
+            }
+        };
+
+        /**
+        * @brief  Marks every station as unavailable
+        */
+        void clearAvailable(){
+            fill(m_AvailableStations.begin(), m_AvailableStations.end(), 0);
+            fill(m_AvailableWords.begin(), m_AvailableWords.end(), 0);
+            m_NumAvailable = 0;
+        };
+
+        /**
+        * @brief  Returns the number of available stations
+        */
+        size_t getNumAvailable() const {
+            return m_NumAvailable;
+        };
+
+        /**
+        * @brief  Returns true if a station is available
+        */
+        bool isAvailable(const int stationIdx) const {
+            return (m_AvailableStations[stationIdx / 64] >> (stationIdx % 64)) & 1;
+        };
+
+        /**
+        * @brief  Updates the wait time of a station in O(log S)
+        */
+        void updateWaitTime(const int stationIdx, const int waitTime){
+            const int previousWaitTime{m_WaitTimes[stationIdx]};
+            m_WaitTimes[stationIdx] = waitTime;
+            if(waitTime < previousWaitTime){
+                siftUp(m_HeapPosition[stationIdx]);
+            }
+            else if(waitTime > previousWaitTime){
+                siftDown(m_HeapPosition[stationIdx]);
+            }
+        };
+
+    private:
+        /**
+        * @brief  Bitset of available stations
+        */
+        vector<uint64_t> m_AvailableStations;
+
+        /**
+        * @brief  Bitset of non-empty words of m_AvailableStations
+        */
+        vector<uint64_t> m_AvailableWords;
+
+        /**
+        * @brief  Wait time of every station (ticks)
+        */
+        vector<int> m_WaitTimes;
+
+        /**
+        * @brief  Min-heap of station indices ordered by wait time, then station id
+        */
+        vector<int> m_Heap;
+
+        /**
+        * @brief  Position of every station in m_Heap
+        */
+        vector<int> m_HeapPosition;
+
+        /**
+        * @brief  Number of available stations
+        */
+        size_t m_NumAvailable;
+
+        /**
+        * @brief  Returns the index of the lowest set bit in a non-zero word
+        */
+        static int findFirstSet(uint64_t word){
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(word);
+#else
+            int idx{0};
+            while((word & 1) == 0){
+                word >>= 1;
+                idx++;
+            }
+            return idx;
+#endif
+        };
+
+        /**
+        * @brief  Returns the lowest available station index, or -1 if no station is available
+        */
+        int getFirstAvailableIdx() const {
+            for(size_t i = 0; i < m_AvailableWords.size(); i++){
+                if(m_AvailableWords[i] != 0){
+                    const size_t wordIdx{i * 64 + findFirstSet(m_AvailableWords[i])};
+                    return static_cast<int>(wordIdx * 64 + findFirstSet(m_AvailableStations[wordIdx]));
+                }
+            }
+            return -1;
+        };
+
+        /**
+        * @brief  Returns true if station a should be ahead of station b in the heap
+        */
+        bool isBefore(const int a, const int b) const {
+            if(m_WaitTimes[a] != m_WaitTimes[b]){
+                return m_WaitTimes[a] < m_WaitTimes[b];
+            }
+            return a < b;
+        };
+
+        /**
+        * @brief  Swaps two heap entries and updates their positions
+        */
+        void swapHeapEntries(const size_t i, const size_t j){
+            swap(m_Heap[i], m_Heap[j]);
+            m_HeapPosition[m_Heap[i]] = i;
+            m_HeapPosition[m_Heap[j]] = j;
+        };
+
+        /**
+        * @brief  Moves a heap entry towards the root until the heap is ordered
+        */
+        void siftUp(size_t pos){
+            while(pos > 0){
+                const size_t parent{(pos - 1) / 2};
+                if(!isBefore(m_Heap[pos], m_Heap[parent])){
+                    break;
+                }
+                swapHeapEntries(pos, parent);
+                pos = parent;
+            }
+        };
+
+        /**
+        * @brief  Moves a heap entry towards the leaves until the heap is ordered
+        */
+        void siftDown(size_t pos){
+            while(true){
+                const size_t left{2 * pos + 1};
+                const size_t right{left + 1};
+                size_t smallest{pos};
+                if(left < m_Heap.size() && isBefore(m_Heap[left], m_Heap[smallest])){
+                    smallest = left;
+                }
+                if(right < m_Heap.size() && isBefore(m_Heap[right], m_Heap[smallest])){
+                    smallest = right;
+                }
+                if(smallest == pos){
+                    break;
+                }
+                swapHeapEntries(pos, smallest);
+                pos = smallest;
+            }
+        };
+};
+
+#endif // STATION_DISPATCHER_H
\ No newline at end of file
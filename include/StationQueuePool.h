@@ -0,0 +1,80 @@
+#ifndef STATION_QUEUE_POOL_H
+#define STATION_QUEUE_POOL_H
+
+#include <UnloadingStation.h>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+/**
+* @class StationQueuePool
+* @brief One contiguous slab of vehicle ids partitioned into a fixed-capacity ring buffer per station queue. A station queue
+*        that outgrows its part of the slab moves to a buffer of its own, so the pool never reallocates while in use
+*/
+class StationQueuePool{
+    public:
+        /**
+        * @brief  Constructs new empty 'StationQueuePool' object
+        */
+        StationQueuePool() : m_Slab(), m_QueueCapacity(0) {};
+
+        /**
+        * @brief  Returns the queue capacity that fits an even share of the fleet plus one, ceil(numMiningTrucks / numUnloadingStations) + 1.
+        *         The dispatcher balances station wait times, so queues rarely grow past it
+        */
+        static size_t getFleetQueueCapacity(const size_t numMiningTrucks, const size_t numUnloadingStations){
+            if(numUnloadingStations == 0){
+                return 0;
+            }
+            return (numMiningTrucks + numUnloadingStations - 1) / numUnloadingStations + 1;
+        };
+
+        /**
+        * @brief  Allocates a new slab and moves the queue of every station into its own part of it, keeping the queued vehicle ids.
+        *         Each part has room for queueCapacity vehicle ids, or the longest queue if longer
+        * @param stations Stations whose queues are pooled
+        * @param queueCapacity Number of vehicle ids each station queue holds before it moves to its own buffer
+        */
+        void attach(vector<Station>& stations, const size_t queueCapacity){
+            size_t capacity{queueCapacity};
+            for(const Station& station : stations){
+                capacity = max(capacity, station.vehicleIdQueue.size());
+            }
+
+            // Queues are copied out of the old slab before it is released
+            vector<int> slab(stations.size() * capacity);
+            for(size_t i = 0; i < stations.size(); i++){
+                stations[i].vehicleIdQueue.attachBuffer(slab.data() + i * capacity, capacity);
+            }
+            m_Slab.swap(slab);
+            m_QueueCapacity = capacity;
+        };
+
+        /**
+        * @brief  Returns the number of vehicle ids each station queue holds in the slab
+        */
+        size_t getQueueCapacity() const {
+            return m_QueueCapacity;
+        };
+
+        /**
+        * @brief  Returns the number of vehicle ids the slab holds
+        */
+        size_t getSlabSize() const {
+            return m_Slab.size();
+        };
+
+    private:
+        /**
+        * @brief  Ring buffers of all station queues, back to back
+        */
+        vector<int> m_Slab;
+
+        /**
+        * @brief  Number of vehicle ids in the ring buffer of each station queue
+        */
+        size_t m_QueueCapacity;
+};
+
+#endif // STATION_QUEUE_POOL_H
@@ -0,0 +1,309 @@
+#ifndef STREAMING_STATISTICS_H
+#define STREAMING_STATISTICS_H
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+using namespace std;
+
+/**
+* @class WelfordAccumulator
+* @brief Running count, mean and variance of a stream of values using Welford's algorithm, numerically stable in one pass
+*/
+class WelfordAccumulator{
+    public:
+        /**
+        * @brief  Constructs new empty 'WelfordAccumulator' object
+        */
+        WelfordAccumulator() : m_Count(0), m_Mean(0), m_SumSquaredDeviations(0) {};
+
+        /**
+        * @brief  Adds a value
+        */
+        void add(const double value){
+            m_Count++;
+            const double deviation{value - m_Mean};
+            m_Mean += deviation / m_Count;
+            m_SumSquaredDeviations += deviation * (value - m_Mean);
+        };
+
+        /**
+        * @brief  Returns the number of values added
+        */
+        uint64_t getCount() const {
+            return m_Count;
+        };
+
+        /**
+        * @brief  Returns the sample mean
+        */
+        double getMean() const {
+            return m_Mean;
+        };
+
+        /**
+        * @brief  Returns the sample variance (n - 1 denominator), 0 with fewer than two values
+        */
+        double getVariance() const {
+            return m_Count > 1 ? m_SumSquaredDeviations / (m_Count - 1) : 0;
+        };
+
+        /**
+        * @brief  Returns the sample standard deviation
+        */
+        double getStdDev() const {
+            return sqrt(getVariance());
+        };
+
+        /**
+        * @brief  Returns the half width of the confidence interval of the mean for a Student's t quantile, 0 with fewer than two values
+        */
+        double getConfidenceHalfWidth(const double tQuantile) const {
+            return m_Count > 1 ? tQuantile * getStdDev() / sqrt(static_cast<double>(m_Count)) : 0;
+        };
+
+    private:
+        /**
+        * @brief  Number of values added
+        */
+        uint64_t m_Count;
+
+        /**
+        * @brief  Running mean
+        */
+        double m_Mean;
+
+        /**
+        * @brief  Running sum of squared deviations from the mean
+        */
+        double m_SumSquaredDeviations;
+};
+
+/**
+* @class P2Quantile
+* @brief Estimates one quantile of a stream of values in constant memory with the P-squared algorithm (Jain and Chlamtac, 1985).
+*        Five markers track the minimum, the quantile, the maximum and two points between them, and are moved along a
+*        piecewise-parabolic curve as values arrive. Exact until a sixth value is added
+*/
+class P2Quantile{
+    public:
+        /**
+        * @brief  Constructs new 'P2Quantile' object
+        * @param probability Probability of the quantile, in [0, 1]
+        */
+        P2Quantile(const double probability = 0.5) : m_Probability(probability), m_Count(0), m_Heights(), m_Positions(),
+                    m_DesiredPositions(), m_Increments{0, probability / 2, probability, (1 + probability) / 2, 1} {};
+
+        /**
+        * @brief  Adds a value
+        */
+        void add(const double value){
+            // Collect the first five values as the initial markers
+            if(m_Count < NUM_MARKERS){
+                m_Heights[m_Count++] = value;
+                if(m_Count == NUM_MARKERS){
+                    sort(m_Heights.begin(), m_Heights.end());
+                    for(size_t i = 0; i < NUM_MARKERS; i++){
+                        m_Positions[i] = i + 1;
+                        m_DesiredPositions[i] = 1 + 4 * m_Increments[i];
+                    }
+                }
+                return;
+            }
+
+            // Find the cell of the value, extending the extreme markers if needed
+            size_t cell{0};
+            if(value < m_Heights[0]){
+                m_Heights[0] = value;
+            }
+            else if(value >= m_Heights[NUM_MARKERS - 1]){
+                m_Heights[NUM_MARKERS - 1] = value;
+                cell = NUM_MARKERS - 2;
+            }
+            else{
+                while(value >= m_Heights[cell + 1]){
+                    cell++;
+                }
+            }
+
+            // Shift the markers above the cell and the desired positions of all markers
+            for(size_t i = cell + 1; i < NUM_MARKERS; i++){
+                m_Positions[i]++;
+            }
+            for(size_t i = 0; i < NUM_MARKERS; i++){
+                m_DesiredPositions[i] += m_Increments[i];
+            }
+            m_Count++;
+
+            // Move the middle markers one position towards their desired positions
+            for(size_t i = 1; i < NUM_MARKERS - 1; i++){
+                const double offset{m_DesiredPositions[i] - m_Positions[i]};
+                if((offset >= 1 && m_Positions[i + 1] - m_Positions[i] > 1) || (offset <= -1 && m_Positions[i - 1] - m_Positions[i] < -1)){
+                    const int direction{offset > 0 ? 1 : -1};
+                    const double parabolicHeight{getParabolicHeight(i, direction)};
+                    if(m_Heights[i - 1] < parabolicHeight && parabolicHeight < m_Heights[i + 1]){
+                        m_Heights[i] = parabolicHeight;
+                    }
+                    else{
+                        m_Heights[i] = getLinearHeight(i, direction);
+                    }
+                    m_Positions[i] += direction;
+                }
+            }
+        };
+
+        /**
+        * @brief  Returns the estimated quantile, 0 if no values have been added
+        */
+        double getQuantile() const {
+            if(m_Count > NUM_MARKERS){
+                return m_Heights[2];
+            }
+            if(m_Count == 0){
+                return 0;
+            }
+
+            // Interpolate between the sorted values, the markers still hold every value
+            array<double, NUM_MARKERS> values{m_Heights};
+            sort(values.begin(), values.begin() + m_Count);
+            const double rank{m_Probability * (m_Count - 1)};
+            const size_t lower{static_cast<size_t>(rank)};
+            const size_t upper{min<size_t>(lower + 1, m_Count - 1)};
+            return values[lower] + (rank - lower) * (values[upper] - values[lower]);
+        };
+
+        /**
+        * @brief  Returns the probability of the quantile
+        */
+        double getProbability() const {
+            return m_Probability;
+        };
+
+    private:
+        /**
+        * @brief  Number of markers
+        */
+        static constexpr size_t NUM_MARKERS{5};
+
+        /**
+        * @brief  Probability of the quantile
+        */
+        double m_Probability;
+
+        /**
+        * @brief  Number of values added
+        */
+        uint64_t m_Count;
+
+        /**
+        * @brief  Marker heights, estimates of the minimum, p/2, p, (1 + p)/2 quantiles and maximum
+        */
+        array<double, NUM_MARKERS> m_Heights;
+
+        /**
+        * @brief  Marker positions (1-based ranks)
+        */
+        array<double, NUM_MARKERS> m_Positions;
+
+        /**
+        * @brief  Desired marker positions
+        */
+        array<double, NUM_MARKERS> m_DesiredPositions;
+
+        /**
+        * @brief  Increments of the desired marker positions per value
+        */
+        array<double, NUM_MARKERS> m_Increments;
+
+        /**
+        * @brief  Returns the piecewise-parabolic prediction of a marker height moved by direction
+        */
+        double getParabolicHeight(const size_t i, const int direction) const {
+            return m_Heights[i] + direction / (m_Positions[i + 1] - m_Positions[i - 1])
+                    * ((m_Positions[i] - m_Positions[i - 1] + direction) * (m_Heights[i + 1] - m_Heights[i]) / (m_Positions[i + 1] - m_Positions[i])
+                    + (m_Positions[i + 1] - m_Positions[i] - direction) * (m_Heights[i] - m_Heights[i - 1]) / (m_Positions[i] - m_Positions[i - 1]));
+        };
+
+        /**
+        * @brief  Returns the linear prediction of a marker height moved by direction
+        */
+        double getLinearHeight(const size_t i, const int direction) const {
+            const size_t neighbour{direction > 0 ? i + 1 : i - 1};
+            return m_Heights[i] + direction * (m_Heights[neighbour] - m_Heights[i]) / (m_Positions[neighbour] - m_Positions[i]);
+        };
+};
+
+/**
+* @class MetricAccumulator
+* @brief Streaming mean, variance, 5th percentile, median and 95th percentile of one metric
+*/
+class MetricAccumulator{
+    public:
+        /**
+        * @brief  Constructs new empty 'MetricAccumulator' object
+        */
+        MetricAccumulator() : m_Moments(), m_Percentile5(0.05), m_Median(0.5), m_Percentile95(0.95) {};
+
+        /**
+        * @brief  Adds a value
+        */
+        void add(const double value){
+            m_Moments.add(value);
+            m_Percentile5.add(value);
+            m_Median.add(value);
+            m_Percentile95.add(value);
+        };
+
+        /**
+        * @brief  Returns the mean and variance of the values
+        */
+        const WelfordAccumulator& getMoments() const {
+            return m_Moments;
+        };
+
+        /**
+        * @brief  Returns the estimated 5th percentile
+        */
+        double getPercentile5() const {
+            return m_Percentile5.getQuantile();
+        };
+
+        /**
+        * @brief  Returns the estimated median
+        */
+        double getMedian() const {
+            return m_Median.getQuantile();
+        };
+
+        /**
+        * @brief  Returns the estimated 95th percentile
+        */
+        double getPercentile95() const {
+            return m_Percentile95.getQuantile();
+        };
+
+    private:
+        /**
+        * @brief  Count, mean and variance
+        */
+        WelfordAccumulator m_Moments;
+
+        /**
+        * @brief  5th percentile estimator
+        */
+        P2Quantile m_Percentile5;
+
+        /**
+        * @brief  Median estimator
+        */
+        P2Quantile m_Median;
+
+        /**
+        * @brief  95th percentile estimator
+        */
+        P2Quantile m_Percentile95;
+};
+
+#endif // STREAMING_STATISTICS_H
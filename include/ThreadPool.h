@@ -0,0 +1,336 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <algorithm>
+#include <exception>
+
+using namespace std;
+
+/**
+* @class ThreadPool
+* @brief Fixed set of worker threads, each with its own task queue. Submitted tasks are spread across the queues in turn,
+*        workers run their own tasks in submission order and steal from the back of other queues when theirs is empty,
+*        so a few long tasks do not leave the other workers idle. Batches of runTasks bypass the queues: the workers claim task
+*        indexes of the one running batch from a shared counter, so a batch allocates nothing
+*/
+class ThreadPool{
+    public:
+        /**
+        * @brief  Constructs new 'ThreadPool' object
+        * @param numThreads Number of worker threads, defaults to the number of hardware threads
+        */
+        ThreadPool(const size_t numThreads = thread::hardware_concurrency()) : m_TaskQueues(numThreads > 0 ? numThreads : 1),
+                    m_NextTaskQueue(0), m_NumPendingTasks(0), m_Stopping(false), m_Batch(), m_BatchGeneration(0), m_NumBatchWorkers(0) {
+            for(size_t i = 0; i < m_TaskQueues.size(); i++){
+                m_Workers.emplace_back([this, i](){ runWorker(i); });
+            }
+        };
+
+        /**
+        * @brief  Finishes all submitted tasks and joins the worker threads
+        */
+        ~ThreadPool(){
+            {
+                lock_guard<mutex> lock(m_StateMutex);
+                m_Stopping = true;
+            }
+            m_TasksCondition.notify_all();
+            for(thread& worker : m_Workers){
+                worker.join();
+            }
+        };
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+        * @brief  Submits a task to the pool. Returns a future that is ready once the task has run
+        * @param task Callable with no arguments
+        */
+        template<typename Task>
+        future<void> submit(Task&& task){
+            shared_ptr<packaged_task<void()>> packagedTask{make_shared<packaged_task<void()>>(forward<Task>(task))};
+            future<void> taskFuture{packagedTask->get_future()};
+            {
+                TaskQueue& taskQueue{m_TaskQueues[m_NextTaskQueue++ % m_TaskQueues.size()]};
+                lock_guard<mutex> lock(taskQueue.queueMutex);
+                taskQueue.tasks.push_back([packagedTask](){ (*packagedTask)(); });
+            }
+            {
+                lock_guard<mutex> lock(m_StateMutex);
+                m_NumPendingTasks++;
+            }
+            m_TasksCondition.notify_one();
+            return taskFuture;
+        };
+
+        /**
+        * @brief  Runs task(taskIdx) for every task index in [0, numTasks) and waits for all of them to finish. The calling thread
+        *         and the workers claim task indexes in turn. If a task throws, the tasks not yet claimed are skipped and the first
+        *         exception is rethrown once no worker runs a task of the batch any more. Batches of concurrent calls run one at a time
+        */
+        template<typename Task>
+        void runTasks(const size_t numTasks, Task&& task){
+            if(numTasks == 0){
+                return;
+            }
+            using TaskType = typename remove_reference<Task>::type;
+            lock_guard<mutex> batchLock(m_BatchMutex);
+            m_Batch.runTask = [](void* batchTask, const size_t taskIdx){ (*static_cast<TaskType*>(batchTask))(taskIdx); };
+            m_Batch.task = const_cast<void*>(static_cast<const void*>(&task));
+            m_Batch.numTasks = numTasks;
+            m_Batch.nextTaskIdx.store(0, memory_order_relaxed);
+            m_Batch.taskException = nullptr;
+            {
+                lock_guard<mutex> lock(m_StateMutex);
+                m_BatchGeneration++;
+            }
+            m_TasksCondition.notify_all();
+
+            runBatchTasks();
+
+            // Close the batch and wait for the workers still running its tasks, so none outlives task
+            {
+                unique_lock<mutex> lock(m_StateMutex);
+                m_BatchGeneration++;
+                m_BatchCondition.wait(lock, [this](){ return m_NumBatchWorkers == 0; });
+            }
+            if(m_Batch.taskException){
+                rethrow_exception(m_Batch.taskException);
+            }
+        };
+
+        /**
+        * @brief  Returns the number of worker threads
+        */
+        const size_t getNumThreads(){
+            return m_Workers.size();
+        };
+
+    private:
+        /**
+        * @brief  Task queue of one worker thread
+        */
+        struct TaskQueue{
+            mutex queueMutex;
+            deque<function<void()>> tasks;
+        };
+
+        /**
+        * @brief  Worker threads
+        */
+        vector<thread> m_Workers;
+
+        /**
+        * @brief  Task queue of every worker thread
+        */
+        vector<TaskQueue> m_TaskQueues;
+
+        /**
+        * @brief  Counter used to spread submitted tasks across the task queues
+        */
+        atomic<size_t> m_NextTaskQueue;
+
+        /**
+        * @brief  Number of submitted tasks that have not been taken by a worker
+        */
+        size_t m_NumPendingTasks;
+
+        /**
+        * @brief  Guards m_NumPendingTasks and m_Stopping
+        */
+        mutex m_StateMutex;
+
+        /**
+        * @brief  Signals workers when tasks are submitted or the pool is stopping
+        */
+        condition_variable m_TasksCondition;
+
+        /**
+        * @brief  Set when the pool is being destroyed
+        */
+        bool m_Stopping;
+
+        /**
+        * @brief  Tasks of one runTasks call, reused by every call
+        */
+        struct TaskBatch{
+            void (*runTask)(void* batchTask, const size_t taskIdx);
+            void* task;
+            size_t numTasks;
+            atomic<size_t> nextTaskIdx;
+            mutex exceptionMutex;
+            exception_ptr taskException;
+        };
+
+        /**
+        * @brief  Current batch of runTasks
+        */
+        TaskBatch m_Batch;
+
+        /**
+        * @brief  Serializes runTasks calls
+        */
+        mutex m_BatchMutex;
+
+        /**
+        * @brief  Odd while a batch is open, incremented when a batch opens and when it closes. Guarded by m_StateMutex
+        */
+        uint64_t m_BatchGeneration;
+
+        /**
+        * @brief  Number of workers running tasks of the current batch. Guarded by m_StateMutex
+        */
+        size_t m_NumBatchWorkers;
+
+        /**
+        * @brief  Signals runTasks when the last worker leaves the batch
+        */
+        condition_variable m_BatchCondition;
+
+        /**
+        * @brief  Runs tasks of the current batch until every task index is claimed. Stores the first exception and skips the tasks
+        *         not yet claimed once a task throws
+        */
+        void runBatchTasks(){
+            for(size_t taskIdx = m_Batch.nextTaskIdx.fetch_add(1); taskIdx < m_Batch.numTasks; taskIdx = m_Batch.nextTaskIdx.fetch_add(1)){
+                try{
+                    m_Batch.runTask(m_Batch.task, taskIdx);
+                }
+                catch(...){
+                    lock_guard<mutex> lock(m_Batch.exceptionMutex);
+                    if(!m_Batch.taskException){
+                        m_Batch.taskException = current_exception();
+                    }
+                    m_Batch.nextTaskIdx.store(m_Batch.numTasks);
+                }
+            }
+        };
+
+        /**
+        * @brief  Takes the next task of a worker, from the front of its own queue or the back of another worker's queue.
+        *         Returns false if every queue is empty
+        */
+        bool takeTask(const size_t workerIdx, function<void()>& task){
+            for(size_t i = 0; i < m_TaskQueues.size(); i++){
+                TaskQueue& taskQueue{m_TaskQueues[(workerIdx + i) % m_TaskQueues.size()]};
+                lock_guard<mutex> lock(taskQueue.queueMutex);
+                if(taskQueue.tasks.empty()){
+                    continue;
+                }
+                if(i == 0){
+                    task = move(taskQueue.tasks.front());
+                    taskQueue.tasks.pop_front();
+                }
+                else{
+                    task = move(taskQueue.tasks.back());
+                    taskQueue.tasks.pop_back();
+                }
+                return true;
+            }
+            return false;
+        };
+
+        /**
+        * @brief  Runs tasks until the pool is stopping and no tasks remain
+        */
+        void runWorker(const size_t workerIdx){
+            uint64_t joinedBatchGeneration{0};
+            while(true){
+                {
+                    unique_lock<mutex> lock(m_StateMutex);
+                    const auto isNewBatchOpen{[this, &joinedBatchGeneration](){
+                        return m_BatchGeneration % 2 == 1 && m_BatchGeneration != joinedBatchGeneration;
+                    }};
+                    m_TasksCondition.wait(lock, [&](){ return m_Stopping || m_NumPendingTasks > 0 || isNewBatchOpen(); });
+
+                    // Join each open batch once, it is finished when its task indexes run out
+                    if(isNewBatchOpen()){
+                        joinedBatchGeneration = m_BatchGeneration;
+                        m_NumBatchWorkers++;
+                        lock.unlock();
+                        runBatchTasks();
+                        lock.lock();
+                        if(--m_NumBatchWorkers == 0){
+                            m_BatchCondition.notify_all();
+                        }
+                        continue;
+                    }
+                    if(m_NumPendingTasks == 0){
+                        return;
+                    }
+                    m_NumPendingTasks--;
+                }
+
+                // Tasks are queued before they are counted, so every claimed task is in one of the queues
+                function<void()> task{};
+                while(!takeTask(workerIdx, task)){
+                    this_thread::yield();
+                }
+                task();
+            }
+        };
+};
+
+/**
+* @brief  Runs body(begin, end) over contiguous chunks of [0, count), one chunk per thread, and waits for all chunks to finish.
+*         If a chunk throws, the exception of the first such chunk is rethrown after every chunk finished
+* @param count Number of items
+* @param numThreads Number of threads (chunks) to split the items across, the calling thread runs the first chunk
+* @param body Callable taking the begin and end index of a chunk
+*/
+template<typename Body>
+void parallelFor(const size_t count, const size_t numThreads, Body&& body){
+    const size_t numChunks{min(max<size_t>(numThreads, 1), count)};
+    if(numChunks <= 1){
+        body(size_t{0}, count);
+        return;
+    }
+
+    const size_t chunkSize{(count + numChunks - 1) / numChunks};
+    vector<exception_ptr> chunkExceptions(numChunks);
+    {
+        // Joins the started threads however this scope is left, a joinable thread must not be destroyed
+        struct ThreadJoiner{
+            vector<thread> threads;
+            ~ThreadJoiner(){
+                for(thread& chunkThread : threads){
+                    chunkThread.join();
+                }
+            };
+        } threadJoiner{};
+        threadJoiner.threads.reserve(numChunks - 1);
+        for(size_t begin = chunkSize, chunkIdx = 1; begin < count; begin += chunkSize, chunkIdx++){
+            threadJoiner.threads.emplace_back([&body, &chunkExceptions, chunkIdx, begin, end = min(begin + chunkSize, count)](){
+                try{
+                    body(begin, end);
+                }
+                catch(...){
+                    chunkExceptions[chunkIdx] = current_exception();
+                }
+            });
+        }
+        try{
+            body(size_t{0}, chunkSize);
+        }
+        catch(...){
+            chunkExceptions[0] = current_exception();
+        }
+    }
+    for(const exception_ptr& chunkException : chunkExceptions){
+        if(chunkException){
+            rethrow_exception(chunkException);
+        }
+    }
+}
+
+#endif // THREAD_POOL_H
\ No newline at end of file
@@ -0,0 +1,333 @@
+#ifndef TIME_SERIES_RECORDER_H
+#define TIME_SERIES_RECORDER_H
+
+#include <UnloadingStation.h>
+#include <MiningTruckFleet.h>
+#include <SimulationTime.h>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+/**
+* @brief  Constructs new 'TimeSeriesConfig' object. Sampling interval and resolution levels of a time-series recorder
+*/
+struct TimeSeriesConfig{
+    double sampleInterval_min{5};   // Simulated time between samples (minutes)
+    size_t numLevels{3};            // Number of resolution levels
+    size_t bucketsPerLevel{128};    // Number of buckets kept by each level, older buckets are overwritten
+    size_t downsampleFactor{16};    // Each level's buckets span this many buckets of the level below (level 0 buckets hold one sample)
+};
+
+/**
+* @brief  Constructs new 'TimeSeriesPoint' object. Minimum, maximum and mean of the samples in one bucket of a series
+*/
+struct TimeSeriesPoint{
+    double startTime_min{0};        // Simulation time of the first sample in the bucket (minutes)
+    size_t numSamples{0};           // Number of samples in the bucket
+    float min{0};                   // Smallest sample
+    float max{0};                   // Largest sample
+    double mean{0};                 // Mean of the samples
+};
+
+/**
+* @class TimeSeriesRecorder
+* @brief Samples the number of trucks in each state, and the queue length and busy state of each station, at a fixed interval
+*        of simulated time. Every series is downsampled into several resolution levels of min/max/mean buckets kept in fixed-size
+*        ring buffers, so memory is set when the recorder is created and does not grow with the simulated time. All series are
+*        sampled together, so bucket boundaries and sample counts are shared per level
+*/
+class TimeSeriesRecorder{
+    public:
+        /**
+        * @brief  Number of fleet state series, one per truck state (MINING, TRAVEL, UNLOAD)
+        */
+        static constexpr size_t NUM_FLEET_SERIES{3};
+
+        /**
+        * @brief  Constructs new disabled 'TimeSeriesRecorder' object that records nothing
+        */
+        TimeSeriesRecorder() : m_Config(), m_NumStations(0), m_NumSeries(0), m_SampleInterval(0), m_NextSampleTime(0), m_SampleValues(), m_Levels(), m_Buckets(), m_OpenBuckets() {};
+
+        /**
+        * @brief  Constructs new 'TimeSeriesRecorder' object for a number of stations, allocating all buckets
+        */
+        TimeSeriesRecorder(const size_t numStations, const TimeSeriesConfig& config) : m_Config(config), m_NumStations(numStations),
+                    m_NumSeries(NUM_FLEET_SERIES + 2 * numStations), m_SampleInterval(max<SimulationTicks>(minutesToTicks(config.sampleInterval_min), 1)), 
+                    m_NextSampleTime(0), m_SampleValues(m_NumSeries), m_Levels(), m_Buckets(), m_OpenBuckets() {
+            m_Config.numLevels = max<size_t>(m_Config.numLevels, 1);
+            m_Config.bucketsPerLevel = max<size_t>(m_Config.bucketsPerLevel, 1);
+            m_Config.downsampleFactor = max<size_t>(m_Config.downsampleFactor, 2);
+
+            size_t samplesPerBucket{1};
+            for(size_t level = 0; level < m_Config.numLevels; level++){
+                m_Levels.push_back(TimeSeriesLevel(samplesPerBucket, m_Config.bucketsPerLevel));
+                samplesPerBucket *= m_Config.downsampleFactor;
+            }
+            m_Buckets.resize(m_Config.numLevels * m_NumSeries * m_Config.bucketsPerLevel);
+            m_OpenBuckets.resize(m_Config.numLevels * m_NumSeries);
+        };
+
+        /**
+        * @brief  Returns true if the recorder samples series
+        */
+        bool isEnabled() const {
+            return m_NumSeries > 0;
+        };
+
+        /**
+        * @brief  Samples every series if a sample interval has passed since the last sample. Does not allocate memory
+        * @param simulationTime Current simulation time (ticks)
+        * @param stations All unloading stations
+        * @param miningTrucksList List (or struct-of-arrays fleet) of all mining trucks
+        */
+        template<typename TruckList>
+        void record(const SimulationTicks simulationTime, const vector<Station>& stations, const TruckList& miningTrucksList){
+            if(simulationTime < m_NextSampleTime){
+                return;
+            }
+            m_NextSampleTime = simulationTime + m_SampleInterval;
+
+            // Count trucks in each state
+            const array<size_t, NUM_FLEET_SERIES> fleetStateCounts{countTruckStates<NUM_FLEET_SERIES>(miningTrucksList)};
+            for(size_t state = 0; state < NUM_FLEET_SERIES; state++){
+                m_SampleValues[state] = fleetStateCounts[state];
+            }
+
+            // Station queue lengths and busy states
+            for(size_t i = 0; i < m_NumStations && i < stations.size(); i++){
+                m_SampleValues[getStationQueueSeriesIdx(i)] = stations[i].vehicleIdQueue.size();
+                m_SampleValues[getStationBusySeriesIdx(i)] = stations[i].state == UnloadingStationStates::OCCUPIED ? 1 : 0;
+            }
+
+            addSample(ticksToMinutes(simulationTime));
+        };
+
+        /**
+        * @brief  Returns the buckets of a series at a resolution level, oldest first. The last bucket may hold fewer samples
+        *         than the others if it is still being filled
+        * @param seriesIdx Index of the series (see getFleetStateSeriesIdx, getStationQueueSeriesIdx and getStationBusySeriesIdx)
+        * @param level Resolution level, 0 holds one sample per bucket
+        */
+        vector<TimeSeriesPoint> getSeries(const size_t seriesIdx, const size_t level) const {
+            vector<TimeSeriesPoint> points{};
+            if(seriesIdx >= m_NumSeries || level >= m_Levels.size()){
+                return points;
+            }
+
+            const TimeSeriesLevel& timeSeriesLevel{m_Levels[level]};
+            const size_t numBuckets{min(timeSeriesLevel.numClosedBuckets, m_Config.bucketsPerLevel)};
+            const size_t firstBucket{timeSeriesLevel.numClosedBuckets - numBuckets};
+            for(size_t i = firstBucket; i < timeSeriesLevel.numClosedBuckets; i++){
+                const size_t ringIdx{i % m_Config.bucketsPerLevel};
+                points.push_back(toPoint(m_Buckets[getBucketIdx(level, seriesIdx) + ringIdx], timeSeriesLevel.startTimes[ringIdx],
+                                            timeSeriesLevel.samplesPerBucket));
+            }
+            if(timeSeriesLevel.numOpenSamples > 0){
+                points.push_back(toPoint(m_OpenBuckets[level * m_NumSeries + seriesIdx], timeSeriesLevel.openStartTime, timeSeriesLevel.numOpenSamples));
+            }
+            return points;
+        };
+
+        /**
+        * @brief  Returns the name of a series
+        */
+        string getSeriesName(const size_t seriesIdx) const {
+            static const char* FLEET_SERIES_NAMES[NUM_FLEET_SERIES]{"Trucks Mining", "Trucks Travelling", "Trucks Unloading"};
+            if(seriesIdx < NUM_FLEET_SERIES){
+                return FLEET_SERIES_NAMES[seriesIdx];
+            }
+            if(seriesIdx < NUM_FLEET_SERIES + m_NumStations){
+                return "Station " + to_string(seriesIdx - NUM_FLEET_SERIES) + " Queue Length";
+            }
+            return "Station " + to_string(seriesIdx - NUM_FLEET_SERIES - m_NumStations) + " Busy";
+        };
+
+        /**
+        * @brief  Returns the index of the series counting the trucks in a state
+        */
+        static size_t getFleetStateSeriesIdx(const int truckState){
+            return truckState;
+        };
+
+        /**
+        * @brief  Returns the index of the queue length series of a station
+        */
+        size_t getStationQueueSeriesIdx(const size_t stationId) const {
+            return NUM_FLEET_SERIES + stationId;
+        };
+
+        /**
+        * @brief  Returns the index of the busy state series of a station (1 while occupied, so bucket means are utilizations)
+        */
+        size_t getStationBusySeriesIdx(const size_t stationId) const {
+            return NUM_FLEET_SERIES + m_NumStations + stationId;
+        };
+
+        /**
+        * @brief  Returns the number of series
+        */
+        size_t getNumSeries() const {
+            return m_NumSeries;
+        };
+
+        /**
+        * @brief  Returns the number of resolution levels
+        */
+        size_t getNumLevels() const {
+            return m_Levels.size();
+        };
+
+        /**
+        * @brief  Returns the number of samples taken
+        */
+        uint64_t getNumSamples() const {
+            return m_Levels.empty() ? 0 : m_Levels.front().numClosedBuckets;
+        };
+
+        /**
+        * @brief  Returns the configuration of the recorder
+        */
+        const TimeSeriesConfig& getConfig() const {
+            return m_Config;
+        };
+
+        /**
+        * @brief  Returns the number of bytes held by the buckets, fixed when the recorder is created
+        */
+        size_t getMemoryBytes() const {
+            size_t numBytes{(m_Buckets.capacity() + m_OpenBuckets.capacity()) * sizeof(TimeSeriesBucket) + m_SampleValues.capacity() * sizeof(float)};
+            for(const TimeSeriesLevel& level : m_Levels){
+                numBytes += level.startTimes.capacity() * sizeof(double);
+            }
+            return numBytes;
+        };
+
+    private:
+        /**
+        * @brief  Constructs new 'TimeSeriesBucket' object. Running minimum, maximum and sum of the samples in a bucket
+        */
+        struct TimeSeriesBucket{
+            float min{0};
+            float max{0};
+            double sum{0};
+        };
+
+        /**
+        * @brief  Constructs new 'TimeSeriesLevel' object. Bucket boundaries of one resolution level, shared by every series
+        */
+        struct TimeSeriesLevel{
+            size_t samplesPerBucket;        // Samples in each closed bucket
+            uint64_t numClosedBuckets;      // Buckets closed since the first sample, the ring holds the last bucketsPerLevel
+            size_t numOpenSamples;          // Samples in the bucket being filled
+            double openStartTime;           // Time of the first sample in the bucket being filled (minutes)
+            vector<double> startTimes;      // Time of the first sample of each bucket in the ring (minutes)
+
+            TimeSeriesLevel(const size_t samplesPerBucket, const size_t bucketsPerLevel) : samplesPerBucket(samplesPerBucket), numClosedBuckets(0),
+                                numOpenSamples(0), openStartTime(0), startTimes(bucketsPerLevel) {}
+        };
+
+        /**
+        * @brief  Sampling interval and resolution levels
+        */
+        TimeSeriesConfig m_Config;
+
+        /**
+        * @brief  Number of stations sampled
+        */
+        size_t m_NumStations;
+
+        /**
+        * @brief  Number of series, fleet state series followed by station queue length and station busy series
+        */
+        size_t m_NumSeries;
+
+        /**
+        * @brief  Simulated time between samples (ticks), at least one tick
+        */
+        SimulationTicks m_SampleInterval;
+
+        /**
+        * @brief  Simulation time of the next sample (ticks)
+        */
+        SimulationTicks m_NextSampleTime;
+
+        /**
+        * @brief  Value of every series in the current sample
+        */
+        vector<float> m_SampleValues;
+
+        /**
+        * @brief  Bucket boundaries of each level
+        */
+        vector<TimeSeriesLevel> m_Levels;
+
+        /**
+        * @brief  Ring buffers of closed buckets, one per level and series: [level][series][bucket]
+        */
+        vector<TimeSeriesBucket> m_Buckets;
+
+        /**
+        * @brief  Bucket being filled of each level and series: [level][series]
+        */
+        vector<TimeSeriesBucket> m_OpenBuckets;
+
+        /**
+        * @brief  Returns the index of the first bucket of the ring buffer of a level and series
+        */
+        size_t getBucketIdx(const size_t level, const size_t seriesIdx) const {
+            return (level * m_NumSeries + seriesIdx) * m_Config.bucketsPerLevel;
+        };
+
+        /**
+        * @brief  Adds m_SampleValues to the open bucket of every level, closing the buckets that are full
+        */
+        void addSample(const double simulationTime_min){
+            for(size_t level = 0; level < m_Levels.size(); level++){
+                TimeSeriesLevel& timeSeriesLevel{m_Levels[level]};
+                TimeSeriesBucket* openBuckets{m_OpenBuckets.data() + level * m_NumSeries};
+                if(timeSeriesLevel.numOpenSamples == 0){
+                    timeSeriesLevel.openStartTime = simulationTime_min;
+                    for(size_t i = 0; i < m_NumSeries; i++){
+                        openBuckets[i] = TimeSeriesBucket{m_SampleValues[i], m_SampleValues[i], m_SampleValues[i]};
+                    }
+                }
+                else{
+                    for(size_t i = 0; i < m_NumSeries; i++){
+                        openBuckets[i].min = min(openBuckets[i].min, m_SampleValues[i]);
+                        openBuckets[i].max = max(openBuckets[i].max, m_SampleValues[i]);
+                        openBuckets[i].sum += m_SampleValues[i];
+                    }
+                }
+
+                // Move a full bucket into the ring, overwriting the oldest bucket
+                if(++timeSeriesLevel.numOpenSamples == timeSeriesLevel.samplesPerBucket){
+                    const size_t ringIdx{timeSeriesLevel.numClosedBuckets % m_Config.bucketsPerLevel};
+                    for(size_t i = 0; i < m_NumSeries; i++){
+                        m_Buckets[getBucketIdx(level, i) + ringIdx] = openBuckets[i];
+                    }
+                    timeSeriesLevel.startTimes[ringIdx] = timeSeriesLevel.openStartTime;
+                    timeSeriesLevel.numClosedBuckets++;
+                    timeSeriesLevel.numOpenSamples = 0;
+                }
+            }
+        };
+
+
+        /**
+        * @brief  Returns the point of a bucket
+        */
+        static TimeSeriesPoint toPoint(const TimeSeriesBucket& bucket, const double startTime_min, const size_t numSamples){
+            TimeSeriesPoint point{};
+            point.startTime_min = startTime_min;
+            point.numSamples = numSamples;
+            point.min = bucket.min;
+            point.max = bucket.max;
+            point.mean = bucket.sum / numSamples;
+            return point;
+        };
+};
+
+#endif // TIME_SERIES_RECORDER_H
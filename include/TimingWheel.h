@@ -0,0 +1,176 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+using namespace std;
+
+/**
+* @brief  Entity filed in a 'TimingWheel' under the tick it expires in
+*/
+struct TimingWheelEntry{
+    int id;             // Id of the truck (or other entity)
+    uint64_t tick;      // Index of the tick the entry expires in
+};
+
+/**
+* @class TimingWheel
+* @brief Hierarchical timing wheel of entity ids keyed on tick index. Each level has SLOTS_PER_LEVEL slots, a slot of level L spans
+*        SLOTS_PER_LEVEL^L ticks, and an entry is filed on the lowest level whose slot span separates its tick from the current tick.
+*        Inserting is O(1), and entries of higher levels cascade one level down each time the lower level wraps, so collecting the
+*        entries of a tick touches only that tick's slot. Entries beyond the top level wait in an overflow list
+*/
+class TimingWheel{
+    public:
+        /**
+        * @brief  Number of bits of the tick index per level
+        */
+        static constexpr uint32_t SLOT_BITS{6};
+
+        /**
+        * @brief  Number of slots of each level
+        */
+        static constexpr uint64_t SLOTS_PER_LEVEL{uint64_t{1} << SLOT_BITS};
+
+        /**
+        * @brief  Constructs new empty 'TimingWheel' object
+        * @param numLevels Number of levels, ticks up to SLOTS_PER_LEVEL^numLevels ahead are filed without overflow
+        * @param currentTick Index of the first tick collected
+        */
+        TimingWheel(const size_t numLevels = 4, const uint64_t currentTick = 0) : m_NumLevels(max<size_t>(numLevels, 1)), m_CurrentTick(currentTick),
+                    m_Slots(m_NumLevels * SLOTS_PER_LEVEL), m_Overflow(), m_CascadeBuffer(), m_Size(0) {};
+
+        /**
+        * @brief  Files an entity under a tick. Ticks before the current tick are filed under the current tick
+        * @param id Id of the entity
+        * @param tick Index of the tick the entity expires in
+        */
+        void insert(const int id, const uint64_t tick){
+            file(TimingWheelEntry{id, max(tick, m_CurrentTick)});
+            m_Size++;
+        };
+
+        /**
+        * @brief  Moves the ids of the entities filed under the current tick to the end of ids, in the order they were filed
+        */
+        void collectCurrent(vector<int>& ids){
+            vector<TimingWheelEntry>& slot{m_Slots[m_CurrentTick & (SLOTS_PER_LEVEL - 1)]};
+            for(const TimingWheelEntry& entry : slot){
+                ids.push_back(entry.id);
+            }
+            m_Size -= slot.size();
+            slot.clear();
+        };
+
+        /**
+        * @brief  Advances to the next tick, cascading the slots of higher levels that start at it down one level.
+        *         Entities of the current tick must have been collected
+        */
+        void advance(){
+            m_CurrentTick++;
+
+            // Overflow entries within reach of the top level are filed once the top level wraps
+            const uint32_t wheelBits{static_cast<uint32_t>(m_NumLevels) * SLOT_BITS};
+            if(wheelBits < 64 && (m_CurrentTick & ((uint64_t{1} << wheelBits) - 1)) == 0 && !m_Overflow.empty()){
+                vector<TimingWheelEntry> overflow{};
+                overflow.swap(m_Overflow);
+                for(const TimingWheelEntry& entry : overflow){
+                    file(entry);
+                }
+            }
+
+            // Cascade from the highest level that wrapped, so entries can fall through several levels
+            size_t level{1};
+            while(level < m_NumLevels && (m_CurrentTick & ((uint64_t{1} << (level * SLOT_BITS)) - 1)) == 0){
+                level++;
+            }
+            for(size_t cascadeLevel = level - 1; cascadeLevel > 0; cascadeLevel--){
+                vector<TimingWheelEntry>& slot{m_Slots[getSlotIdx(cascadeLevel, m_CurrentTick)]};
+                if(slot.empty()){
+                    continue;
+                }
+                m_CascadeBuffer.clear();
+                m_CascadeBuffer.swap(slot);
+                for(const TimingWheelEntry& entry : m_CascadeBuffer){
+                    file(entry);
+                }
+            }
+        };
+
+        /**
+        * @brief  Returns the index of the current tick
+        */
+        uint64_t getCurrentTick() const {
+            return m_CurrentTick;
+        };
+
+        /**
+        * @brief  Returns the number of entities filed
+        */
+        size_t size() const {
+            return m_Size;
+        };
+
+        /**
+        * @brief  Returns the number of levels
+        */
+        size_t getNumLevels() const {
+            return m_NumLevels;
+        };
+
+    private:
+        /**
+        * @brief  Number of levels
+        */
+        size_t m_NumLevels;
+
+        /**
+        * @brief  Index of the current tick
+        */
+        uint64_t m_CurrentTick;
+
+        /**
+        * @brief  Slots of every level, level by level
+        */
+        vector<vector<TimingWheelEntry>> m_Slots;
+
+        /**
+        * @brief  Entries beyond the top level
+        */
+        vector<TimingWheelEntry> m_Overflow;
+
+        /**
+        * @brief  Entries of the slot being cascaded, reused so cascading does not allocate once warmed up
+        */
+        vector<TimingWheelEntry> m_CascadeBuffer;
+
+        /**
+        * @brief  Number of entities filed
+        */
+        size_t m_Size;
+
+        /**
+        * @brief  Returns the index in m_Slots of the slot of a level a tick falls in
+        */
+        size_t getSlotIdx(const size_t level, const uint64_t tick) const {
+            return level * SLOTS_PER_LEVEL + ((tick >> (level * SLOT_BITS)) & (SLOTS_PER_LEVEL - 1));
+        };
+
+        /**
+        * @brief  Files an entry on the lowest level whose slots separate its tick from the current tick
+        */
+        void file(const TimingWheelEntry& entry){
+            for(size_t level = 0; level < m_NumLevels; level++){
+                const uint32_t shift{static_cast<uint32_t>((level + 1) * SLOT_BITS)};
+                if(shift >= 64 || (entry.tick >> shift) == (m_CurrentTick >> shift)){
+                    m_Slots[getSlotIdx(level, entry.tick)].push_back(entry);
+                    return;
+                }
+            }
+            m_Overflow.push_back(entry);
+        };
+};
+
+#endif // TIMING_WHEEL_H
@@ -2,7 +2,7 @@
 #define UNLOADING_STATION_H
 
 #include <MiningTruckProcessor.h>
-#include <queue>
+#include <VehicleIdQueue.h>
 
 using namespace std;
 
@@ -14,18 +14,58 @@ enum UnloadingStationStates {
     OCCUPIED,
     };
 
+ /**
+  * @brief Defines the actions a station takes in a time step
+  */
+enum UnloadingStationActions {
+    STATION_WAIT,               // Stay available, no vehicles queued
+    STATION_OPEN,               // Start unloading the queued vehicles
+    STATION_UNLOAD_VEHICLE,     // Unload the vehicle at the front of the queue, closing once the queue is empty
+    STATION_CLOSE               // Become available again
+    };
+
+/**
+* @brief  Row of the station transition table. Describes a station in one state and queue status, and its action in a time step
+*/
+struct StationTransition{
+    int state;          // Station state the row applies to
+    int condition;      // Station queue status the row applies to (0 empty, 1 vehicles queued)
+    int action;         // Action of the station (UnloadingStationActions)
+    int nextState;      // State after the action
+};
+
+/**
+* @brief  Station cycle AVAILABLE -> OCCUPIED while vehicles are queued -> AVAILABLE
+*/
+struct StationCyclePolicy{
+    static constexpr size_t NUM_STATES{2};
+    static constexpr size_t NUM_CONDITIONS{2};
+    static constexpr array<StationTransition, NUM_STATES * NUM_CONDITIONS> TRANSITIONS{{
+        // state, queued, action, next state
+        {UnloadingStationStates::AVAILABLE, 0, STATION_WAIT, UnloadingStationStates::AVAILABLE},
+        {UnloadingStationStates::AVAILABLE, 1, STATION_OPEN, UnloadingStationStates::OCCUPIED},
+        {UnloadingStationStates::OCCUPIED, 0, STATION_CLOSE, UnloadingStationStates::AVAILABLE},
+        {UnloadingStationStates::OCCUPIED, 1, STATION_UNLOAD_VEHICLE, UnloadingStationStates::OCCUPIED},
+    }};
+};
+
+/**
+* @brief  State machine of the unloading stations
+*/
+using StationStateMachine = StateMachine<StationCyclePolicy>;
+
 /**
 * @brief  Constructs new 'Station' object
 */
 struct Station{
     const int id;                   // Station ID
     int state;                      // Current station state
-    float waitTime;                 // Current station state (min)
-    queue<int> vehicleIdQueue;      // Queue of vehicles to be unloaded by station
+    int waitTime;                   // Current station wait time (ticks)
+    VehicleIdQueue vehicleIdQueue;  // Queue of vehicles to be unloaded by station
     int numVehiclesUnloaded;        // Number of trucks unloaded
 
     // Parameterized constructor
-    Station(const int id) : id(id), state(UnloadingStationStates::AVAILABLE), waitTime(0), numVehiclesUnloaded(0), vehicleIdQueue() {}
+    Station(const int id) : id(id), state(UnloadingStationStates::AVAILABLE), waitTime(0), vehicleIdQueue(), numVehiclesUnloaded(0) {}
 };
 
 /**
@@ -40,8 +80,8 @@ struct StationPerformanceStats{
     float totalIdleTime_hrs;        // Total number of hours spent idle
 
     // Parameterized constructor
-    StationPerformanceStats(const int id) : stationId(id), totalUnloads(0), totalUnloadingTime_hrs(0), totalIdleTime_hrs(0), 
-                                    percentUnloadingTime(0), percentIdleTime(0) {}
+    StationPerformanceStats(const int id) : stationId(id), totalUnloads(0), percentUnloadingTime(0), percentIdleTime(0), 
+                                    totalUnloadingTime_hrs(0), totalIdleTime_hrs(0) {}
 };
 
 #endif // UNLOADING_STATION_H
\ No newline at end of file
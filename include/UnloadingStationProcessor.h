@@ -3,6 +3,10 @@
 
 #include <MiningTruckProcessor.h>
 #include <UnloadingStation.h>
+#include <StationDispatcher.h>
+#include <StationQueuePool.h>
+#include <SimulationLog.h>
+#include <queue>
 #include <iostream>
 #include "spdlog/spdlog.h"
 
@@ -18,10 +22,22 @@ class UnloadingStationProcessor{
     // ****IF MORE TIME NOTE 2: Would add more error checking
     public:
         /**
-        * @brief  Constructs new 'UnloadingStationProcessor' object
+        * @brief  Constructs new 'UnloadingStationProcessor' object. Station queues share one slab sized for numMiningTrucks trucks
         */
-        UnloadingStationProcessor(const float numUnloadingStations, const float unloadDuration_min): m_NumUnloadingStations(numUnloadingStations), 
-                                    m_UnloadDuration(unloadDuration_min), m_UnloadingStationsList(initUnloadingStations(numUnloadingStations)), m_AvailableLoadingStationIdxs() {};
+        UnloadingStationProcessor(const float numUnloadingStations, const float unloadDuration_min, const size_t numMiningTrucks = 0): m_UnloadingStationsList(initUnloadingStations(numUnloadingStations)), 
+                                    m_NumUnloadingStations(numUnloadingStations), m_UnloadDuration(minutesToTicks(unloadDuration_min)), m_StationDispatcher(numUnloadingStations), m_EventTrace(nullptr), m_DispatchCounters(),
+                                    m_StationQueuePool() {
+            m_StationQueuePool.attach(m_UnloadingStationsList, StationQueuePool::getFleetQueueCapacity(numMiningTrucks, m_UnloadingStationsList.size()));
+        };
+
+        /**
+        * @brief  Constructs new 'UnloadingStationProcessor' object with copies of the stations of other, queued in a slab of its own
+        */
+        UnloadingStationProcessor(const UnloadingStationProcessor& other): m_UnloadingStationsList(other.m_UnloadingStationsList), m_NumUnloadingStations(other.m_NumUnloadingStations),
+                                    m_UnloadDuration(other.m_UnloadDuration), m_StationDispatcher(other.m_StationDispatcher), m_EventTrace(other.m_EventTrace), m_DispatchCounters(other.m_DispatchCounters),
+                                    m_StationQueuePool() {
+            poolStationQueues();
+        };
 
         /**
         * @brief  Construct all unloading stations in simulation
@@ -29,80 +45,120 @@ class UnloadingStationProcessor{
         */
         static vector<Station> initUnloadingStations(const size_t numUnloadingStations){
             vector<Station> unloadingStations{};
+            unloadingStations.reserve(numUnloadingStations);
             // Create Station objects with unique ids
-            for(int i = 0; i < numUnloadingStations; i++){
-                unloadingStations.push_back(Station(i));
+            for(size_t i = 0; i < numUnloadingStations; i++){
+                unloadingStations.emplace_back(static_cast<int>(i));
             }
             return unloadingStations;
         };
 
         /**
         * @brief Updates the states of the loading stations
-        * @param timestep_min Length of one timestep in minutes
-        * @param miningTrucksList List of all Mining trucks in a simulation
+        * @param timestep_ticks Length of one timestep in ticks
+        * @param miningTrucksList List (or struct-of-arrays fleet) of all Mining trucks in a simulation
         */
-        void updateUnloadingStations(const float timestep_min, vector<Truck>& miningTrucksList){
+        template<typename TruckList>
+        void updateUnloadingStations(const SimulationTicks timestep_ticks, TruckList& miningTrucksList){
             // Iterate through all trucks to update state
             for(Station& station : m_UnloadingStationsList){
-                bool stateChange{false};
-
-                // Change state of station according to current state
-                switch(station.state){
-                    case UnloadingStationStates::AVAILABLE:
-                        // After station is available,
-                        // if there are vehicles to be unloaded, change state to occupied
-                        if(!station.vehicleIdQueue.empty()){
-                            // Change state to occupied
-                            station.state = UnloadingStationStates::OCCUPIED;
-
-                            // Compute current wait time
-                            station.waitTime = m_UnloadDuration * station.vehicleIdQueue.size();
-                        }
-                        break;
-                    case UnloadingStationStates::OCCUPIED:
-                        // If vehicle in queue, unload vehicle
-                        if(!station.vehicleIdQueue.empty()){
-                            // Get Vehicle id from front of queue
-                            const int vehicleId = station.vehicleIdQueue.front();
-
-                            // Unload vehicle at station
-                            stateChange = unloadVehicleAtStation(miningTrucksList[vehicleId], station);
-
-                            // Remove vehicle id from station queue
-                            station.vehicleIdQueue.pop();
-                        }
-                        else{
-                            stateChange = true;
+                updateUnloadingStation(station, miningTrucksList);
+            }
+        };
+
+        /**
+        * @brief Updates the state of a single loading station. Returns the id of the vehicle unloaded, or -1 if no vehicle was unloaded
+        * @param station Unloading station to update
+        * @param miningTrucksList List (or struct-of-arrays fleet) of all Mining trucks in a simulation
+        */
+        template<typename TruckList>
+        int updateUnloadingStation(Station& station, TruckList& miningTrucksList){
+            int unloadedVehicleId{-1};
+
+            // Take the action of the station's state and queue status
+            const StationTransition& transition{StationStateMachine::getTransition(station.state, !station.vehicleIdQueue.empty())};
+            station.state = transition.nextState;
+            switch(transition.action){
+                case UnloadingStationActions::STATION_WAIT:
+                    break;
+                case UnloadingStationActions::STATION_OPEN:
+                    // Compute current wait time
+                    station.waitTime = m_UnloadDuration * static_cast<int>(station.vehicleIdQueue.size());
+                    m_StationDispatcher.updateWaitTime(station.id, station.waitTime);
+
+                    if(m_EventTrace != nullptr){
+                        m_EventTrace->record(TraceEventTypes::STATION_STATE_CHANGED, station.id, UnloadingStationStates::AVAILABLE, station.state);
+                    }
+                    break;
+                case UnloadingStationActions::STATION_UNLOAD_VEHICLE:{
+                    // Get Vehicle id from front of queue
+                    const int vehicleId = station.vehicleIdQueue.front();
+
+                    // Unload vehicle at station
+                    auto&& vehicle{miningTrucksList[vehicleId]};
+                    const bool vehicleLoaded = vehicle.isLoaded;
+                    const bool stateChange{unloadVehicleAtStation(vehicle, station)};
+                    if(vehicleLoaded && !vehicle.isLoaded){
+                        unloadedVehicleId = vehicleId;
+                        if(m_EventTrace != nullptr){
+                            m_EventTrace->record(TraceEventTypes::TRUCK_UNLOADED, vehicleId, vehicle.state, vehicle.state, station.id);
                         }
+                    }
 
-                        // if no vehicles left in queue, change state to available
-                        if(stateChange && station.vehicleIdQueue.empty()){
-                            // change state to available
-                            station.state = UnloadingStationStates::AVAILABLE;
+                    // Remove vehicle id from station queue
+                    station.vehicleIdQueue.pop();
 
-                            // add station idx to queue of available stations
-                            m_AvailableLoadingStationIdxs.push(station.id);
-                        }
-                        break;
+                    // if no vehicles left in queue, close the station
+                    if(stateChange && station.vehicleIdQueue.empty()){
+                        closeStation(station);
+                    }
+                    break;
                 }
+                case UnloadingStationActions::STATION_CLOSE:
+                    closeStation(station);
+                    break;
             }
+
+            return unloadedVehicleId;
         };
 
         /**
         * @brief  Updates the states of the loading stations
-        * @param miningTrucksList List of all Mining trucks in a simulation
+        * @param miningTrucksList List (or struct-of-arrays fleet) of all Mining trucks in a simulation
         * @param loadedTrucksIdx List of indexes/ids of newly loaded trucks in simulation
         */
-        void assignVehiclesToStations(vector<Truck>& miningTrucksList, const vector<int>& loadedTrucksIdx){
+        template<typename TruckList>
+        void assignVehiclesToStations(TruckList& miningTrucksList, const vector<int>& loadedTrucksIdx){
             // Iterate through all loaded truck indices
-            int minWaitStationIdx{};
             for(int idx : loadedTrucksIdx){
-                // Get first available/ minimum wait station index
-                minWaitStationIdx = getShortestWaitStationIdx();
+                assignVehicleToStation(miningTrucksList[idx]);
+            }
+        };
 
-                // Assign current truck to station
-                assignVehicle(miningTrucksList[idx], m_UnloadingStationsList[minWaitStationIdx]);
+        /**
+        * @brief  Assigns a loaded truck to the station with the shortest wait. Returns the index of the assigned station, or -1 if not assigned
+        * @param loadedTruck Newly loaded truck awaiting an unloading station
+        */
+        template<typename TruckT>
+        int assignVehicleToStation(TruckT&& loadedTruck){
+            // Get first available/ minimum wait station index
+            const int minWaitStationIdx{getShortestWaitStationIdx()};
+            if(minWaitStationIdx == -1){
+                RUNTIME_METRICS(m_DispatchCounters.numUnassignedTrucks++;)
+                return -1;
             }
+            RUNTIME_METRICS(const bool stationAvailable{m_StationDispatcher.isAvailable(minWaitStationIdx)};)
+
+            // Assign current truck to station
+            if(!assignVehicle(loadedTruck, m_UnloadingStationsList[minWaitStationIdx])){
+                RUNTIME_METRICS(m_DispatchCounters.numUnassignedTrucks++;)
+                return -1;
+            }
+            RUNTIME_METRICS(
+                (stationAvailable ? m_DispatchCounters.numAssignedToAvailableStation : m_DispatchCounters.numAssignedToShortestWaitStation)++;
+                m_DispatchCounters.maxStationQueueLength = max(m_DispatchCounters.maxStationQueueLength, m_UnloadingStationsList[minWaitStationIdx].vehicleIdQueue.size());
+            )
+            return minWaitStationIdx;
         };
 
         /**
@@ -113,17 +169,74 @@ class UnloadingStationProcessor{
         };
 
         /**
-        * @brief  Returns the unload duration in minutes
+        * @brief  Returns the unload duration in ticks
         */
-        const float getUnloadDuration(){
+        const int getUnloadDuration(){
             return m_UnloadDuration;
         };
 
         /**
-        * @brief  Sets the queue of available loading stations
+        * @brief  Sets the available loading stations and rebuilds the dispatcher index from the current station wait times
         */
         void setAvailableLoadingStations(const queue<int>& availableLoadingStations){
-            m_AvailableLoadingStationIdxs = availableLoadingStations;
+            m_StationDispatcher.clearAvailable();
+            queue<int> availableStationIdxs{availableLoadingStations};
+            while(!availableStationIdxs.empty()){
+                m_StationDispatcher.setAvailable(availableStationIdxs.front(), true);
+                availableStationIdxs.pop();
+            }
+            for(const Station& station : m_UnloadingStationsList){
+                m_StationDispatcher.updateWaitTime(station.id, station.waitTime);
+            }
+        };
+
+        /**
+        * @brief  Returns the indices of the available loading stations in increasing order
+        */
+        queue<int> getAvailableLoadingStations(){
+            queue<int> availableStationIdxs{};
+            for(size_t i = 0; i < m_UnloadingStationsList.size(); i++){
+                if(m_StationDispatcher.isAvailable(static_cast<int>(i))){
+                    availableStationIdxs.push(static_cast<int>(i));
+                }
+            }
+            return availableStationIdxs;
+        };
+
+        /**
+        * @brief  Returns true if every station is available, with no truck queued or unloading, so updating the stations does nothing
+        *         until a truck is assigned
+        */
+        bool areStationsIdle() const {
+            return m_StationDispatcher.getNumAvailable() == m_UnloadingStationsList.size();
+        };
+
+        /**
+        * @brief  Moves the queues of all stations back into one slab, after m_UnloadingStationsList has been replaced
+        */
+        void poolStationQueues(){
+            m_StationQueuePool.attach(m_UnloadingStationsList, m_StationQueuePool.getQueueCapacity());
+        };
+
+        /**
+        * @brief  Returns the pool the station queues are stored in
+        */
+        const StationQueuePool& getStationQueuePool(){
+            return m_StationQueuePool;
+        };
+
+        /**
+        * @brief  Returns the dispatcher counters, all zero unless compiled with ENABLE_RUNTIME_METRICS
+        */
+        const DispatchCounters getDispatchCounters(){
+            return m_DispatchCounters;
+        };
+
+        /**
+        * @brief  Sets the event trace station events are recorded to, or nullptr to stop recording
+        */
+        void setEventTrace(EventTraceWriter* eventTrace){
+            m_EventTrace = eventTrace;
         };
 
         /**
@@ -138,68 +251,71 @@ class UnloadingStationProcessor{
         const size_t m_NumUnloadingStations;
 
         /**
-        * @brief  Duration of unloading process (minutes)
+        * @brief  Duration of unloading process (ticks)
         */
-        const float m_UnloadDuration;
+        const int m_UnloadDuration;
 
         /**
-        * @brief  Queue of Indices of available loading stations
+        * @brief  Index of available stations and station wait times, used to pick the station for each loaded truck
         */
-        queue<int> m_AvailableLoadingStationIdxs;
+        StationDispatcher m_StationDispatcher;
 
         /**
-        * @brief  Gets the index of the station with the shortest wait time
+        * @brief  Event trace station events are recorded to, nullptr if not tracing
         */
-       int getShortestWaitStationIdx(){
-            int shortestWaitIdx{-1};
+        EventTraceWriter* m_EventTrace;
 
-            // Return any available station idx first
-            if(!m_AvailableLoadingStationIdxs.empty()){
-                // Get first available unloading station index
-                shortestWaitIdx = m_AvailableLoadingStationIdxs.front();
-
-                // return index
-                return shortestWaitIdx;
-            }
+        /**
+        * @brief  Dispatcher counters, only updated when compiled with ENABLE_RUNTIME_METRICS
+        */
+        DispatchCounters m_DispatchCounters;
 
-            // loop through all unavailable stations to and track shortest wait time
-            float shortestWaitTime{};
-            for(int i = 0; i < m_NumUnloadingStations; i++){
-                Station currentStation{m_UnloadingStationsList[i]};
-                if(i == 0){
-                    shortestWaitIdx = currentStation.id;
-                    shortestWaitTime = currentStation.waitTime;
-                    continue;
-                }
+        /**
+        * @brief  Slab holding the queues of all stations
+        */
+        StationQueuePool m_StationQueuePool;
 
-                if(currentStation.waitTime < shortestWaitTime){
-                    shortestWaitIdx = currentStation.id;
-                    shortestWaitTime = currentStation.waitTime;
-                }
-            }
+        /**
+        * @brief  Gets the index of the first available station, otherwise the station with the shortest wait time
+        */
+       int getShortestWaitStationIdx(){
+            const int shortestWaitIdx{m_StationDispatcher.getNextStationIdx()};
 
             // Validate that shortest wait idx has been set
             if(shortestWaitIdx == -1){
-                error("getShortestWait Error: Shortest wait time unloading station could not be found.");
+                SIMULATION_LOG_ERROR("getShortestWait Error: Shortest wait time unloading station could not be found.");
             }
             return shortestWaitIdx;
        };
 
+       /**
+        * @brief  Makes an occupied station available for dispatch again
+        */
+       void closeStation(Station& station){
+            station.state = UnloadingStationStates::AVAILABLE;
+            m_StationDispatcher.setAvailable(station.id, true);
+
+            if(m_EventTrace != nullptr){
+                m_EventTrace->record(TraceEventTypes::STATION_STATE_CHANGED, station.id, UnloadingStationStates::OCCUPIED, station.state);
+            }
+       };
+
        /**
         * @brief  Performs actions related to unloading a vehicle, and returns true if state change required
         */
-       bool unloadVehicleAtStation(Truck& loadedTruck, Station& unloadingStation){
+       template<typename TruckT>
+       bool unloadVehicleAtStation(TruckT& loadedTruck, Station& unloadingStation){
         bool stateChange{false};
 
         // Check that vehicle is loaded
         if(!loadedTruck.isLoaded){
-            error("UnloadVehicle Error: Vehicle is not loaded.");
+            SIMULATION_LOG_ERROR("UnloadVehicle Error: Vehicle {} is not loaded.", loadedTruck.id);
             return stateChange;
         }
 
         // Check that unload duration is valid
         if (m_UnloadDuration < 0){
-            error("UnloadVehicle Error: Invalid unload duration");
+            SIMULATION_LOG_ERROR("UnloadVehicle Error: Invalid unload duration {}", m_UnloadDuration);
             return stateChange;
         }
 
@@ -208,6 +324,7 @@ class UnloadingStationProcessor{
 
         // update station wait time
         unloadingStation.waitTime -= m_UnloadDuration;
+        m_StationDispatcher.updateWaitTime(unloadingStation.id, unloadingStation.waitTime);
 
         // Change vehicle unload status
         loadedTruck.isLoaded = false;
@@ -223,25 +340,26 @@ class UnloadingStationProcessor{
        };
 
        /**
-        * @brief  Assigns a vehicle to a specific station
+        * @brief  Assigns a vehicle to a specific station. Returns true if vehicle was assigned
         */
-       void assignVehicle(Truck& loadedTruck, Station& unloadingStation){
+       template<typename TruckT>
+       bool assignVehicle(TruckT& loadedTruck, Station& unloadingStation){
             // Check that vehicle is loaded
             if(!loadedTruck.isLoaded){
-                error("AssignVehicle Error: Vehicle is not loaded.");
-                return;
+                SIMULATION_LOG_ERROR("AssignVehicle Error: Vehicle {} is not loaded.", loadedTruck.id);
+                return false;
             }
 
             // Check that vehicle has not already been assigned
             if(loadedTruck.isAssignedStation){
-                error("AssignVehicle Error: Vehicle has already been assigned to unloading station.");
-                return;
+                SIMULATION_LOG_ERROR("AssignVehicle Error: Vehicle {} has already been assigned to unloading station.", loadedTruck.id);
+                return false;
             }
 
             // Check that unload duration is valid
             if (m_UnloadDuration < 0){
-                error("UnloadVehicle Error: Invalid unload duration");
-                return;
+                SIMULATION_LOG_ERROR("UnloadVehicle Error: Invalid unload duration {}", m_UnloadDuration);
+                return false;
             }
 
             // Add vehicle id to station queue
@@ -249,14 +367,18 @@ class UnloadingStationProcessor{
 
             // Update station wait time
             unloadingStation.waitTime += m_UnloadDuration;
+            m_StationDispatcher.updateWaitTime(unloadingStation.id, unloadingStation.waitTime);
 
-            // If station id in availability list, remove
-            if(!m_AvailableLoadingStationIdxs.empty() && m_AvailableLoadingStationIdxs.front() == unloadingStation.id){
-                m_AvailableLoadingStationIdxs.pop();
-            }
+            // Station is no longer available
+            m_StationDispatcher.setAvailable(unloadingStation.id, false);
 
             // Change vehicle assignment status
             loadedTruck.isAssignedStation = true;
+
+            if(m_EventTrace != nullptr){
+                m_EventTrace->record(TraceEventTypes::TRUCK_ASSIGNED, loadedTruck.id, loadedTruck.state, loadedTruck.state, unloadingStation.id);
+            }
+            return true;
        };
 };
 
@@ -0,0 +1,220 @@
+#ifndef VEHICLE_ID_QUEUE_H
+#define VEHICLE_ID_QUEUE_H
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+using namespace std;
+
+/**
+* @class VehicleIdQueue
+* @brief First-in first-out queue of vehicle ids stored in a fixed-capacity ring buffer. The buffer is either a part of a shared
+*        slab (see StationQueuePool) or owned by the queue. Pushing and popping never allocate, except when a push finds the buffer
+*        full, which moves the queue to an owned buffer of twice the capacity. Copies own their buffer
+*/
+class VehicleIdQueue{
+    public:
+        /**
+        * @brief  Constructs new empty 'VehicleIdQueue' object without a buffer
+        */
+        VehicleIdQueue() : m_Buffer(nullptr), m_Capacity(0), m_Front(0), m_Size(0), m_OwnedBuffer() {};
+
+        /**
+        * @brief  Constructs new 'VehicleIdQueue' object with its own copy of the vehicle ids of other
+        */
+        VehicleIdQueue(const VehicleIdQueue& other) : VehicleIdQueue() {
+            *this = other;
+        };
+
+        /**
+        * @brief  Constructs new 'VehicleIdQueue' object taking over the buffer of other
+        */
+        VehicleIdQueue(VehicleIdQueue&& other) noexcept : m_Buffer(other.m_Buffer), m_Capacity(other.m_Capacity), m_Front(other.m_Front),
+                                                            m_Size(other.m_Size), m_OwnedBuffer(move(other.m_OwnedBuffer)) {
+            other.m_Buffer = nullptr;
+            other.m_Capacity = other.m_Front = other.m_Size = 0;
+        };
+
+        /**
+        * @brief  Replaces the vehicle ids with those of other, keeping the current buffer if they fit
+        */
+        VehicleIdQueue& operator=(const VehicleIdQueue& other){
+            if(this != &other){
+                if(other.m_Size > m_Capacity){
+                    moveToOwnedBuffer(other.m_Size);
+                }
+                for(size_t i = 0; i < other.m_Size; i++){
+                    m_Buffer[i] = other[i];
+                }
+                m_Front = 0;
+                m_Size = other.m_Size;
+            }
+            return *this;
+        };
+
+        /**
+        * @brief  Takes over the buffer of other
+        */
+        VehicleIdQueue& operator=(VehicleIdQueue&& other) noexcept {
+            if(this != &other){
+                m_Buffer = other.m_Buffer;
+                m_Capacity = other.m_Capacity;
+                m_Front = other.m_Front;
+                m_Size = other.m_Size;
+                m_OwnedBuffer = move(other.m_OwnedBuffer);
+                other.m_Buffer = nullptr;
+                other.m_Capacity = other.m_Front = other.m_Size = 0;
+            }
+            return *this;
+        };
+
+        /**
+        * @brief  Adds a vehicle id to the back of the queue
+        */
+        void push(const int vehicleId){
+            if(m_Size == m_Capacity){
+                moveToOwnedBuffer(max(m_Capacity * 2, MIN_OWNED_CAPACITY));
+            }
+            m_Buffer[wrap(m_Front + m_Size)] = vehicleId;
+            m_Size++;
+        };
+
+        /**
+        * @brief  Removes the vehicle id at the front of the queue
+        */
+        void pop(){
+            if(++m_Front == m_Capacity){
+                m_Front = 0;
+            }
+            m_Size--;
+        };
+
+        /**
+        * @brief  Returns the vehicle id at the front of the queue
+        */
+        int front() const {
+            return m_Buffer[m_Front];
+        };
+
+        /**
+        * @brief  Returns the idx-th vehicle id from the front of the queue
+        */
+        int operator[](const size_t idx) const {
+            return m_Buffer[wrap(m_Front + idx)];
+        };
+
+        /**
+        * @brief  Returns true if the queue is empty
+        */
+        bool empty() const {
+            return m_Size == 0;
+        };
+
+        /**
+        * @brief  Returns the number of vehicle ids in the queue
+        */
+        size_t size() const {
+            return m_Size;
+        };
+
+        /**
+        * @brief  Returns the number of vehicle ids the queue holds without allocating
+        */
+        size_t capacity() const {
+            return m_Capacity;
+        };
+
+        /**
+        * @brief  Returns true if the buffer is part of a shared slab
+        */
+        bool isPooled() const {
+            return m_Buffer != nullptr && m_Buffer != m_OwnedBuffer.data();
+        };
+
+        /**
+        * @brief  Moves the queue into part of a shared slab with room for capacity vehicle ids, releasing any owned buffer.
+        *         Keeps the current buffer if the vehicle ids do not fit
+        */
+        void attachBuffer(int* buffer, const size_t capacity){
+            if(m_Size > capacity){
+                return;
+            }
+            for(size_t i = 0; i < m_Size; i++){
+                buffer[i] = (*this)[i];
+            }
+            m_Buffer = buffer;
+            m_Capacity = capacity;
+            m_Front = 0;
+            vector<int>().swap(m_OwnedBuffer);
+        };
+
+        /**
+        * @brief  Returns true if both queues hold the same vehicle ids in the same order
+        */
+        bool operator==(const VehicleIdQueue& other) const {
+            if(m_Size != other.m_Size){
+                return false;
+            }
+            for(size_t i = 0; i < m_Size; i++){
+                if((*this)[i] != other[i]){
+                    return false;
+                }
+            }
+            return true;
+        };
+
+    private:
+        /**
+        * @brief  Smallest owned buffer allocated when a queue without room is pushed to
+        */
+        static constexpr size_t MIN_OWNED_CAPACITY{8};
+
+        /**
+        * @brief  Ring buffer of vehicle ids, points into a shared slab or to m_OwnedBuffer
+        */
+        int* m_Buffer;
+
+        /**
+        * @brief  Number of vehicle ids the ring buffer holds
+        */
+        size_t m_Capacity;
+
+        /**
+        * @brief  Index of the front of the queue in the ring buffer
+        */
+        size_t m_Front;
+
+        /**
+        * @brief  Number of vehicle ids in the queue
+        */
+        size_t m_Size;
+
+        /**
+        * @brief  Buffer owned by the queue, empty while the queue is in a shared slab
+        */
+        vector<int> m_OwnedBuffer;
+
+        /**
+        * @brief  Returns the ring buffer index of an index in [0, 2 * capacity)
+        */
+        size_t wrap(const size_t idx) const {
+            return idx >= m_Capacity ? idx - m_Capacity : idx;
+        };
+
+        /**
+        * @brief  Moves the queue to the front of a new owned buffer with room for capacity vehicle ids
+        */
+        void moveToOwnedBuffer(const size_t capacity){
+            vector<int> buffer(capacity);
+            for(size_t i = 0; i < m_Size; i++){
+                buffer[i] = (*this)[i];
+            }
+            m_OwnedBuffer.swap(buffer);
+            m_Buffer = m_OwnedBuffer.data();
+            m_Capacity = capacity;
+            m_Front = 0;
+        };
+};
+
+#endif // VEHICLE_ID_QUEUE_H
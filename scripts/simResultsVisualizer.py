@@ -32,8 +32,8 @@ def parse_arguments():
         argparse.Namespace: Parsed arguments.
     """
     parser = argparse.ArgumentParser(description="Mining Simulation Peformance Visualization")
-    parser.add_argument("mining_trucks_csv_filepath", type=str, help="Path to the csv containing mining truck performances.")
-    parser.add_argument("unloading_stations_csv_filepath", type=str, help="Path to the csv containing unloading station performances.")
+    parser.add_argument("mining_trucks_csv_filepath", type=str, help="Path to the csv (or .mscols columnar file) containing mining truck performances.")
+    parser.add_argument("unloading_stations_csv_filepath", type=str, help="Path to the csv (or .mscols columnar file) containing unloading station performances.")
     parser.add_argument("--verbose", action="store_true", help="Enable verbose logging")
     return parser.parse_args()
 
@@ -76,16 +76,16 @@ def main():
     plot_save_directory = "results/plots"
     os.makedirs(plot_save_directory, exist_ok=True)  # Create logs directory if doesnt exist
 
-    ## Read CSV Data to pandas dataframe
-    mining_truck_df = import_csv_to_dataframe(truck_csv_path)
+    ## Read CSV or columnar data to pandas dataframe
+    mining_truck_df = import_results_to_dataframe(truck_csv_path)
     plot_total_unloads_comparison(mining_truck_df, 'Vehicle ID', 'Total Number of Unloads by Vehicle ID', plot_save_directory, datetime_str)
     plot_activity_comparison(mining_truck_df, 'Vehicle ID',['Percent Mining Time', 'Percent Unloading Time', 'Percent Travel Time'],
                             'Percentage of Time Spent on Mining, Unloading, and Travel by Vehicle', plot_save_directory, datetime_str)
 
     logging.info("Unloading Station Plots...")
 
-    ## Read CSV Data to pandas dataframe
-    unloading_station_df = import_csv_to_dataframe(station_csv_path)
+    ## Read CSV or columnar data to pandas dataframe
+    unloading_station_df = import_results_to_dataframe(station_csv_path)
     plot_total_unloads_comparison(unloading_station_df, 'Station ID', 'Total Number of Unloads by Station ID', plot_save_directory, datetime_str)
     plot_activity_comparison(unloading_station_df, 'Station ID',['Percent Idle Time', 'Percent Unloading Time'],
                             'Percentage of Time Spent in Idle and Unloading States by Station', plot_save_directory, datetime_str)
@@ -1,6 +1,8 @@
+import numpy as np
 import pandas as pd
 import logging
 
+
 def import_csv_to_dataframe(file_path):
     """
     Reads a CSV file and imports its data into a pandas DataFrame.
@@ -20,4 +22,70 @@ def import_csv_to_dataframe(file_path):
     except pd.errors.ParserError as e:
         logging.error(f"Error parsing the CSV file: {e}")
     except Exception as e:
-        logging.error(f"An unexpected error occurred: {e}")
\ No newline at end of file
+        logging.error(f"An unexpected error occurred: {e}")
+
+
+# Layout of the binary columnar result files written by the simulation (see include/ResultWriter.h)
+COLUMNAR_MAGIC = b"MSCOLS\0\0"
+COLUMNAR_VERSION = 1
+COLUMNAR_FILE_HEADER = np.dtype([("magic", "S8"), ("version", "<u4"), ("num_columns", "<u4"), ("num_rows", "<u8")])
+COLUMNAR_COLUMN_HEADER = np.dtype([("name", "S48"), ("dtype", "S8"), ("offset", "<u8")])
+
+
+def read_columns(file_path):
+    """
+    Memory-maps the columns of a binary columnar result file without copying or parsing them.
+
+    Args:
+        file_path (str): Path to the columnar (.mscols) file.
+
+    Returns:
+        dict: Column name -> read-only numpy memmap of the column values, in file order.
+    """
+    header = np.fromfile(file_path, dtype=COLUMNAR_FILE_HEADER, count=1)
+    if header.size != 1 or header["magic"][0] != COLUMNAR_MAGIC.rstrip(b"\0") or header["version"][0] != COLUMNAR_VERSION:
+        raise ValueError(f"'{file_path}' is not a version {COLUMNAR_VERSION} columnar result file")
+
+    num_columns = int(header["num_columns"][0])
+    num_rows = int(header["num_rows"][0])
+    column_headers = np.fromfile(file_path, dtype=COLUMNAR_COLUMN_HEADER, count=num_columns, offset=COLUMNAR_FILE_HEADER.itemsize)
+    if column_headers.size != num_columns:
+        raise ValueError(f"'{file_path}' is truncated")
+
+    columns = {}
+    for column_header in column_headers:
+        name = column_header["name"].decode()
+        columns[name] = np.memmap(file_path, dtype=np.dtype(column_header["dtype"].decode()), mode="r",
+                                  offset=int(column_header["offset"]), shape=(num_rows,))
+    return columns
+
+
+def import_columns_to_dataframe(file_path):
+    """
+    Reads a binary columnar result file into a pandas DataFrame with the same columns as the CSV file.
+
+    Args:
+        file_path (str): Path to the columnar (.mscols) file.
+
+    Returns:
+        pd.DataFrame: A DataFrame containing the file data.
+    """
+    try:
+        return pd.DataFrame(read_columns(file_path))
+    except Exception as e:
+        logging.error(f"Error reading the columnar file: {e}")
+
+
+def import_results_to_dataframe(file_path):
+    """
+    Reads a CSV or binary columnar (.mscols) result file into a pandas DataFrame.
+
+    Args:
+        file_path (str): Path to the result file.
+
+    Returns:
+        pd.DataFrame: A DataFrame containing the file data.
+    """
+    if file_path.endswith(".mscols"):
+        return import_columns_to_dataframe(file_path)
+    return import_csv_to_dataframe(file_path)
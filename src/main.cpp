@@ -1,5 +1,11 @@
 #include <iostream>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
 #include <Simulation.h>
+#include <ReplicationRunner.h>
+#include <FleetSweep.h>
+#include <MetricsExporter.h>
 #include "spdlog/spdlog.h"
 
 using namespace std;
@@ -23,45 +29,434 @@ static const double MIN_MINING_DURATION{1};
 // Maximum mining duration in hours
 static const double MAX_MINING_DURATION{5}; 
 
+/**
+* @brief  Returns true and sets value if flag has the form "<name>=<value>"
+*/
+static bool parseFlag(const string& flag, const string& name, string& value){
+    if(flag.rfind(name + "=", 0) != 0){
+        return false;
+    }
+    value = flag.substr(name.size() + 1);
+    return true;
+}
+
+// Most values a list of counts may expand to
+static const size_t MAX_NUM_COUNTS{10000};
+
+/**
+* @brief  Parses a non-negative integer that fills the whole text. Returns false if invalid, negative or out of range
+*/
+template<typename T>
+static bool parseInteger(const string& text, T& number){
+    static_assert(is_unsigned<T>::value, "Parsed integers must be unsigned");
+    const char* end{text.data() + text.size()};
+    const from_chars_result result{from_chars(text.data(), end, number)};
+    return !text.empty() && result.ec == errc() && result.ptr == end;
+}
+
+/**
+* @brief  Parses a finite non-negative number that fills the whole text. Returns false if invalid or negative
+*/
+static bool parseNumber(const string& text, double& number){
+    const char* end{text.data() + text.size()};
+    const from_chars_result result{from_chars(text.data(), end, number)};
+    return !text.empty() && result.ec == errc() && result.ptr == end && isfinite(number) && number >= 0;
+}
+
+/**
+* @brief  Parses a list of counts given as "<count>", "<first>:<last>[:<step>]" or "<count>,<count>,...". Returns false if invalid
+*/
+static bool parseCounts(const string& text, vector<size_t>& counts){
+    counts.clear();
+    if(text.find(':') != string::npos){
+        const size_t firstSep{text.find(':')};
+        const size_t secondSep{text.find(':', firstSep + 1)};
+        size_t first{0};
+        size_t last{0};
+        size_t step{1};
+        if(!parseInteger(text.substr(0, firstSep), first) || !parseInteger(text.substr(firstSep + 1, secondSep - firstSep - 1), last) ||
+           (secondSep != string::npos && !parseInteger(text.substr(secondSep + 1), step))){
+            return false;
+        }
+        if(first == 0 || last < first || step == 0 || (last - first) / step >= MAX_NUM_COUNTS){
+            return false;
+        }
+        for(size_t count = first; count <= last && count >= first; count += step){
+            counts.push_back(count);
+        }
+        return true;
+    }
+
+    stringstream values(text);
+    string value{};
+    while(getline(values, value, ',')){
+        size_t count{0};
+        if(!parseInteger(value, count) || count == 0 || counts.size() == MAX_NUM_COUNTS){
+            return false;
+        }
+        counts.push_back(count);
+    }
+    return !counts.empty();
+}
+
+/**
+* @brief  Parses a comma separated list of finite positive durations. Returns false if invalid
+*/
+static bool parseDurations(const string& text, vector<float>& durations){
+    durations.clear();
+    stringstream values(text);
+    string value{};
+    while(getline(values, value, ',')){
+        double duration{0};
+        if(!parseNumber(value, duration) || !isfinite(static_cast<float>(duration)) || static_cast<float>(duration) <= 0){
+            return false;
+        }
+        durations.push_back(static_cast<float>(duration));
+    }
+    return !durations.empty();
+}
+
 int main(int argc, char* argv[])
 {
-    // Check if the user provided exactly two additional arguments
-    if (argc != 3) {
-        error("Usage: {} <number_of_mining_trucks> <number_of_unloading_stations>\n", argv[0]);
+    // Check if the user provided two additional arguments and optional flags
+    if (argc < 3) {
+        error("Usage: {} <number_of_mining_trucks> <number_of_unloading_stations> [--engine=fixed|event|soa|wheel|adaptive] [--seed=<seed>] "
+                "[--replications=<count>] [--threads=<count>] [--min-mining=<hrs>] [--max-mining=<hrs>] [--travel=<hrs>] [--unload=<min>] "
+                "[--max-idle=<percent>] [--truck-cost=<cost>] [--station-cost=<cost>] [--trace] "
+                "[--save-checkpoint=<file>] [--restore-checkpoint=<file>] [--fleet-image=<file>] [--binary-results] [--time-series=<min>] [--ci-half-width=<value>] [--min-replications=<count>] "
+                "[--metrics-port=<port>] [--metrics-socket=<path>]\n", argv[0]);
         return 1;
     }
 
-    // Convert command-line arguments to int
-    const int numMiningTrucks{stoi(argv[1])};
-    const int numUnloadingStations{stoi(argv[2])};
+    // Parse optional flags
+    SimulationEngines simulationEngine{SimulationEngines::FIXED_STEP};
+    string simulationEngineName{"fixed"};
+    uint64_t seed{random_device{}()};
+    size_t numReplications{0};
+    size_t numThreads{thread::hardware_concurrency()};
+    FleetSweepRanges sweepRanges{};
+    double maxStationIdlePercent{100};
+    double truckCost{1};
+    double stationCost{1};
+    bool traceEvents{false};
+    string saveCheckpointFileName{};
+    string restoreCheckpointFileName{};
+    string fleetImageFileName{};
+    bool writeBinaryResults{false};
+    double timeSeriesInterval_min{0};
+    int metricsPort{-1};
+    string metricsSocketPath{};
+    SequentialStoppingConfig sequentialStopping{};
+    for(int i = 3; i < argc; i++){
+        const string flag{argv[i]};
+        string value{};
+        if(parseFlag(flag, "--engine", simulationEngineName)){
+            if(simulationEngineName == "fixed"){
+                simulationEngine = SimulationEngines::FIXED_STEP;
+            }
+            else if(simulationEngineName == "event"){
+                simulationEngine = SimulationEngines::DISCRETE_EVENT;
+            }
+            else if(simulationEngineName == "soa"){
+                simulationEngine = SimulationEngines::STRUCT_OF_ARRAYS;
+            }
+            else if(simulationEngineName == "wheel"){
+                simulationEngine = SimulationEngines::TIMING_WHEEL;
+            }
+            else if(simulationEngineName == "adaptive"){
+                simulationEngine = SimulationEngines::ADAPTIVE_STEP;
+            }
+            else{
+                error("Unknown simulation engine: {}", simulationEngineName);
+                return 1;
+            }
+        }
+        else if(parseFlag(flag, "--seed", value)){
+            if(!parseInteger(value, seed)){
+                error("Invalid seed (must be an integer >= 0): {}", value);
+                return 1;
+            }
+        }
+        else if(parseFlag(flag, "--replications", value)){
+            if(!parseInteger(value, numReplications)){
+                error("Invalid number of replications (must be >= 0): {}", value);
+                return 1;
+            }
+        }
+        else if(parseFlag(flag, "--threads", value)){
+            if(!parseInteger(value, numThreads)){
+                error("Invalid number of threads (must be > 0): {}", value);
+                return 1;
+            }
+        }
+        else if(parseFlag(flag, "--min-mining", value)){
+            if(!parseDurations(value, sweepRanges.minMiningDurations_hrs)){
+                error("Invalid minimum mining duration (must be > 0): {}", value);
+                return 1;
+            }
+        }
+        else if(parseFlag(flag, "--max-mining", value)){
+            if(!parseDurations(value, sweepRanges.maxMiningDurations_hrs)){
+                error("Invalid maximum mining duration (must be > 0): {}", value);
+                return 1;
+            }
+        }
+        else if(parseFlag(flag, "--travel", value)){
+            if(!parseDurations(value, sweepRanges.travelDurations_hrs)){
+                error("Invalid travel duration (must be > 0): {}", value);
+                return 1;
+            }
+        }
+        else if(parseFlag(flag, "--unload", value)){
+            if(!parseDurations(value, sweepRanges.unloadDurations_min)){
+                error("Invalid unload duration (must be > 0): {}", value);
+                return 1;
+            }
+        }
+        else if(parseFlag(flag, "--max-idle", value)){
+            if(!parseNumber(value, maxStationIdlePercent)){
+                error("Invalid maximum station idle percent (must be >= 0): {}", value);
+                return 1;
+            }
+        }
+        else if(parseFlag(flag, "--truck-cost", value)){
+            if(!parseNumber(value, truckCost)){
+                error("Invalid truck cost (must be >= 0): {}", value);
+                return 1;
+            }
+        }
+        else if(parseFlag(flag, "--station-cost", value)){
+            if(!parseNumber(value, stationCost)){
+                error("Invalid station cost (must be >= 0): {}", value);
+                return 1;
+            }
+        }
+        else if(flag == "--trace"){
+            traceEvents = true;
+        }
+        else if(parseFlag(flag, "--save-checkpoint", saveCheckpointFileName)){
+        }
+        else if(parseFlag(flag, "--restore-checkpoint", restoreCheckpointFileName)){
+        }
+        else if(parseFlag(flag, "--fleet-image", fleetImageFileName)){
+        }
+        else if(flag == "--binary-results"){
+            writeBinaryResults = true;
+        }
+        else if(parseFlag(flag, "--ci-half-width", value)){
+            if(!parseNumber(value, sequentialStopping.maxConfidenceHalfWidth) || sequentialStopping.maxConfidenceHalfWidth == 0){
+                error("Invalid confidence interval half width (must be > 0): {}", value);
+                return 1;
+            }
+        }
+        else if(parseFlag(flag, "--min-replications", value)){
+            if(!parseInteger(value, sequentialStopping.minReplications)){
+                error("Invalid minimum number of replications (must be >= 0): {}", value);
+                return 1;
+            }
+        }
+        else if(parseFlag(flag, "--metrics-port", value)){
+            uint16_t port{0};
+            if(!parseInteger(value, port)){
+                error("Invalid metrics port (must be 0 to 65535): {}", value);
+                return 1;
+            }
+            metricsPort = port;
+        }
+        else if(parseFlag(flag, "--metrics-socket", metricsSocketPath)){
+        }
+        else if(parseFlag(flag, "--time-series", value)){
+            if(!parseNumber(value, timeSeriesInterval_min) || timeSeriesInterval_min == 0){
+                error("Invalid time series interval (must be > 0): {}", value);
+                return 1;
+            }
+        }
+        else{
+            error("Unknown option: {}", flag);
+            return 1;
+        }
+    }
 
-    // Validate inputs
-    if(numMiningTrucks <= 0){
-        error("Invalid number of mining trucks (must be > 0): {}", numMiningTrucks);
+    // Convert command-line arguments to lists of counts and validate inputs
+    if(!parseCounts(argv[1], sweepRanges.numMiningTrucks)){
+        error("Invalid number of mining trucks (must be > 0): {}", argv[1]);
         // std::cerr << "Invalid number of mining trucks (must be > 0): " << numMiningTrucks << endl;
         return 1;
     }
 
-    if(numUnloadingStations <= 0){
-        error("Invalid number of unloading stations (must be > 0): {}", numUnloadingStations);
+    if(!parseCounts(argv[2], sweepRanges.numUnloadingStations)){
+        error("Invalid number of unloading stations (must be > 0): {}", argv[2]);
         // std::cerr << "Invalid number of unloading stations (must be > 0): " << numUnloadingStations<< endl;
         return 1;
     }
 
+    if(numThreads == 0){
+        error("Invalid number of threads (must be > 0): {}", numThreads);
+        return 1;
+    }
+
+    // Collect simulation parameters, durations given on the command line replace the defaults
+    SimulationParameters parameters{};
+    parameters.numMiningTrucks = sweepRanges.numMiningTrucks.front();
+    parameters.numUnloadingStations = sweepRanges.numUnloadingStations.front();
+    parameters.minMiningDuration_hrs = sweepRanges.minMiningDurations_hrs.empty() ? MIN_MINING_DURATION : sweepRanges.minMiningDurations_hrs.front();
+    parameters.maxMiningDuration_hrs = sweepRanges.maxMiningDurations_hrs.empty() ? MAX_MINING_DURATION : sweepRanges.maxMiningDurations_hrs.front();
+    parameters.travelDuration_hrs = sweepRanges.travelDurations_hrs.empty() ? TRAVEL_DURATION : sweepRanges.travelDurations_hrs.front();
+    parameters.unloadDuration_min = sweepRanges.unloadDurations_min.empty() ? UNLOAD_DURATION : sweepRanges.unloadDurations_min.front();
+    parameters.simulationTime_hrs = SIMULATION_TIME;
+    parameters.simulationTimestep_min = SIMULATION_TIMESTEP;
+    parameters.simulationEngine = simulationEngine;
+    parameters.seed = seed;
+
     // Initialize Simulation
     info("Initializing Simulation...");
     info("Simulation Duration: {}", SIMULATION_TIME);
     info("Simulation Timestep: {}", SIMULATION_TIMESTEP);
-    info("Number of mining trucks: {}", numMiningTrucks);
-    info("Number of unloading stations: {}", numUnloadingStations);
-    Simulation miningSimulation(numMiningTrucks, numUnloadingStations, MIN_MINING_DURATION, MAX_MINING_DURATION, TRAVEL_DURATION, 
-                                UNLOAD_DURATION, SIMULATION_TIME, SIMULATION_TIMESTEP);
+    info("Number of mining trucks: {}", argv[1]);
+    info("Number of unloading stations: {}", argv[2]);
+    info("Simulation Engine: {}", simulationEngineName);
+    info("Seed: {}", seed);
+    const std::string resultsDir = "results/"; // Define the results directory
+
+    // Serve live progress metrics on localhost while the simulations run
+    LiveMetrics liveMetrics(*max_element(sweepRanges.numUnloadingStations.begin(), sweepRanges.numUnloadingStations.end()));
+    MetricsExporter metricsExporter(liveMetrics);
+    if(metricsPort >= 0){
+        if(!metricsExporter.startTcp(static_cast<uint16_t>(metricsPort))){
+            return 1;
+        }
+        info("Serving metrics on http://127.0.0.1:{}/metrics", metricsExporter.getPort());
+    }
+    else if(!metricsSocketPath.empty()){
+        if(!metricsExporter.startUnixSocket(metricsSocketPath)){
+            return 1;
+        }
+        info("Serving metrics on Unix socket {}", metricsSocketPath);
+    }
+    LiveMetrics* publishedMetrics{metricsExporter.isRunning() ? &liveMetrics : nullptr};
+
+    // Sweep every combination when any parameter has more than one value
+    const bool runSweep{sweepRanges.numMiningTrucks.size() > 1 || sweepRanges.numUnloadingStations.size() > 1 ||
+                        sweepRanges.minMiningDurations_hrs.size() > 1 || sweepRanges.maxMiningDurations_hrs.size() > 1 ||
+                        sweepRanges.travelDurations_hrs.size() > 1 || sweepRanges.unloadDurations_min.size() > 1};
+
+    // A sweep skips the combinations with min > max, but at least one combination must be valid
+    const float minMiningDuration_hrs{sweepRanges.minMiningDurations_hrs.empty() ? parameters.minMiningDuration_hrs :
+                                      *min_element(sweepRanges.minMiningDurations_hrs.begin(), sweepRanges.minMiningDurations_hrs.end())};
+    const float maxMiningDuration_hrs{sweepRanges.maxMiningDurations_hrs.empty() ? parameters.maxMiningDuration_hrs :
+                                      *max_element(sweepRanges.maxMiningDurations_hrs.begin(), sweepRanges.maxMiningDurations_hrs.end())};
+    if(minMiningDuration_hrs > maxMiningDuration_hrs){
+        error("Invalid mining durations (min must be <= max): {} > {}", minMiningDuration_hrs, maxMiningDuration_hrs);
+        return 1;
+    }
+
+    // Options of a single simulation run are not supported by sweeps and replications
+    if(runSweep || numReplications > 0){
+        const vector<pair<bool, string>> singleRunOptions{{traceEvents, "--trace"}, {!saveCheckpointFileName.empty(), "--save-checkpoint"},
+                                                          {!restoreCheckpointFileName.empty(), "--restore-checkpoint"},
+                                                          {writeBinaryResults, "--binary-results"}, {timeSeriesInterval_min > 0, "--time-series"},
+                                                          {!fleetImageFileName.empty(), "--fleet-image"}};
+        for(const pair<bool, string>& singleRunOption : singleRunOptions){
+            if(singleRunOption.first){
+                error("{} is not supported with {}", singleRunOption.second, runSweep ? "fleet sweeps" : "--replications");
+                return 1;
+            }
+        }
+    }
+
+    if(runSweep){
+        info("Running Fleet Sweep on {} threads...", numThreads);
+        FleetSweep fleetSweep(parameters, sweepRanges, numThreads, truckCost, stationCost, maxStationIdlePercent);
+        fleetSweep.setLiveMetrics(publishedMetrics);
+        fleetSweep.run();
+        info("Fleet Sweep Complete...");
+
+        fleetSweep.printResults();
+
+        info("Saving Fleet Sweep Results to CSV file...");
+        fleetSweep.writeResultsToCSV("MiningSimulationResults_Sweep", resultsDir);
+
+        SimulationLog::reportSuppressed();
+        info("Done!");
+        return 0;
+    }
+
+    // Run replications and save aggregated results
+    if(numReplications > 0){
+        info("Running {} Replications on {} threads...", numReplications, numThreads);
+        ReplicationRunner replicationRunner(parameters, numReplications, numThreads);
+        replicationRunner.setLiveMetrics(publishedMetrics);
+        if(sequentialStopping.maxConfidenceHalfWidth > 0){
+            info("Stopping once every 95% confidence interval half width is within {}...", sequentialStopping.maxConfidenceHalfWidth);
+            replicationRunner.setSequentialStopping(sequentialStopping);
+        }
+        try{
+            replicationRunner.run();
+        }
+        catch(const exception& exception){
+            error("Replication failed: {}", exception.what());
+            return 1;
+        }
+        info("{} Replications Complete...", replicationRunner.getNumReplications());
+
+        replicationRunner.printResults();
+
+        info("Saving Replication Results to CSV file...");
+        replicationRunner.writeResultsToCSV("MiningSimulationResults_Replications", resultsDir);
+
+        SimulationLog::reportSuppressed();
+        info("Done!");
+        return 0;
+    }
+
+    // Load the mining durations of the fleet from a precomputed fleet image, written first if missing or for another fleet
+    if(!fleetImageFileName.empty()){
+        info("Loading Fleet Image {}...", fleetImageFileName);
+        parameters.fleetImageFileName = fleetImageFileName;
+    }
+
+    Simulation miningSimulation(parameters);
+    miningSimulation.setNumThreads(numThreads);
+    miningSimulation.setLiveMetrics(publishedMetrics);
+
+    // Resume from a checkpoint of a simulation with the same number of trucks and stations
+    if(!restoreCheckpointFileName.empty()){
+        info("Restoring Simulation from Checkpoint {}...", restoreCheckpointFileName);
+        if(!miningSimulation.restoreCheckpoint(restoreCheckpointFileName)){
+            return 1;
+        }
+    }
+
+    // Sample fleet state counts and station queues into constant-size time series
+    if(timeSeriesInterval_min > 0){
+        TimeSeriesConfig timeSeriesConfig{};
+        timeSeriesConfig.sampleInterval_min = timeSeriesInterval_min;
+        miningSimulation.enableTimeSeries(timeSeriesConfig);
+    }
+
+    // Trace every truck and station event to a binary file
+    if(traceEvents){
+        if(!Simulation::createResultsDirectory(resultsDir)){
+            return 1;
+        }
+        miningSimulation.setEventTraceFileName(getUniqueResultFileName(resultsDir, "MiningSimulationEventTrace", ".trace"));
+    }
 
     // Run simulation
     info("Running Simulation...");
+    liveMetrics.setNumRuns(1);
     miningSimulation.run();
+    liveMetrics.completeRun();
     info("Simulation Complete...");
 
+    // Save the final state so the simulation can be resumed or forked later
+    if(!saveCheckpointFileName.empty()){
+        info("Saving Simulation Checkpoint to {}...", saveCheckpointFileName);
+        if(!miningSimulation.saveCheckpoint(saveCheckpointFileName)){
+            return 1;
+        }
+    }
+
     // Compute Simulation Performance Statistics
     info("Computing Simulation Performance Results...");
     miningSimulation.computePerformanceStats();
@@ -69,15 +464,26 @@ int main(int argc, char* argv[])
     // Print Performance Results
     miningSimulation.printMiningTruckPerformanceStatistics();
     miningSimulation.printUnloadingStationPerformanceStatistics();
+    if(miningSimulation.getRuntimeMetrics().enabled){
+        miningSimulation.printRuntimeMetrics();
+    }
 
     // Print simulation results to csv files
     info("Saving Simulation Results to CSV files...");
-    const std::string resultsDir = "results/"; // Define the results directory
     const string miningTruckFileName = "MiningSimulationResults_MiningTrucks";
     const string unloadingStationFileName = "MiningSimulationResults_UnloadingStations";
     miningSimulation.writeTruckPerformanceToCSV(miningTruckFileName, resultsDir);
     miningSimulation.writeStationPerformanceToCSV(unloadingStationFileName, resultsDir);
+    if(timeSeriesInterval_min > 0){
+        miningSimulation.writeTimeSeriesToCSV("MiningSimulationResults_TimeSeries", resultsDir);
+    }
+    if(writeBinaryResults){
+        info("Saving Simulation Results to binary columnar files...");
+        miningSimulation.writeTruckPerformanceToColumns(miningTruckFileName, resultsDir);
+        miningSimulation.writeStationPerformanceToColumns(unloadingStationFileName, resultsDir);
+    }
 
+    SimulationLog::reportSuppressed();
     info("Done!");
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,559 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include <numpy/arrayobject.h>
+#include <Simulation.h>
+#include <ReplicationRunner.h>
+#include <mutex>
+#include <exception>
+
+using namespace std;
+
+/**
+* @brief  Locks mutex without holding the GIL while waiting, so a thread running a simulation can finish while others wait for it
+*/
+static unique_lock<mutex> lockReleasingGil(mutex& objectMutex){
+    unique_lock<mutex> lock(objectMutex, defer_lock);
+    Py_BEGIN_ALLOW_THREADS
+    lock.lock();
+    Py_END_ALLOW_THREADS
+    return lock;
+}
+
+/**
+* @brief  Runs work on an object without holding the GIL, one call at a time per object. Returns false with a Python exception set
+*         if work threw
+*/
+template<typename Work>
+static bool runReleasingGil(mutex& objectMutex, Work work){
+    string errorMessage{};
+    bool succeeded{true};
+    Py_BEGIN_ALLOW_THREADS
+    try{
+        lock_guard<mutex> lock(objectMutex);
+        work();
+    }
+    catch(const exception& exception){
+        errorMessage = exception.what();
+        succeeded = false;
+    }
+    Py_END_ALLOW_THREADS
+    if(!succeeded){
+        PyErr_SetString(PyExc_RuntimeError, errorMessage.c_str());
+    }
+    return succeeded;
+}
+
+/**
+* @brief  Returns the NumPy type number of a field type
+*/
+template<typename Field> constexpr int numpyType();
+template<> constexpr int numpyType<int>(){ return NPY_INT; }
+template<> constexpr int numpyType<bool>(){ return NPY_BOOL; }
+template<> constexpr int numpyType<float>(){ return NPY_FLOAT; }
+template<> constexpr int numpyType<double>(){ return NPY_DOUBLE; }
+
+/**
+* @brief  Returns a read-only NumPy array over data without copying it, keeping owner alive as the base of the array
+*/
+static PyObject* newArrayView(const int typeNum, const int numDims, npy_intp* shape, npy_intp* strides, const void* data, PyObject* owner){
+    // Empty arrays own their (empty) buffer
+    if(data == nullptr){
+        return PyArray_ZEROS(numDims, shape, typeNum, 0);
+    }
+    PyObject* values{PyArray_New(&PyArray_Type, numDims, shape, typeNum, strides, const_cast<void*>(data), 0, NPY_ARRAY_ALIGNED, nullptr)};
+    if(values == nullptr){
+        return nullptr;
+    }
+    Py_INCREF(owner);
+    if(PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(values), owner) < 0){
+        Py_DECREF(values);
+        return nullptr;
+    }
+    return values;
+}
+
+/**
+* @brief  Adds a read-only array of one field of every element of a view to arrays, pointing into the C++ buffer with the element
+*         size as stride. Returns false with a Python exception set on failure
+*/
+template<typename Field, typename T>
+static bool addFieldArray(PyObject* arrays, const char* name, const ArrayView<const T> view, Field T::* const member, PyObject* owner){
+    npy_intp shape[1]{static_cast<npy_intp>(view.size())};
+    npy_intp strides[1]{static_cast<npy_intp>(sizeof(T))};
+    const void* data{view.empty() ? nullptr : &(view.data()->*member)};
+    PyObject* values{newArrayView(numpyType<remove_const_t<Field>>(), 1, shape, strides, data, owner)};
+    if(values == nullptr){
+        return false;
+    }
+    const int result{PyDict_SetItemString(arrays, name, values)};
+    Py_DECREF(values);
+    return result == 0;
+}
+
+/**
+* @brief  Adds a read-only (entities x metrics) array of one field of the statistics of every metric of every entity to arrays
+*/
+template<size_t NumMetrics>
+static bool addStatisticArray(PyObject* arrays, const char* name, const vector<array<ReplicationStatistic, NumMetrics>>& statistics,
+                              double ReplicationStatistic::* const member, PyObject* owner){
+    npy_intp shape[2]{static_cast<npy_intp>(statistics.size()), static_cast<npy_intp>(NumMetrics)};
+    npy_intp strides[2]{static_cast<npy_intp>(sizeof(array<ReplicationStatistic, NumMetrics>)), static_cast<npy_intp>(sizeof(ReplicationStatistic))};
+    const void* data{statistics.empty() ? nullptr : &(statistics[0][0].*member)};
+    PyObject* values{newArrayView(NPY_DOUBLE, 2, shape, strides, data, owner)};
+    if(values == nullptr){
+        return false;
+    }
+    const int result{PyDict_SetItemString(arrays, name, values)};
+    Py_DECREF(values);
+    return result == 0;
+}
+
+/**
+* @brief  Returns the statistics of every metric of every entity as a dict of read-only (entities x metrics) arrays
+*/
+template<size_t NumMetrics>
+static PyObject* newStatisticArrays(const vector<array<ReplicationStatistic, NumMetrics>>& statistics, PyObject* owner){
+    PyObject* arrays{PyDict_New()};
+    if(arrays == nullptr
+        || !addStatisticArray(arrays, "mean", statistics, &ReplicationStatistic::mean, owner)
+        || !addStatisticArray(arrays, "std_dev", statistics, &ReplicationStatistic::stdDev, owner)
+        || !addStatisticArray(arrays, "confidence_half_width", statistics, &ReplicationStatistic::confidenceHalfWidth, owner)
+        || !addStatisticArray(arrays, "percentile_5", statistics, &ReplicationStatistic::percentile5, owner)
+        || !addStatisticArray(arrays, "median", statistics, &ReplicationStatistic::median, owner)
+        || !addStatisticArray(arrays, "percentile_95", statistics, &ReplicationStatistic::percentile95, owner)){
+        Py_XDECREF(arrays);
+        return nullptr;
+    }
+    return arrays;
+}
+
+/**
+* @brief  Parses the simulation parameters of a constructor from its keyword arguments. Returns false with a Python exception set if
+*         an argument is invalid
+*/
+static bool parseParameters(PyObject* kwargs, SimulationParameters& parameters){
+    static const char* keywords[]{"min_mining_duration_hrs", "max_mining_duration_hrs", "travel_duration_hrs", "unload_duration_min",
+                                  "simulation_time_hrs", "simulation_timestep_min", "engine", "seed", "replication", "fleet_image_file_name", nullptr};
+    PyObject* emptyArgs{PyTuple_New(0)};
+    if(emptyArgs == nullptr){
+        return false;
+    }
+    int engine{parameters.simulationEngine};
+    PyObject* seed{Py_None};
+    const char* fleetImageFileName{""};
+    const int parsed{PyArg_ParseTupleAndKeywords(emptyArgs, kwargs, "|$ffffddiOIs", const_cast<char**>(keywords),
+                        &parameters.minMiningDuration_hrs, &parameters.maxMiningDuration_hrs, &parameters.travelDuration_hrs,
+                        &parameters.unloadDuration_min, &parameters.simulationTime_hrs, &parameters.simulationTimestep_min, &engine, &seed,
+                        &parameters.replication, &fleetImageFileName)};
+    Py_DECREF(emptyArgs);
+    if(!parsed){
+        return false;
+    }
+    if(engine < SimulationEngines::FIXED_STEP || engine > SimulationEngines::ADAPTIVE_STEP){
+        PyErr_Format(PyExc_ValueError, "Invalid simulation engine %d", engine);
+        return false;
+    }
+    parameters.simulationEngine = static_cast<SimulationEngines>(engine);
+    parameters.fleetImageFileName = fleetImageFileName;
+
+    // Without a seed every simulation draws its own
+    if(seed == Py_None){
+        parameters.seed = random_device{}();
+    }
+    else{
+        parameters.seed = PyLong_AsUnsignedLongLong(seed);
+        if(PyErr_Occurred()){
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+* @brief  Parses the fleet size of a constructor. Returns false with a Python exception set if a count is negative
+*/
+static bool parseFleetSize(const Py_ssize_t numMiningTrucks, const Py_ssize_t numUnloadingStations, SimulationParameters& parameters){
+    if(numMiningTrucks < 0 || numUnloadingStations < 0){
+        PyErr_SetString(PyExc_ValueError, "Number of mining trucks and unloading stations must not be negative");
+        return false;
+    }
+    parameters.numMiningTrucks = static_cast<size_t>(numMiningTrucks);
+    parameters.numUnloadingStations = static_cast<size_t>(numUnloadingStations);
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Simulation
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+/**
+* @brief  Python object of a simulation. Calls on one simulation run one at a time, calls on different simulations run in parallel
+*/
+struct PySimulation{
+    PyObject_HEAD
+    Simulation* simulation;
+    mutex* simulationMutex;
+};
+
+static int PySimulation_init(PySimulation* self, PyObject* args, PyObject* kwargs){
+    Py_ssize_t numMiningTrucks{0};
+    Py_ssize_t numUnloadingStations{0};
+    if(!PyArg_ParseTuple(args, "nn", &numMiningTrucks, &numUnloadingStations)){
+        return -1;
+    }
+    SimulationParameters parameters{};
+    if(!parseFleetSize(numMiningTrucks, numUnloadingStations, parameters) || !parseParameters(kwargs, parameters)){
+        return -1;
+    }
+    if(self->simulation != nullptr){
+        PyErr_SetString(PyExc_RuntimeError, "Simulation is already initialized");
+        return -1;
+    }
+    try{
+        self->simulation = new Simulation(parameters);
+        self->simulationMutex = new mutex();
+    }
+    catch(const exception& exception){
+        PyErr_SetString(PyExc_RuntimeError, exception.what());
+        return -1;
+    }
+    return 0;
+}
+
+static void PySimulation_dealloc(PySimulation* self){
+    delete self->simulation;
+    delete self->simulationMutex;
+    Py_TYPE(self)->tp_free(reinterpret_cast<PyObject*>(self));
+}
+
+static PyObject* PySimulation_run(PySimulation* self, PyObject*){
+    if(!runReleasingGil(*self->simulationMutex, [self](){ self->simulation->run(); })){
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject* PySimulation_step(PySimulation* self, PyObject*){
+    if(!runReleasingGil(*self->simulationMutex, [self](){ self->simulation->step(); })){
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject* PySimulation_setNumThreads(PySimulation* self, PyObject* args){
+    Py_ssize_t numThreads{0};
+    if(!PyArg_ParseTuple(args, "n", &numThreads)){
+        return nullptr;
+    }
+    if(numThreads < 1){
+        PyErr_SetString(PyExc_ValueError, "Number of threads must be at least 1");
+        return nullptr;
+    }
+    unique_lock<mutex> lock{lockReleasingGil(*self->simulationMutex)};
+    self->simulation->setNumThreads(static_cast<size_t>(numThreads));
+    Py_RETURN_NONE;
+}
+
+static PyObject* PySimulation_setEngine(PySimulation* self, PyObject* args){
+    int engine{0};
+    if(!PyArg_ParseTuple(args, "i", &engine)){
+        return nullptr;
+    }
+    if(engine < SimulationEngines::FIXED_STEP || engine > SimulationEngines::ADAPTIVE_STEP){
+        PyErr_Format(PyExc_ValueError, "Invalid simulation engine %d", engine);
+        return nullptr;
+    }
+    unique_lock<mutex> lock{lockReleasingGil(*self->simulationMutex)};
+    self->simulation->setSimulationEngine(static_cast<SimulationEngines>(engine));
+    Py_RETURN_NONE;
+}
+
+static PyObject* PySimulation_trucks(PySimulation* self, PyObject*){
+    unique_lock<mutex> lock{lockReleasingGil(*self->simulationMutex)};
+    const ArrayView<const Truck> trucks{self->simulation->getMiningTrucksView()};
+    PyObject* owner{reinterpret_cast<PyObject*>(self)};
+    PyObject* arrays{PyDict_New()};
+    if(arrays == nullptr
+        || !addFieldArray(arrays, "id", trucks, &Truck::id, owner)
+        || !addFieldArray(arrays, "mining_cycle_duration", trucks, &Truck::miningCycleDuration, owner)
+        || !addFieldArray(arrays, "state", trucks, &Truck::state, owner)
+        || !addFieldArray(arrays, "time_until_next_state", trucks, &Truck::timeUntilNextState, owner)
+        || !addFieldArray(arrays, "is_loaded", trucks, &Truck::isLoaded, owner)
+        || !addFieldArray(arrays, "is_assigned_station", trucks, &Truck::isAssignedStation, owner)
+        || !addFieldArray(arrays, "num_travel_cycles", trucks, &Truck::numTravelCycles, owner)
+        || !addFieldArray(arrays, "num_mining_cycles", trucks, &Truck::numMiningCycles, owner)
+        || !addFieldArray(arrays, "num_unloads", trucks, &Truck::numUnloads, owner)){
+        Py_XDECREF(arrays);
+        return nullptr;
+    }
+    return arrays;
+}
+
+static PyObject* PySimulation_stations(PySimulation* self, PyObject*){
+    unique_lock<mutex> lock{lockReleasingGil(*self->simulationMutex)};
+    const ArrayView<const Station> stations{self->simulation->getUnloadingStationsView()};
+    PyObject* owner{reinterpret_cast<PyObject*>(self)};
+    PyObject* arrays{PyDict_New()};
+    if(arrays == nullptr
+        || !addFieldArray(arrays, "id", stations, &Station::id, owner)
+        || !addFieldArray(arrays, "state", stations, &Station::state, owner)
+        || !addFieldArray(arrays, "wait_time", stations, &Station::waitTime, owner)
+        || !addFieldArray(arrays, "num_vehicles_unloaded", stations, &Station::numVehiclesUnloaded, owner)){
+        Py_XDECREF(arrays);
+        return nullptr;
+    }
+    return arrays;
+}
+
+static PyObject* PySimulation_truckPerformances(PySimulation* self, PyObject*){
+    unique_lock<mutex> lock{lockReleasingGil(*self->simulationMutex)};
+    const ArrayView<const TruckPerformanceStats> performances{self->simulation->getMiningTruckPerformancesView()};
+    PyObject* owner{reinterpret_cast<PyObject*>(self)};
+    PyObject* arrays{PyDict_New()};
+    if(arrays == nullptr
+        || !addFieldArray(arrays, "vehicle_id", performances, &TruckPerformanceStats::vehicleId, owner)
+        || !addFieldArray(arrays, "percent_mining_time", performances, &TruckPerformanceStats::percentMiningTime, owner)
+        || !addFieldArray(arrays, "percent_travel_time", performances, &TruckPerformanceStats::percentTravelTime, owner)
+        || !addFieldArray(arrays, "percent_unloading_time", performances, &TruckPerformanceStats::percentUnloadingTime, owner)
+        || !addFieldArray(arrays, "percent_idle_time", performances, &TruckPerformanceStats::percentIdleTime, owner)
+        || !addFieldArray(arrays, "total_mining_time_hrs", performances, &TruckPerformanceStats::totalMiningTime_hrs, owner)
+        || !addFieldArray(arrays, "total_unloads", performances, &TruckPerformanceStats::totalUnloads, owner)){
+        Py_XDECREF(arrays);
+        return nullptr;
+    }
+    return arrays;
+}
+
+static PyObject* PySimulation_stationPerformances(PySimulation* self, PyObject*){
+    unique_lock<mutex> lock{lockReleasingGil(*self->simulationMutex)};
+    const ArrayView<const StationPerformanceStats> performances{self->simulation->getUnloadingStationPerformancesView()};
+    PyObject* owner{reinterpret_cast<PyObject*>(self)};
+    PyObject* arrays{PyDict_New()};
+    if(arrays == nullptr
+        || !addFieldArray(arrays, "station_id", performances, &StationPerformanceStats::stationId, owner)
+        || !addFieldArray(arrays, "total_unloads", performances, &StationPerformanceStats::totalUnloads, owner)
+        || !addFieldArray(arrays, "percent_unloading_time", performances, &StationPerformanceStats::percentUnloadingTime, owner)
+        || !addFieldArray(arrays, "percent_idle_time", performances, &StationPerformanceStats::percentIdleTime, owner)
+        || !addFieldArray(arrays, "total_unloading_time_hrs", performances, &StationPerformanceStats::totalUnloadingTime_hrs, owner)
+        || !addFieldArray(arrays, "total_idle_time_hrs", performances, &StationPerformanceStats::totalIdleTime_hrs, owner)){
+        Py_XDECREF(arrays);
+        return nullptr;
+    }
+    return arrays;
+}
+
+static PyObject* PySimulation_getSeed(PySimulation* self, void*){
+    return PyLong_FromUnsignedLongLong(self->simulation->getSeed());
+}
+
+static PyObject* PySimulation_getReplication(PySimulation* self, void*){
+    return PyLong_FromUnsignedLong(self->simulation->getReplication());
+}
+
+static PyMethodDef PySimulation_methods[]{
+    {"run", reinterpret_cast<PyCFunction>(PySimulation_run), METH_NOARGS, "Runs the full simulation to completion, without holding the GIL"},
+    {"step", reinterpret_cast<PyCFunction>(PySimulation_step), METH_NOARGS, "Advances the simulation by one time step, without holding the GIL"},
+    {"set_num_threads", reinterpret_cast<PyCFunction>(PySimulation_setNumThreads), METH_VARARGS, "Sets the number of threads updating the trucks"},
+    {"set_engine", reinterpret_cast<PyCFunction>(PySimulation_setEngine), METH_VARARGS, "Sets the engine used to run the simulation"},
+    {"trucks", reinterpret_cast<PyCFunction>(PySimulation_trucks), METH_NOARGS,
+        "Returns a dict of read-only arrays over the state of every truck (durations in ticks of one second)"},
+    {"stations", reinterpret_cast<PyCFunction>(PySimulation_stations), METH_NOARGS,
+        "Returns a dict of read-only arrays over the state of every unloading station (wait times in ticks of one second)"},
+    {"truck_performances", reinterpret_cast<PyCFunction>(PySimulation_truckPerformances), METH_NOARGS,
+        "Returns a dict of read-only arrays over the performance statistics of every truck"},
+    {"station_performances", reinterpret_cast<PyCFunction>(PySimulation_stationPerformances), METH_NOARGS,
+        "Returns a dict of read-only arrays over the performance statistics of every unloading station"},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+static PyGetSetDef PySimulation_getters[]{
+    {"seed", reinterpret_cast<getter>(PySimulation_getSeed), nullptr, "Seed of the random number generator", nullptr},
+    {"replication", reinterpret_cast<getter>(PySimulation_getReplication), nullptr, "Index of the replication of the seed", nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}
+};
+
+static PyTypeObject PySimulationType{PyVarObject_HEAD_INIT(nullptr, 0)};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// ReplicationRunner
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+/**
+* @brief  Python object of a replication runner. Calls on one runner run one at a time
+*/
+struct PyReplicationRunner{
+    PyObject_HEAD
+    ReplicationRunner* runner;
+    mutex* runnerMutex;
+};
+
+static int PyReplicationRunner_init(PyReplicationRunner* self, PyObject* args, PyObject* kwargs){
+    Py_ssize_t numMiningTrucks{0};
+    Py_ssize_t numUnloadingStations{0};
+    Py_ssize_t numReplications{0};
+    Py_ssize_t numThreads{0};
+    if(!PyArg_ParseTuple(args, "nnn|n", &numMiningTrucks, &numUnloadingStations, &numReplications, &numThreads)){
+        return -1;
+    }
+    SimulationParameters parameters{};
+    if(!parseFleetSize(numMiningTrucks, numUnloadingStations, parameters) || !parseParameters(kwargs, parameters)){
+        return -1;
+    }
+    if(numReplications < 0 || numThreads < 0){
+        PyErr_SetString(PyExc_ValueError, "Number of replications and threads must not be negative");
+        return -1;
+    }
+    if(self->runner != nullptr){
+        PyErr_SetString(PyExc_RuntimeError, "ReplicationRunner is already initialized");
+        return -1;
+    }
+    try{
+        // Without a number of threads every hardware thread runs replications
+        self->runner = numThreads > 0 ? new ReplicationRunner(parameters, static_cast<size_t>(numReplications), static_cast<size_t>(numThreads))
+                                      : new ReplicationRunner(parameters, static_cast<size_t>(numReplications));
+        self->runnerMutex = new mutex();
+    }
+    catch(const exception& exception){
+        PyErr_SetString(PyExc_RuntimeError, exception.what());
+        return -1;
+    }
+    return 0;
+}
+
+static void PyReplicationRunner_dealloc(PyReplicationRunner* self){
+    delete self->runner;
+    delete self->runnerMutex;
+    Py_TYPE(self)->tp_free(reinterpret_cast<PyObject*>(self));
+}
+
+static PyObject* PyReplicationRunner_run(PyReplicationRunner* self, PyObject*){
+    if(!runReleasingGil(*self->runnerMutex, [self](){ self->runner->run(); })){
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject* PyReplicationRunner_truckStatistics(PyReplicationRunner* self, PyObject*){
+    unique_lock<mutex> lock{lockReleasingGil(*self->runnerMutex)};
+    return newStatisticArrays(self->runner->getTruckStatistics(), reinterpret_cast<PyObject*>(self));
+}
+
+static PyObject* PyReplicationRunner_stationStatistics(PyReplicationRunner* self, PyObject*){
+    unique_lock<mutex> lock{lockReleasingGil(*self->runnerMutex)};
+    return newStatisticArrays(self->runner->getStationStatistics(), reinterpret_cast<PyObject*>(self));
+}
+
+static PyObject* PyReplicationRunner_getNumReplications(PyReplicationRunner* self, void*){
+    unique_lock<mutex> lock{lockReleasingGil(*self->runnerMutex)};
+    return PyLong_FromSize_t(self->runner->getNumReplications());
+}
+
+static PyMethodDef PyReplicationRunner_methods[]{
+    {"run", reinterpret_cast<PyCFunction>(PyReplicationRunner_run), METH_NOARGS,
+        "Runs replication i with the seed and replication index i, without holding the GIL"},
+    {"truck_statistics", reinterpret_cast<PyCFunction>(PyReplicationRunner_truckStatistics), METH_NOARGS,
+        "Returns a dict of read-only (trucks x metrics) arrays of every statistic, metrics ordered as TRUCK_METRIC_NAMES"},
+    {"station_statistics", reinterpret_cast<PyCFunction>(PyReplicationRunner_stationStatistics), METH_NOARGS,
+        "Returns a dict of read-only (stations x metrics) arrays of every statistic, metrics ordered as STATION_METRIC_NAMES"},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+static PyGetSetDef PyReplicationRunner_getters[]{
+    {"num_replications", reinterpret_cast<getter>(PyReplicationRunner_getNumReplications), nullptr,
+        "Number of replications aggregated by the last run", nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}
+};
+
+static PyTypeObject PyReplicationRunnerType{PyVarObject_HEAD_INIT(nullptr, 0)};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Module
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+/**
+* @brief  Returns a list of the names of metrics
+*/
+template<size_t NumMetrics>
+static PyObject* newNameList(const array<const char*, NumMetrics>& names){
+    PyObject* nameList{PyList_New(NumMetrics)};
+    for(size_t i = 0; nameList != nullptr && i < NumMetrics; i++){
+        PyObject* name{PyUnicode_FromString(names[i])};
+        if(name == nullptr){
+            Py_DECREF(nameList);
+            return nullptr;
+        }
+        PyList_SET_ITEM(nameList, i, name);
+    }
+    return nameList;
+}
+
+/**
+* @brief  Returns the SimulationEngine IntEnum of every simulation engine
+*/
+static PyObject* newEngineEnum(){
+    PyObject* enumModule{PyImport_ImportModule("enum")};
+    if(enumModule == nullptr){
+        return nullptr;
+    }
+    PyObject* engineEnum{PyObject_CallMethod(enumModule, "IntEnum", "s[(si)(si)(si)(si)(si)]", "SimulationEngine",
+                            "FIXED_STEP", SimulationEngines::FIXED_STEP, "DISCRETE_EVENT", SimulationEngines::DISCRETE_EVENT,
+                            "STRUCT_OF_ARRAYS", SimulationEngines::STRUCT_OF_ARRAYS, "TIMING_WHEEL", SimulationEngines::TIMING_WHEEL,
+                            "ADAPTIVE_STEP", SimulationEngines::ADAPTIVE_STEP)};
+    Py_DECREF(enumModule);
+    return engineEnum;
+}
+
+static PyModuleDef miningsimModule{
+    PyModuleDef_HEAD_INIT, "miningsim", "In-process mining truck simulations with zero-copy NumPy views of their state and results", -1,
+    nullptr, nullptr, nullptr, nullptr, nullptr
+};
+
+PyMODINIT_FUNC PyInit_miningsim(){
+    import_array();
+
+    PySimulationType.tp_name = "miningsim.Simulation";
+    PySimulationType.tp_doc = "Simulation(num_mining_trucks, num_unloading_stations, *, min_mining_duration_hrs=1, max_mining_duration_hrs=5, "
+                              "travel_duration_hrs=0.5, unload_duration_min=5, simulation_time_hrs=72, simulation_timestep_min=5, engine=FIXED_STEP, "
+                              "seed=None, replication=0, fleet_image_file_name='')\n\nArrays returned by the views point into the simulation and keep "
+                              "it alive. Truck and station arrays follow the state as the simulation runs, performance arrays are recomputed in place "
+                              "when read after more time steps were run";
+    PySimulationType.tp_basicsize = sizeof(PySimulation);
+    PySimulationType.tp_flags = Py_TPFLAGS_DEFAULT;
+    PySimulationType.tp_new = PyType_GenericNew;
+    PySimulationType.tp_init = reinterpret_cast<initproc>(PySimulation_init);
+    PySimulationType.tp_dealloc = reinterpret_cast<destructor>(PySimulation_dealloc);
+    PySimulationType.tp_methods = PySimulation_methods;
+    PySimulationType.tp_getset = PySimulation_getters;
+
+    PyReplicationRunnerType.tp_name = "miningsim.ReplicationRunner";
+    PyReplicationRunnerType.tp_doc = "ReplicationRunner(num_mining_trucks, num_unloading_stations, num_replications, num_threads=0, **parameters)\n\n"
+                                     "Takes the keyword parameters of Simulation, num_threads 0 runs on every hardware thread. Statistic arrays "
+                                     "keep their storage across runs, each run overwrites them in place";
+    PyReplicationRunnerType.tp_basicsize = sizeof(PyReplicationRunner);
+    PyReplicationRunnerType.tp_flags = Py_TPFLAGS_DEFAULT;
+    PyReplicationRunnerType.tp_new = PyType_GenericNew;
+    PyReplicationRunnerType.tp_init = reinterpret_cast<initproc>(PyReplicationRunner_init);
+    PyReplicationRunnerType.tp_dealloc = reinterpret_cast<destructor>(PyReplicationRunner_dealloc);
+    PyReplicationRunnerType.tp_methods = PyReplicationRunner_methods;
+    PyReplicationRunnerType.tp_getset = PyReplicationRunner_getters;
+
+    if(PyType_Ready(&PySimulationType) < 0 || PyType_Ready(&PyReplicationRunnerType) < 0){
+        return nullptr;
+    }
+    PyObject* module{PyModule_Create(&miningsimModule)};
+    if(module == nullptr){
+        return nullptr;
+    }
+    Py_INCREF(&PySimulationType);
+    Py_INCREF(&PyReplicationRunnerType);
+    if(PyModule_AddObject(module, "Simulation", reinterpret_cast<PyObject*>(&PySimulationType)) < 0
+        || PyModule_AddObject(module, "ReplicationRunner", reinterpret_cast<PyObject*>(&PyReplicationRunnerType)) < 0
+        || PyModule_AddObject(module, "SimulationEngine", newEngineEnum()) < 0
+        || PyModule_AddObject(module, "TRUCK_METRIC_NAMES", newNameList(TRUCK_METRIC_NAMES)) < 0
+        || PyModule_AddObject(module, "STATION_METRIC_NAMES", newNameList(STATION_METRIC_NAMES)) < 0){
+        Py_DECREF(module);
+        return nullptr;
+    }
+    return module;
+}
@@ -0,0 +1,57 @@
+#include <iostream>
+#include <array>
+#include <EventTrace.h>
+#include "spdlog/spdlog.h"
+
+using namespace std;
+using namespace spdlog;
+
+// Names of the trace event types
+static const array<const char*, 4> EVENT_NAMES{"Truck State Changed", "Station State Changed", "Truck Assigned", "Truck Unloaded"};
+
+// Names of the truck states
+static const array<const char*, 3> TRUCK_STATE_NAMES{"Mining", "Travel", "Unload"};
+
+// Names of the station states
+static const array<const char*, 2> STATION_STATE_NAMES{"Available", "Occupied"};
+
+/**
+* @brief  Returns the name of a truck or station state
+*/
+static const char* stateName(const uint8_t type, const uint8_t state){
+    if(type == TraceEventTypes::STATION_STATE_CHANGED){
+        return state < STATION_STATE_NAMES.size() ? STATION_STATE_NAMES[state] : "Unknown";
+    }
+    return state < TRUCK_STATE_NAMES.size() ? TRUCK_STATE_NAMES[state] : "Unknown";
+}
+
+int main(int argc, char* argv[])
+{
+    // Check if the user provided a trace file
+    if (argc != 2) {
+        error("Usage: {} <event_trace_file>\n", argv[0]);
+        return 1;
+    }
+
+    EventTraceReader traceReader(argv[1]);
+    if(!traceReader.isValid()){
+        return 1;
+    }
+    const EventTraceHeader& header{traceReader.getHeader()};
+
+    // Stream the trace one block at a time as CSV
+    cout << "Time (min),Event,Entity ID,From State,To State,Station ID\n";
+    EventTraceBlock block{};
+    while(traceReader.readBlock(block)){
+        for(size_t i = 0; i < block.size(); i++){
+            const uint8_t type{block.type[i]};
+            cout << header.startTime_min + block.timestep[i] * header.timestep_min << ","
+                    << (type < EVENT_NAMES.size() ? EVENT_NAMES[type] : "Unknown") << ","
+                    << block.entityId[i] << ","
+                    << stateName(type, block.fromState[i]) << ","
+                    << stateName(type, block.toState[i]) << ","
+                    << block.stationId[i] << "\n";
+        }
+    }
+    return traceReader.isValid() ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+#ifndef SIMULATION_TEST_HELPERS_H
+#define SIMULATION_TEST_HELPERS_H
+
+#include <gtest/gtest.h>
+#include <Simulation.h>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+/**
+* @brief  Returns the whole contents of a file, empty if it cannot be read
+*/
+inline string readFile(const string& fileName){
+    ifstream inFile(fileName, ios::binary);
+    stringstream contents{};
+    contents << inFile.rdbuf();
+    return contents.str();
+}
+
+/**
+* @brief  Verifies two simulations have identical truck and station states
+*/
+inline void expectSameState(Simulation& expectedSimulation, Simulation& simulation){
+    const vector<Truck> expectedTrucks{expectedSimulation.getMiningTrucks()};
+    const vector<Truck> trucks{simulation.getMiningTrucks()};
+    ASSERT_EQ(expectedTrucks.size(), trucks.size());
+    for(size_t i = 0; i < trucks.size(); i++){
+        EXPECT_EQ(expectedTrucks[i].miningCycleDuration, trucks[i].miningCycleDuration);
+        EXPECT_EQ(expectedTrucks[i].state, trucks[i].state);
+        EXPECT_EQ(expectedTrucks[i].timeUntilNextState, trucks[i].timeUntilNextState);
+        EXPECT_EQ(expectedTrucks[i].isLoaded, trucks[i].isLoaded);
+        EXPECT_EQ(expectedTrucks[i].isAssignedStation, trucks[i].isAssignedStation);
+        EXPECT_EQ(expectedTrucks[i].numMiningCycles, trucks[i].numMiningCycles);
+        EXPECT_EQ(expectedTrucks[i].numTravelCycles, trucks[i].numTravelCycles);
+        EXPECT_EQ(expectedTrucks[i].numUnloads, trucks[i].numUnloads);
+    }
+
+    const vector<Station> expectedStations{expectedSimulation.getUnloadingStations()};
+    const vector<Station> stations{simulation.getUnloadingStations()};
+    ASSERT_EQ(expectedStations.size(), stations.size());
+    for(size_t i = 0; i < stations.size(); i++){
+        EXPECT_EQ(expectedStations[i].state, stations[i].state);
+        EXPECT_EQ(expectedStations[i].waitTime, stations[i].waitTime);
+        EXPECT_EQ(expectedStations[i].vehicleIdQueue, stations[i].vehicleIdQueue);
+        EXPECT_EQ(expectedStations[i].numVehiclesUnloaded, stations[i].numVehiclesUnloaded);
+    }
+}
+
+/**
+* @brief  Verifies two simulations have identical truck and station performance statistics
+*/
+inline void expectSamePerformance(Simulation& expectedSimulation, Simulation& simulation){
+    const vector<TruckPerformanceStats> expectedTruckPerformances{expectedSimulation.getMiningTruckPerformances()};
+    const vector<TruckPerformanceStats> truckPerformances{simulation.getMiningTruckPerformances()};
+    ASSERT_EQ(expectedTruckPerformances.size(), truckPerformances.size());
+    for(size_t i = 0; i < truckPerformances.size(); i++){
+        EXPECT_EQ(expectedTruckPerformances[i].percentMiningTime, truckPerformances[i].percentMiningTime);
+        EXPECT_EQ(expectedTruckPerformances[i].percentTravelTime, truckPerformances[i].percentTravelTime);
+        EXPECT_EQ(expectedTruckPerformances[i].percentUnloadingTime, truckPerformances[i].percentUnloadingTime);
+        EXPECT_EQ(expectedTruckPerformances[i].percentIdleTime, truckPerformances[i].percentIdleTime);
+        EXPECT_EQ(expectedTruckPerformances[i].totalUnloads, truckPerformances[i].totalUnloads);
+    }
+
+    const vector<StationPerformanceStats> expectedStationPerformances{expectedSimulation.getUnloadingStationPerformances()};
+    const vector<StationPerformanceStats> stationPerformances{simulation.getUnloadingStationPerformances()};
+    ASSERT_EQ(expectedStationPerformances.size(), stationPerformances.size());
+    for(size_t i = 0; i < stationPerformances.size(); i++){
+        EXPECT_EQ(expectedStationPerformances[i].percentUnloadingTime, stationPerformances[i].percentUnloadingTime);
+        EXPECT_EQ(expectedStationPerformances[i].totalUnloads, stationPerformances[i].totalUnloads);
+    }
+}
+
+#endif // SIMULATION_TEST_HELPERS_H
@@ -11,16 +11,16 @@ TEST(MiningSimulationTests, TestMiningTrucksUpdate) {
     float maxMiningDuration_hrs{5};
     float travelDuration_hrs{0.5};
     float unloadDuration_min{5};
-    float simulationTimestep{5}; // minutes
-    float simulationTime{}; // minutes
+    const SimulationTicks simulationTimestep{minutesToTicks(5)};
+    SimulationTicks simulationTime{};
 
     // Initialize Mining Truck Processor
     MiningTrucksProcessor miningTrucksProcessor(numMiningTrucks, minMiningDuration_hrs, maxMiningDuration_hrs, travelDuration_hrs, unloadDuration_min);
 
     // Run Simulation for full mining time
-    const float miningCycleTime{miningTrucksProcessor.m_MiningTrucksList[0].miningCycleDuration};
+    const SimulationTicks miningCycleTime{miningTrucksProcessor.m_MiningTrucksList[0].miningCycleDuration};
     simulationTime = miningCycleTime;
-    float currentSimTime{};
+    SimulationTicks currentSimTime{};
     while(currentSimTime < simulationTime){
         EXPECT_EQ(miningTrucksProcessor.m_MiningTrucksList[0].state, TruckStates::MINING);        
         miningTrucksProcessor.updateMiningTrucks(simulationTimestep);
@@ -34,7 +34,7 @@ TEST(MiningSimulationTests, TestMiningTrucksUpdate) {
     EXPECT_TRUE(miningTrucksProcessor.m_MiningTrucksList[0].isLoaded);
 
     // Run simulation for travel time
-    simulationTime += travelDuration_hrs * 60;
+    simulationTime += hoursToTicks(travelDuration_hrs);
     while(currentSimTime < simulationTime){
         EXPECT_EQ(miningTrucksProcessor.m_MiningTrucksList[0].state, TruckStates::TRAVEL);
         miningTrucksProcessor.updateMiningTrucks(simulationTimestep);
@@ -73,7 +73,7 @@ TEST(MiningSimulationTests, TestMiningTrucksUpdate) {
     miningTrucksProcessor.m_MiningTrucksList[0].isLoaded = false;
 
     // Run simulation for unload time
-    simulationTime += unloadDuration_min;
+    simulationTime += minutesToTicks(unloadDuration_min);
     while(currentSimTime < simulationTime){
         EXPECT_EQ(miningTrucksProcessor.m_MiningTrucksList[0].state, TruckStates::UNLOAD);
         miningTrucksProcessor.updateMiningTrucks(simulationTimestep);
@@ -84,7 +84,7 @@ TEST(MiningSimulationTests, TestMiningTrucksUpdate) {
     EXPECT_EQ(miningTrucksProcessor.m_MiningTrucksList[0].state, TruckStates::TRAVEL);
 
      // Run simulation for travel time
-    simulationTime += travelDuration_hrs * 60;
+    simulationTime += hoursToTicks(travelDuration_hrs);
     while(currentSimTime < simulationTime){
         EXPECT_EQ(miningTrucksProcessor.m_MiningTrucksList[0].state, TruckStates::TRAVEL);
         miningTrucksProcessor.updateMiningTrucks(simulationTimestep);
@@ -98,11 +98,11 @@ TEST(MiningSimulationTests, TestMiningTrucksUpdate) {
     EXPECT_FALSE(miningTrucksProcessor.m_MiningTrucksList[0].isLoaded);
 
     // Verify number of travel cycles is accurate
-    EXPECT_EQ(miningTrucksProcessor.m_MiningTrucksList[0].numTravelCycles, ceil(2 * travelDuration_hrs * 60/simulationTimestep));
+    EXPECT_EQ(miningTrucksProcessor.m_MiningTrucksList[0].numTravelCycles, (2 * hoursToTicks(travelDuration_hrs) + simulationTimestep - 1) / simulationTimestep);
 
     // Verify number of unloading cycles is accurate
-    EXPECT_EQ(miningTrucksProcessor.m_MiningTrucksList[0].numUnloads, ceil(unloadDuration_min/simulationTimestep));
+    EXPECT_EQ(miningTrucksProcessor.m_MiningTrucksList[0].numUnloads, (minutesToTicks(unloadDuration_min) + simulationTimestep - 1) / simulationTimestep);
 
     // Verify number of mining cycles is accurate
-    EXPECT_EQ(miningTrucksProcessor.m_MiningTrucksList[0].numMiningCycles, ceil(miningCycleTime/simulationTimestep));
+    EXPECT_EQ(miningTrucksProcessor.m_MiningTrucksList[0].numMiningCycles, (miningCycleTime + simulationTimestep - 1) / simulationTimestep);
 }
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <Simulation.h>
+#include <FleetImage.h>
+#include <cmath>
+#include <cstdio>
+
+using namespace std;
+
+// Test case for drawing mining durations in batches
+TEST(MiningSimulationTests, TestBulkMiningTimesMatchPerTruckDraws) {
+    // Rounding without a library call matches llround, including halfway cases
+    for(double ticks : {0.0, 0.49999999999999994, 0.5, 1.5, 2.5, 3599.5, 1e12 + 0.5, -0.5, -1.5, -2.4}){
+        EXPECT_EQ(roundToTicks(ticks), llround(ticks));
+    }
+    for(uint32_t i = 0; i < 10000; i++){
+        const double hours{RandomStream::uniformFloat(5, 0, RandomStreams::MINING_DURATION, i, 0, 1, 5)};
+        ASSERT_EQ(hoursToTicks(hours), llround(hours * TICKS_PER_HOUR));
+    }
+
+    // Batches span partial batches and thread ranges, each truck keeps the duration of its own draw
+    const size_t numMiningTrucks{70000};
+    const vector<int> miningDurations{MiningTrucksProcessor::generateMiningTimes(numMiningTrucks, 1, 5, 5, 2, 3)};
+    ASSERT_EQ(miningDurations.size(), numMiningTrucks);
+    for(uint32_t i = 0; i < numMiningTrucks; i++){
+        const float miningDuration_hrs{RandomStream::uniformFloat(5, 2, RandomStreams::MINING_DURATION, i, 0, 1, 5)};
+        ASSERT_EQ(miningDurations[i], llround(static_cast<double>(miningDuration_hrs) * TICKS_PER_HOUR));
+    }
+
+    // Trucks are built from the durations in id order
+    const vector<Truck> miningTrucks{MiningTrucksProcessor::initMiningTrucks(miningDurations)};
+    ASSERT_EQ(miningTrucks.size(), numMiningTrucks);
+    EXPECT_EQ(miningTrucks.capacity(), numMiningTrucks);
+    for(size_t i = 0; i < numMiningTrucks; i += 997){
+        EXPECT_EQ(miningTrucks[i].id, i);
+        EXPECT_EQ(miningTrucks[i].miningCycleDuration, miningDurations[i]);
+        EXPECT_EQ(miningTrucks[i].timeUntilNextState, miningDurations[i]);
+    }
+}
+
+// Test case for loading mining durations from a fleet image
+TEST(MiningSimulationTests, TestFleetImage) {
+    const string fileName{testing::TempDir() + "MiningSimulationFleetImageTest.fleet"};
+    remove(fileName.c_str());
+    const size_t numMiningTrucks{5000};
+    const vector<int> expectedDurations{MiningTrucksProcessor::generateMiningTimes(numMiningTrucks, 1, 5, 11, 0)};
+
+    // A missing image is generated and written
+    const MiningTrucksProcessor writingProcessor(numMiningTrucks, 1, 5, 0.5, 5, 11, 0, fileName);
+    FleetImageHeader header{};
+    header.seed = 11;
+    header.numMiningTrucks = numMiningTrucks;
+    header.minMiningDuration_hrs = 1;
+    header.maxMiningDuration_hrs = 5;
+    vector<int> imageDurations{};
+    ASSERT_TRUE(FleetImage::read(fileName, header, imageDurations));
+    EXPECT_EQ(imageDurations, expectedDurations);
+
+    // The image is loaded in place of drawing the durations
+    imageDurations.assign(numMiningTrucks, 1234);
+    ASSERT_TRUE(FleetImage::write(fileName, header, imageDurations));
+    const MiningTrucksProcessor loadingProcessor(numMiningTrucks, 1, 5, 0.5, 5, 11, 0, fileName);
+    for(const Truck& truck : loadingProcessor.m_MiningTrucksList){
+        ASSERT_EQ(truck.miningCycleDuration, 1234);
+    }
+
+    // An image of other fleet parameters is not loaded, and is replaced
+    header.seed = 12;
+    EXPECT_FALSE(FleetImage::read(fileName, header, imageDurations));
+    EXPECT_TRUE(imageDurations.empty());
+    const MiningTrucksProcessor otherSeedProcessor(numMiningTrucks, 1, 5, 0.5, 5, 12, 0, fileName);
+    const vector<int> otherSeedDurations{MiningTrucksProcessor::generateMiningTimes(numMiningTrucks, 1, 5, 12, 0)};
+    for(size_t i = 0; i < numMiningTrucks; i++){
+        ASSERT_EQ(otherSeedProcessor.m_MiningTrucksList[i].miningCycleDuration, otherSeedDurations[i]);
+    }
+    ASSERT_TRUE(FleetImage::read(fileName, header, imageDurations));
+    EXPECT_EQ(imageDurations, otherSeedDurations);
+
+    // A simulation started from its fleet image has the same results as one drawing its durations
+    remove(fileName.c_str());
+    SimulationParameters parameters{};
+    parameters.numMiningTrucks = 50;
+    parameters.numUnloadingStations = 3;
+    parameters.simulationTime_hrs = 24;
+    parameters.seed = 11;
+    Simulation simulation(parameters);
+    simulation.run();
+    parameters.fleetImageFileName = fileName;
+    Simulation writingSimulation(parameters);
+    Simulation loadingSimulation(parameters);
+    loadingSimulation.run();
+    const vector<Truck> expectedTrucks{simulation.getMiningTrucks()};
+    const vector<Truck> loadedTrucks{loadingSimulation.getMiningTrucks()};
+    for(size_t i = 0; i < parameters.numMiningTrucks; i++){
+        EXPECT_EQ(loadedTrucks[i].miningCycleDuration, expectedTrucks[i].miningCycleDuration);
+        EXPECT_EQ(loadedTrucks[i].numUnloads, expectedTrucks[i].numUnloads);
+        EXPECT_EQ(loadedTrucks[i].timeUntilNextState, expectedTrucks[i].timeUntilNextState);
+    }
+    remove(fileName.c_str());
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <MiningTruckProcessor.h>
+#include <UnloadingStation.h>
+#include <StateMachine.h>
+
+using namespace std;
+
+// Transition tables are evaluated at compile time
+static_assert(TruckStateMachine::getTransition(TruckStates::MINING, 0).nextState == TruckStates::TRAVEL);
+static_assert(TruckStateMachine::getTransition(TruckStates::TRAVEL, 1).awaitingStation == 1);
+static_assert(TruckStateMachine::getTransition(TruckStates::UNLOAD, 1).counting == 0);
+static_assert(StationStateMachine::getTransition(UnloadingStationStates::AVAILABLE, 1).nextState == UnloadingStationStates::OCCUPIED);
+
+// Test case for the truck transition table describing the mining cycle
+TEST(MiningSimulationTests, TestTruckStateMachineCycle) {
+    // MINING -> TRAVEL (loaded) -> UNLOAD -> TRAVEL (unloaded) -> MINING, waiting for a station only before unloading
+    const vector<int> expectedStates{TruckStates::TRAVEL, TruckStates::UNLOAD, TruckStates::TRAVEL, TruckStates::MINING};
+    const vector<int> expectedDurations{STATE_TRAVEL_DURATION, STATE_UNLOAD_DURATION, STATE_TRAVEL_DURATION, STATE_MINING_DURATION};
+    int state{TruckStates::MINING};
+    int isLoaded{0};
+    for(size_t i = 0; i < expectedStates.size(); i++){
+        const TruckTransition& transition{TruckStateMachine::getTransition(state, isLoaded)};
+        EXPECT_EQ(transition.counting, 1);
+        EXPECT_EQ(transition.nextState, expectedStates[i]);
+        EXPECT_EQ(transition.nextDuration, expectedDurations[i]);
+        EXPECT_EQ(transition.awaitingStation, expectedStates[i] == TruckStates::UNLOAD ? 1 : 0);
+
+        // A truck unloads at its station before its unload countdown starts
+        state = transition.nextState;
+        isLoaded = state == TruckStates::UNLOAD ? 0 : transition.nextIsLoaded;
+    }
+    EXPECT_EQ(isLoaded, 0);
+
+    // Every counting row counts a cycle per time step
+    for(const TruckTransition& transition : TruckCyclePolicy::TRANSITIONS){
+        EXPECT_EQ(transition.cycleCount != NO_CYCLES, transition.counting == 1);
+    }
+
+    // The processor moves trucks through the table
+    MiningTrucksProcessor processor(1, 2, 2, 0.5, 5, 1);
+    Truck& truck{processor.m_MiningTrucksList[0]};
+    EXPECT_FALSE(processor.advanceTruckState(truck));
+    EXPECT_EQ(truck.state, TruckStates::TRAVEL);
+    EXPECT_TRUE(truck.isLoaded);
+    EXPECT_EQ(truck.timeUntilNextState, hoursToTicks(2) + hoursToTicks(0.5));
+    EXPECT_TRUE(processor.advanceTruckState(truck));
+    EXPECT_EQ(truck.state, TruckStates::UNLOAD);
+    EXPECT_FALSE(MiningTrucksProcessor::isTruckCounting(truck));
+}
+
+// Policy of a truck cycle with a refuelling stop after travel, described by its table alone
+struct RefuelCyclePolicy{
+    enum States { MINING, TRAVEL, REFUEL };
+    static constexpr size_t NUM_STATES{3};
+    static constexpr size_t NUM_CONDITIONS{2};
+    static constexpr array<TruckTransition, NUM_STATES * NUM_CONDITIONS> TRANSITIONS{{
+        {MINING, 0, 1, MINING_CYCLES, TRAVEL, 1, STATE_TRAVEL_DURATION, 0},
+        {MINING, 1, 1, MINING_CYCLES, TRAVEL, 1, STATE_TRAVEL_DURATION, 0},
+        {TRAVEL, 0, 1, TRAVEL_CYCLES, REFUEL, 0, STATE_UNLOAD_DURATION, 0},
+        {TRAVEL, 1, 1, TRAVEL_CYCLES, REFUEL, 0, STATE_UNLOAD_DURATION, 0},
+        {REFUEL, 0, 1, NO_CYCLES, MINING, 0, STATE_MINING_DURATION, 0},
+        {REFUEL, 1, 1, NO_CYCLES, MINING, 0, STATE_MINING_DURATION, 0},
+    }};
+};
+
+// Test case for the state machine core running a new cycle from its table
+TEST(MiningSimulationTests, TestStateMachineCustomPolicy) {
+    using RefuelStateMachine = StateMachine<RefuelCyclePolicy>;
+    static_assert(RefuelStateMachine::NUM_TRANSITIONS == 6);
+    static_assert(RefuelStateMachine::getTransitionIdx(RefuelCyclePolicy::REFUEL, 1) == 5);
+
+    int state{RefuelCyclePolicy::MINING};
+    int isLoaded{0};
+    vector<int> visitedStates{};
+    for(int i = 0; i < 6; i++){
+        const TruckTransition& transition{RefuelStateMachine::getTransition(state, isLoaded)};
+        state = transition.nextState;
+        isLoaded = transition.nextIsLoaded;
+        visitedStates.push_back(state);
+    }
+    EXPECT_EQ(visitedStates, (vector<int>{RefuelCyclePolicy::TRAVEL, RefuelCyclePolicy::REFUEL, RefuelCyclePolicy::MINING,
+                                           RefuelCyclePolicy::TRAVEL, RefuelCyclePolicy::REFUEL, RefuelCyclePolicy::MINING}));
+}
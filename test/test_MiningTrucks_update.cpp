@@ -4,7 +4,7 @@
 using namespace std;
 
 // Checks if all values in a vector are not the same
-bool allValuesNotSame(const vector<float>& vec) {
+bool allValuesNotSame(const vector<int>& vec) {
     // If vector is empty, return false
     if (vec.empty()){
         return false;
@@ -31,7 +31,7 @@ TEST(MiningSimulationTests, TestMiningTrucksInit) {
     EXPECT_EQ(miningTrucksProcessor.m_MiningTrucksList.size(), numMiningTrucks);
 
     // Check truck initializations are as expected
-    vector<float> miningTimes{};
+    vector<int> miningTimes{};
     for(int i = 0; i < numMiningTrucks; i++){
         Truck truck{miningTrucksProcessor.m_MiningTrucksList[i]};
 
@@ -50,11 +50,11 @@ TEST(MiningSimulationTests, TestMiningTrucksInit) {
         EXPECT_FALSE(truck.isLoaded);
         EXPECT_FALSE(truck.isAssignedStation);
 
-        // Expect mining time is greater or equal to 1 hr = 60 min
-        EXPECT_GE(truck.miningCycleDuration, 60);
+        // Expect mining time is greater or equal to 1 hr = 3600 ticks
+        EXPECT_GE(truck.miningCycleDuration, hoursToTicks(1));
 
-        // Expect mining time is less or equal to 5 hr = 5 * 60 min
-        EXPECT_LE(truck.miningCycleDuration, 5*60);
+        // Expect mining time is less or equal to 5 hr = 5 * 3600 ticks
+        EXPECT_LE(truck.miningCycleDuration, hoursToTicks(5));
         
         // Expect time until next state is equal to mining time
         EXPECT_EQ(truck.miningCycleDuration, truck.timeUntilNextState);
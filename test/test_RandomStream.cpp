@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+#include <RandomStream.h>
+#include <MiningTruckProcessor.h>
+
+using namespace std;
+
+// Test case for the counter-based random number generator
+TEST(MiningSimulationTests, TestRandomStream) {
+    // Verify Philox4x32-10 known answer tests (Random123)
+    const array<uint32_t, 4> zeroResult{RandomStream::philox4x32({0, 0, 0, 0}, {0, 0})};
+    EXPECT_EQ(zeroResult, (array<uint32_t, 4>{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    const array<uint32_t, 4> onesResult{RandomStream::philox4x32({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff})};
+    EXPECT_EQ(onesResult, (array<uint32_t, 4>{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+    const array<uint32_t, 4> piResult{RandomStream::philox4x32({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0})};
+    EXPECT_EQ(piResult, (array<uint32_t, 4>{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+
+    // Verify uniform floats stay within range
+    for(uint32_t i = 0; i < 10000; i++){
+        const float value{RandomStream::uniformFloat(42, 0, RandomStreams::MINING_DURATION, i, 0, 1, 5)};
+        ASSERT_GE(value, 1);
+        ASSERT_LT(value, 5);
+    }
+
+    // Verify fleet initialization is bit-identical at any thread count
+    const size_t numMiningTrucks{100000};
+    const vector<Truck> serialTrucks{MiningTrucksProcessor::initMiningTrucks(numMiningTrucks, 1, 5, 42, 0, 1)};
+    const vector<Truck> parallelTrucks{MiningTrucksProcessor::initMiningTrucks(numMiningTrucks, 1, 5, 42, 0, 8)};
+    for(size_t i = 0; i < numMiningTrucks; i++){
+        ASSERT_EQ(serialTrucks[i].miningCycleDuration, parallelTrucks[i].miningCycleDuration);
+    }
+}
@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include <Simulation.h>
+#include <SimulationTestHelpers.h>
+#include <cstdio>
+
+using namespace std;
+
+// Test case for the event trace of the adaptive-step engine, and for runs continuing from fixed-step time steps
+TEST(MiningSimulationTests, TestSimulationAdaptiveStepEventTraceAndSteps) {
+    const string structOfArraysFileName{testing::TempDir() + "MiningSimulationAdaptiveStep_structOfArrays.trace"};
+    const string adaptiveStepFileName{testing::TempDir() + "MiningSimulationAdaptiveStep_adaptiveStep.trace"};
+
+    // The skipped time steps have no events, so the traces of both engines are identical
+    Simulation structOfArraysSimulation(4, 2, 10, 30, 0.5, 5, 300, 5, SimulationEngines::STRUCT_OF_ARRAYS, 23);
+    Simulation adaptiveStepSimulation{structOfArraysSimulation};
+    adaptiveStepSimulation.setSimulationEngine(SimulationEngines::ADAPTIVE_STEP);
+    structOfArraysSimulation.setEventTraceFileName(structOfArraysFileName);
+    adaptiveStepSimulation.setEventTraceFileName(adaptiveStepFileName);
+    structOfArraysSimulation.run();
+    adaptiveStepSimulation.run();
+    const string structOfArraysTrace{readFile(structOfArraysFileName)};
+    EXPECT_FALSE(structOfArraysTrace.empty());
+    EXPECT_EQ(structOfArraysTrace, readFile(adaptiveStepFileName));
+    remove(structOfArraysFileName.c_str());
+    remove(adaptiveStepFileName.c_str());
+
+    // Stepping the first time steps with the fixed-step engine before jumping over the rest matches a run of one engine
+    Simulation fixedStepSimulation(4, 2, 10, 30, 0.5, 5, 300, 5, SimulationEngines::FIXED_STEP, 23);
+    Simulation steppedSimulation{fixedStepSimulation};
+    for(int i = 0; i < 100; i++){
+        steppedSimulation.step();
+    }
+    steppedSimulation.setSimulationEngine(SimulationEngines::ADAPTIVE_STEP);
+    steppedSimulation.run();
+    fixedStepSimulation.run();
+    expectSameState(fixedStepSimulation, steppedSimulation);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <Simulation.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+
+// Counts heap allocations made while counting is enabled
+static atomic<bool> g_CountAllocations{false};
+static atomic<size_t> g_NumAllocations{0};
+
+// Replace global allocation functions of the test executable with counting versions
+void* operator new(size_t size){
+    if(g_CountAllocations.load(memory_order_relaxed)){
+        g_NumAllocations.fetch_add(1, memory_order_relaxed);
+    }
+    void* ptr{malloc(size == 0 ? 1 : size)};
+    if(ptr == nullptr){
+        throw bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size){
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept{
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept{
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept{
+    free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept{
+    free(ptr);
+}
+
+// Test case for steady-state simulation steps not allocating memory
+TEST(MiningSimulationTests, TestSimulationStepDoesNotAllocate) {
+    // Declare constants
+    const size_t numUnloadingStations{20};
+    const size_t numMiningVehicles{2000};
+    const int numWarmupSteps{2016};     // One week of 5 minute time steps, long enough for every station queue to reach its longest length
+    const int numSteps{2016};
+
+    Simulation simulation(numMiningVehicles, numUnloadingStations, 1, 5, 0.5, 5, 72, 5, SimulationEngines::FIXED_STEP, 4);
+
+    // Warm up until reusable buffers have grown to their steady-state size
+    for(int i = 0; i < numWarmupSteps; i++){
+        simulation.step();
+    }
+
+    // Count allocations of steady-state steps
+    g_NumAllocations = 0;
+    g_CountAllocations = true;
+    for(int i = 0; i < numSteps; i++){
+        simulation.step();
+    }
+    g_CountAllocations = false;
+    EXPECT_EQ(g_NumAllocations, 0);
+
+    // Steps kept simulating trucks and stations
+    size_t numUnloads{0};
+    for(const Station& station : simulation.getUnloadingStations()){
+        numUnloads += station.numVehiclesUnloaded;
+    }
+    EXPECT_GT(numUnloads, 0);
+
+    // Counting allocator does count allocations
+    g_CountAllocations = true;
+    vector<int>* allocatedVector{new vector<int>(10)};
+    g_CountAllocations = false;
+    delete allocatedVector;
+    EXPECT_EQ(g_NumAllocations, 2);
+}
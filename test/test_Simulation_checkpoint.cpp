@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include <Simulation.h>
+#include <SimulationCheckpoint.h>
+#include <SimulationTestHelpers.h>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+using namespace std;
+
+// Test case for resuming a simulation from a checkpoint
+TEST(MiningSimulationTests, TestSimulationCheckpointResumeMatchesFullRun) {
+    // Declare constants
+    const size_t numUnloadingStations{3};
+    const size_t numMiningVehicles{60};
+    const float travelDuration_hrs{0.5};
+    const float unloadDuration_min{5};
+    const float minMiningDuration_hrs{1};
+    const float maxMiningDuration_hrs{5};
+    const float simulationTimestep{5}; // minutes
+    const uint64_t seed{7};
+    const string checkpointFileName{testing::TempDir() + "MiningSimulationCheckpoint.chkpt"};
+
+    // Run the full 72 hours in one go
+    Simulation fullSimulation(numMiningVehicles, numUnloadingStations, minMiningDuration_hrs, maxMiningDuration_hrs, travelDuration_hrs,
+                                unloadDuration_min, 72, simulationTimestep, SimulationEngines::FIXED_STEP, seed);
+    fullSimulation.run();
+
+    // Run the first 24 hours and save a checkpoint
+    Simulation warmupSimulation(numMiningVehicles, numUnloadingStations, minMiningDuration_hrs, maxMiningDuration_hrs, travelDuration_hrs,
+                                unloadDuration_min, 24, simulationTimestep, SimulationEngines::FIXED_STEP, seed);
+    warmupSimulation.run();
+    ASSERT_TRUE(warmupSimulation.saveCheckpoint(checkpointFileName));
+
+    // Resume the remaining 48 hours with each engine from a simulation with a different seed
+    for(SimulationEngines engine : {SimulationEngines::FIXED_STEP, SimulationEngines::DISCRETE_EVENT, SimulationEngines::STRUCT_OF_ARRAYS, SimulationEngines::TIMING_WHEEL,
+                                     SimulationEngines::ADAPTIVE_STEP}){
+        Simulation resumedSimulation(numMiningVehicles, numUnloadingStations, minMiningDuration_hrs, maxMiningDuration_hrs, travelDuration_hrs,
+                                    unloadDuration_min, 72, simulationTimestep, engine, seed + 1);
+        ASSERT_TRUE(resumedSimulation.restoreCheckpoint(checkpointFileName));
+        resumedSimulation.run();
+        expectSameState(fullSimulation, resumedSimulation);
+    }
+
+    remove(checkpointFileName.c_str());
+}
+
+// Test case for forking several experiments from one checkpoint
+TEST(MiningSimulationTests, TestSimulationCheckpointForksAreIdentical) {
+    const string checkpointFileName{testing::TempDir() + "MiningSimulationCheckpointFork.chkpt"};
+
+    // Warm up and save a checkpoint
+    Simulation warmupSimulation(25, 2, 1, 5, 0.5, 5, 12, 5, SimulationEngines::FIXED_STEP, 11);
+    warmupSimulation.run();
+    ASSERT_TRUE(warmupSimulation.saveCheckpoint(checkpointFileName));
+
+    // Fork two experiments from the checkpoint
+    Simulation firstFork(25, 2, 1, 5, 0.5, 5, 48, 5);
+    Simulation secondFork(25, 2, 1, 5, 0.5, 5, 48, 5);
+    ASSERT_TRUE(firstFork.restoreCheckpoint(checkpointFileName));
+    ASSERT_TRUE(secondFork.restoreCheckpoint(checkpointFileName));
+
+    // Restored state matches the checkpointed state, and both forks run identically
+    expectSameState(warmupSimulation, firstFork);
+    firstFork.run();
+    secondFork.run();
+    expectSameState(firstFork, secondFork);
+
+    remove(checkpointFileName.c_str());
+}
+
+// Test case for rejecting invalid checkpoints
+TEST(MiningSimulationTests, TestSimulationCheckpointRejectsInvalidFiles) {
+    const string checkpointFileName{testing::TempDir() + "MiningSimulationCheckpointInvalid.chkpt"};
+    Simulation simulation(10, 2, 1, 5, 0.5, 5, 12, 5, SimulationEngines::FIXED_STEP, 3);
+    simulation.run();
+    ASSERT_TRUE(simulation.saveCheckpoint(checkpointFileName));
+
+    // Fleet size must match
+    Simulation largerSimulation(11, 2, 1, 5, 0.5, 5, 12, 5, SimulationEngines::FIXED_STEP, 5);
+    EXPECT_FALSE(largerSimulation.restoreCheckpoint(checkpointFileName));
+    Simulation smallerSimulation(10, 1, 1, 5, 0.5, 5, 12, 5);
+    EXPECT_FALSE(smallerSimulation.restoreCheckpoint(checkpointFileName));
+
+    // Failed restore leaves the simulation unchanged
+    Simulation unchangedSimulation(11, 2, 1, 5, 0.5, 5, 12, 5, SimulationEngines::FIXED_STEP, 5);
+    expectSameState(unchangedSimulation, largerSimulation);
+
+    // Missing, truncated and unknown-version files are rejected
+    EXPECT_FALSE(simulation.restoreCheckpoint(checkpointFileName + ".missing"));
+    {
+        ofstream truncatedFile(checkpointFileName, ios::binary | ios::trunc);
+        CheckpointHeader header{};
+        truncatedFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    EXPECT_FALSE(simulation.restoreCheckpoint(checkpointFileName));
+    {
+        ofstream futureFile(checkpointFileName, ios::binary | ios::trunc);
+        CheckpointHeader header{};
+        header.version = CheckpointHeader{}.version + 1;
+        futureFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    EXPECT_FALSE(simulation.restoreCheckpoint(checkpointFileName));
+
+    // Version 1 checkpoints stored the simulation time as a float and are rejected
+    ASSERT_TRUE(simulation.saveCheckpoint(checkpointFileName));
+    const string bytes{readFile(checkpointFileName)};
+    {
+        CheckpointHeader header{};
+        header.version = 1;
+        const float simulationTime_hrs{12.0f};
+        ofstream versionOneFile(checkpointFileName, ios::binary | ios::trunc);
+        versionOneFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        versionOneFile.write(reinterpret_cast<const char*>(&simulationTime_hrs), sizeof(simulationTime_hrs));
+        versionOneFile.write(bytes.data() + sizeof(CheckpointHeader) + sizeof(SimulationTicks),
+                             bytes.size() - sizeof(CheckpointHeader) - sizeof(SimulationTicks));
+    }
+    Simulation versionOneSimulation(10, 2, 1, 5, 0.5, 5, 12, 5, SimulationEngines::FIXED_STEP, 5);
+    EXPECT_FALSE(versionOneSimulation.restoreCheckpoint(checkpointFileName));
+    Simulation unchangedVersionOneSimulation(10, 2, 1, 5, 0.5, 5, 12, 5, SimulationEngines::FIXED_STEP, 5);
+    expectSameState(unchangedVersionOneSimulation, versionOneSimulation);
+
+    remove(checkpointFileName.c_str());
+}
+
+// Writes a copy of a checkpoint with one value overwritten at a byte offset
+template<typename T>
+static void writeCorruptCheckpoint(const string& bytes, const size_t offset, const T value, const string& fileName){
+    string corruptBytes{bytes};
+    memcpy(&corruptBytes[offset], &value, sizeof(T));
+    ofstream corruptFile(fileName, ios::binary | ios::trunc);
+    corruptFile.write(corruptBytes.data(), corruptBytes.size());
+}
+
+// Test case for rejecting checkpoints with corrupt truck and station states
+TEST(MiningSimulationTests, TestSimulationCheckpointRejectsCorruptStates) {
+    const string checkpointFileName{testing::TempDir() + "MiningSimulationCheckpointCorrupt.chkpt"};
+    const string corruptFileName{checkpointFileName + ".corrupt"};
+    const size_t numMiningVehicles{10};
+    const size_t numUnloadingStations{2};
+    Simulation simulation(numMiningVehicles, numUnloadingStations, 1, 5, 0.5, 5, 12, 5, SimulationEngines::FIXED_STEP, 3);
+    simulation.run();
+    ASSERT_TRUE(simulation.saveCheckpoint(checkpointFileName));
+    const string bytes{readFile(checkpointFileName)};
+
+    // Byte offsets of the first value of the arrays, in the order saveCheckpoint writes them
+    const size_t arraySize{sizeof(uint64_t)};
+    const size_t truckArray{arraySize + numMiningVehicles * sizeof(int32_t)};
+    const size_t truckFlagArray{arraySize + numMiningVehicles * sizeof(uint8_t)};
+    const size_t stationArray{arraySize + numUnloadingStations * sizeof(int32_t)};
+    const size_t truckStatesOffset{sizeof(CheckpointHeader) + sizeof(SimulationTicks) + sizeof(uint64_t) + sizeof(uint32_t) + truckArray + arraySize};
+    const size_t timesUntilNextStateOffset{truckStatesOffset + truckArray};
+    const size_t stationStatesOffset{timesUntilNextStateOffset + 4 * truckArray + 2 * truckFlagArray};
+    const size_t queueSizesOffset{stationStatesOffset + 3 * stationArray};
+
+    // The unmodified copy restores
+    Simulation restoredSimulation(numMiningVehicles, numUnloadingStations, 1, 5, 0.5, 5, 12, 5, SimulationEngines::FIXED_STEP, 5);
+    writeCorruptCheckpoint(bytes, truckStatesOffset, static_cast<int32_t>(simulation.getMiningTrucks()[0].state), corruptFileName);
+    ASSERT_TRUE(restoredSimulation.restoreCheckpoint(corruptFileName));
+    expectSameState(simulation, restoredSimulation);
+
+    // Out of range states, negative countdowns and overflowing queue sizes are rejected and leave the simulation unchanged
+    Simulation corruptSimulation(numMiningVehicles, numUnloadingStations, 1, 5, 0.5, 5, 12, 5, SimulationEngines::FIXED_STEP, 5);
+    writeCorruptCheckpoint(bytes, truckStatesOffset, static_cast<int32_t>(TruckStateMachine::NUM_STATES), corruptFileName);
+    EXPECT_FALSE(corruptSimulation.restoreCheckpoint(corruptFileName));
+    writeCorruptCheckpoint(bytes, truckStatesOffset, int32_t{-1}, corruptFileName);
+    EXPECT_FALSE(corruptSimulation.restoreCheckpoint(corruptFileName));
+    writeCorruptCheckpoint(bytes, timesUntilNextStateOffset, int32_t{-1}, corruptFileName);
+    EXPECT_FALSE(corruptSimulation.restoreCheckpoint(corruptFileName));
+    writeCorruptCheckpoint(bytes, stationStatesOffset, static_cast<int32_t>(StationStateMachine::NUM_STATES), corruptFileName);
+    EXPECT_FALSE(corruptSimulation.restoreCheckpoint(corruptFileName));
+    writeCorruptCheckpoint(bytes, queueSizesOffset, numeric_limits<uint64_t>::max(), corruptFileName);
+    EXPECT_FALSE(corruptSimulation.restoreCheckpoint(corruptFileName));
+    Simulation unchangedSimulation(numMiningVehicles, numUnloadingStations, 1, 5, 0.5, 5, 12, 5, SimulationEngines::FIXED_STEP, 5);
+    expectSameState(unchangedSimulation, corruptSimulation);
+
+    remove(checkpointFileName.c_str());
+    remove(corruptFileName.c_str());
+}
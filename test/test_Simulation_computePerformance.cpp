@@ -63,4 +63,54 @@ TEST(MiningSimulationTests, TestSimulationComputePerformance) {
     EXPECT_FLOAT_EQ(computedTruckPerformance[0].percentMiningTime, truckPercentMining );
     EXPECT_FLOAT_EQ(computedTruckPerformance[0].totalMiningTime_hrs, truckTotalMining_hrs );
     EXPECT_EQ(computedTruckPerformance[0].totalUnloads, truckTotalUnloads);
-}
\ No newline at end of file
+}
+
+// Test case for performance statistics being computed lazily, once per change, without duplicates
+TEST(MiningSimulationTests, TestSimulationPerformanceStatsAreLazy) {
+    const size_t numMiningVehicles{30};
+    const size_t numUnloadingStations{2};
+    Simulation miningSimulation(numMiningVehicles, numUnloadingStations, 1, 5, 0.5, 5, 24, 5, SimulationEngines::FIXED_STEP, 8);
+
+    // Repeated computes replace the statistics in place
+    miningSimulation.run();
+    miningSimulation.computePerformanceStats();
+    const TruckPerformanceStats* truckStatsData{miningSimulation.getMiningTruckPerformances().data()};
+    miningSimulation.computePerformanceStats();
+    EXPECT_EQ(miningSimulation.getMiningTruckPerformances().size(), numMiningVehicles);
+    EXPECT_EQ(miningSimulation.getUnloadingStationPerformances().size(), numUnloadingStations);
+    EXPECT_EQ(miningSimulation.getMiningTruckPerformances().data(), truckStatsData);
+
+    // Views share the storage of the simulation
+    const ArrayView<const TruckPerformanceStats> truckStats{miningSimulation.getMiningTruckPerformancesView()};
+    EXPECT_EQ(truckStats.data(), truckStatsData);
+    EXPECT_EQ(truckStats.size(), numMiningVehicles);
+    const ArrayView<const Truck> trucks{miningSimulation.getMiningTrucksView()};
+    EXPECT_EQ(trucks.data(), miningSimulation.getMiningTrucks().data());
+    EXPECT_EQ(trucks.subview(25, 10).size(), size_t{5});
+    EXPECT_EQ(trucks.subview(25, 10)[0].id, 25);
+    EXPECT_TRUE(trucks.subview(40, 1).empty());
+    const ArrayView<const Station> stations{miningSimulation.getUnloadingStationsView()};
+    ASSERT_EQ(stations.size(), numUnloadingStations);
+    float numUnloads{0};
+    for(const StationPerformanceStats& stats : miningSimulation.getUnloadingStationPerformancesView()){
+        EXPECT_EQ(stats.totalUnloads, stations[stats.stationId].numVehiclesUnloaded);
+        numUnloads += stats.totalUnloads;
+    }
+
+    // Statistics queried mid-run follow the time steps run since they were computed
+    Simulation steppedSimulation(numMiningVehicles, numUnloadingStations, 1, 5, 0.5, 5, 24, 5, SimulationEngines::FIXED_STEP, 8);
+    EXPECT_EQ(steppedSimulation.getMiningTruckPerformances()[0].totalMiningTime_hrs, 0);
+    for(int i = 0; i < 289; i++){
+        steppedSimulation.step();
+        float steppedNumUnloads{0};
+        for(const StationPerformanceStats& stats : steppedSimulation.getUnloadingStationPerformancesView()){
+            steppedNumUnloads += stats.totalUnloads;
+        }
+        EXPECT_FLOAT_EQ(steppedSimulation.getMiningTruckPerformancesView()[0].totalMiningTime_hrs,
+                  ticksToHours(static_cast<SimulationTicks>(steppedSimulation.getMiningTrucks()[0].numMiningCycles) * minutesToTicks(5)));
+        if(i == 288){
+            EXPECT_EQ(steppedNumUnloads, numUnloads);
+        }
+    }
+    EXPECT_EQ(steppedSimulation.getMiningTruckPerformances().size(), numMiningVehicles);
+}
@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include <Simulation.h>
+#include <SimulationTestHelpers.h>
+
+using namespace std;
+
+/**
+* @class MiningSimulationEngineTests
+* @brief Runs each test once per simulation engine other than the fixed-step engine
+*/
+class MiningSimulationEngineTests : public testing::TestWithParam<SimulationEngines> {};
+
+// Test case for every engine matching the fixed-step engine
+TEST_P(MiningSimulationEngineTests, TestSimulationEngineMatchesFixedStep) {
+    // Fleets not a multiple of the vector width, horizons past the first timing wheel level, sparse fleets with long mining cycles
+    // that skip most time steps, busy fleets that skip none, time steps longer than the unload duration and an empty horizon
+    struct Configuration{
+        size_t numMiningVehicles;
+        size_t numUnloadingStations;
+        float maxMiningDuration_hrs;
+        double simulationTime_hrs;
+        double simulationTimestep_min;
+    };
+    for(const Configuration& configuration : {Configuration{40, 3, 5, 72, 5}, Configuration{53, 3, 5, 72, 5}, Configuration{200, 4, 5, 500, 1},
+                                                Configuration{25, 2, 5, 48, 7.5}, Configuration{60, 20, 5, 24, 0.5}, Configuration{3, 1, 40, 500, 5},
+                                                Configuration{10, 2, 24, 200, 1}, Configuration{5, 2, 20, 100, 7.5}, Configuration{1, 1, 5, 0, 5}}){
+        // Copy the fixed-step simulation so both engines start with identical trucks
+        Simulation fixedStepSimulation(configuration.numMiningVehicles, configuration.numUnloadingStations, 1, configuration.maxMiningDuration_hrs,
+                                        0.5, 5, configuration.simulationTime_hrs, configuration.simulationTimestep_min, SimulationEngines::FIXED_STEP, 13);
+        Simulation engineSimulation{fixedStepSimulation};
+        engineSimulation.setSimulationEngine(GetParam());
+        fixedStepSimulation.run();
+        engineSimulation.run();
+
+        // Percentages of an empty horizon are undefined
+        expectSameState(fixedStepSimulation, engineSimulation);
+        if(configuration.simulationTime_hrs > 0){
+            expectSamePerformance(fixedStepSimulation, engineSimulation);
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(MiningSimulationTests, MiningSimulationEngineTests,
+                         testing::Values(SimulationEngines::DISCRETE_EVENT, SimulationEngines::STRUCT_OF_ARRAYS, SimulationEngines::TIMING_WHEEL,
+                                         SimulationEngines::ADAPTIVE_STEP));
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <Simulation.h>
+#include <EventTrace.h>
+
+using namespace std;
+
+// Reads every event of a trace file into one block
+EventTraceBlock readEventTrace(const string& fileName, EventTraceHeader& header, size_t& numBlocks) {
+    EventTraceReader traceReader(fileName);
+    EXPECT_TRUE(traceReader.isValid());
+    header = traceReader.getHeader();
+
+    EventTraceBlock events{};
+    EventTraceBlock block{};
+    numBlocks = 0;
+    while(traceReader.readBlock(block)){
+        events.timestep.insert(events.timestep.end(), block.timestep.begin(), block.timestep.end());
+        events.entityId.insert(events.entityId.end(), block.entityId.begin(), block.entityId.end());
+        events.stationId.insert(events.stationId.end(), block.stationId.begin(), block.stationId.end());
+        events.type.insert(events.type.end(), block.type.begin(), block.type.end());
+        events.fromState.insert(events.fromState.end(), block.fromState.begin(), block.fromState.end());
+        events.toState.insert(events.toState.end(), block.toState.begin(), block.toState.end());
+        numBlocks++;
+    }
+    EXPECT_TRUE(traceReader.isValid());
+    return events;
+}
+
+// Test case for the event trace
+TEST(MiningSimulationTests, TestSimulationEventTrace) {
+    // Declare constants (enough trucks to fill several trace blocks)
+    SimulationParameters parameters{};
+    parameters.numMiningTrucks = 4000;
+    parameters.numUnloadingStations = 150;
+    parameters.seed = 3;
+    const string fixedStepFileName{(filesystem::temp_directory_path() / "MiningSimulationTest_fixedStep.trace").string()};
+    const string discreteEventFileName{(filesystem::temp_directory_path() / "MiningSimulationTest_discreteEvent.trace").string()};
+    const string structOfArraysFileName{(filesystem::temp_directory_path() / "MiningSimulationTest_structOfArrays.trace").string()};
+
+    // Run fixed-step and discrete-event simulations with tracing
+    Simulation fixedStepSimulation(parameters);
+    fixedStepSimulation.setEventTraceFileName(fixedStepFileName);
+    fixedStepSimulation.run();
+    parameters.simulationEngine = SimulationEngines::DISCRETE_EVENT;
+    Simulation discreteEventSimulation(parameters);
+    discreteEventSimulation.setEventTraceFileName(discreteEventFileName);
+    discreteEventSimulation.run();
+    parameters.simulationEngine = SimulationEngines::STRUCT_OF_ARRAYS;
+    Simulation structOfArraysSimulation(parameters);
+    structOfArraysSimulation.setEventTraceFileName(structOfArraysFileName);
+    structOfArraysSimulation.run();
+
+    // Read traces back
+    EventTraceHeader header{};
+    size_t numBlocks{0};
+    const EventTraceBlock events{readEventTrace(fixedStepFileName, header, numBlocks)};
+    EXPECT_EQ(header.timestep_min, parameters.simulationTimestep_min);
+    EXPECT_EQ(header.startTime_min, 0);
+    EXPECT_GT(numBlocks, 1);
+
+    // Verify every unload and station state change in the trace matches the final counts
+    vector<int> truckUnloads(parameters.numMiningTrucks, 0);
+    vector<int> stationUnloads(parameters.numUnloadingStations, 0);
+    vector<int> stationStates(parameters.numUnloadingStations, UnloadingStationStates::AVAILABLE);
+    for(size_t i = 0; i < events.size(); i++){
+        if(i > 0){
+            ASSERT_GE(events.timestep[i], events.timestep[i - 1]);
+        }
+        switch(events.type[i]){
+            case TraceEventTypes::TRUCK_UNLOADED:
+                stationUnloads[events.stationId[i]]++;
+                break;
+            case TraceEventTypes::TRUCK_STATE_CHANGED:
+                if(events.fromState[i] == TruckStates::UNLOAD){
+                    truckUnloads[events.entityId[i]]++;
+                }
+                break;
+            case TraceEventTypes::STATION_STATE_CHANGED:
+                ASSERT_EQ(stationStates[events.entityId[i]], events.fromState[i]);
+                stationStates[events.entityId[i]] = events.toState[i];
+                break;
+        }
+    }
+    const vector<Station> stations{fixedStepSimulation.getUnloadingStations()};
+    for(size_t i = 0; i < parameters.numUnloadingStations; i++){
+        EXPECT_EQ(stationUnloads[i], stations[i].numVehiclesUnloaded);
+        EXPECT_EQ(stationStates[i], stations[i].state);
+    }
+    const vector<Truck> trucks{fixedStepSimulation.getMiningTrucks()};
+    for(size_t i = 0; i < parameters.numMiningTrucks; i++){
+        const bool unloadInProgress{trucks[i].state == TruckStates::UNLOAD && !trucks[i].isLoaded};
+        EXPECT_EQ(truckUnloads[i] + (unloadInProgress ? 1 : 0), trucks[i].numUnloads / static_cast<int>(parameters.unloadDuration_min / parameters.simulationTimestep_min));
+    }
+
+    // Verify the other engines trace the same events in the same order
+    for(const string& fileName : {discreteEventFileName, structOfArraysFileName}){
+        const EventTraceBlock otherEvents{readEventTrace(fileName, header, numBlocks)};
+        EXPECT_EQ(events.timestep, otherEvents.timestep);
+        EXPECT_EQ(events.entityId, otherEvents.entityId);
+        EXPECT_EQ(events.stationId, otherEvents.stationId);
+        EXPECT_EQ(events.type, otherEvents.type);
+        EXPECT_EQ(events.fromState, otherEvents.fromState);
+        EXPECT_EQ(events.toState, otherEvents.toState);
+        filesystem::remove(fileName);
+    }
+    filesystem::remove(fixedStepFileName);
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <Simulation.h>
+#include <ReplicationRunner.h>
+#include <MetricsExporter.h>
+#include <future>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Returns the value of a metric line "<name> <value>" in Prometheus text, or -1 if it is missing
+static double getMetricValue(const string& text, const string& name){
+    const size_t lineStart{text.find("\n" + name + " ")};
+    if(lineStart == string::npos){
+        return -1;
+    }
+    return stod(text.substr(lineStart + name.size() + 2));
+}
+
+// Sends a request to a connected socket and returns the whole response
+static string sendRequest(const int connection, const string& request){
+    send(connection, request.data(), request.size(), MSG_NOSIGNAL);
+    string response{};
+    char buffer[4096];
+    ssize_t numRead{0};
+    while((numRead = recv(connection, buffer, sizeof(buffer), 0)) > 0){
+        response.append(buffer, numRead);
+    }
+    close(connection);
+    return response;
+}
+
+// Sends a GET request for path to 127.0.0.1:port and returns the whole response
+static string getTcp(const uint16_t port, const string& path){
+    const int connection{socket(AF_INET, SOCK_STREAM, 0)};
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if(connect(connection, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0){
+        close(connection);
+        return "";
+    }
+    return sendRequest(connection, "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n");
+}
+
+// Sends a GET request for path to a Unix domain socket and returns the whole response
+static string getUnixSocket(const string& socketPath, const string& path){
+    const int connection{socket(AF_UNIX, SOCK_STREAM, 0)};
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    memcpy(address.sun_path, socketPath.c_str(), socketPath.size());
+    if(connect(connection, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0){
+        close(connection);
+        return "";
+    }
+    return sendRequest(connection, "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n");
+}
+
+// Test case for every engine publishing the same simulated time and truck state changes
+TEST(MiningSimulationTests, TestLiveMetricsPublishedByEveryEngine) {
+    const double simulationTime_hrs{24};
+    const double simulationTimestep_min{5};
+    const uint64_t numTimesteps{static_cast<uint64_t>(simulationTime_hrs * 60 / simulationTimestep_min) + 1};
+
+    double expectedStateChanges{-1};
+    for(SimulationEngines engine : {SimulationEngines::FIXED_STEP, SimulationEngines::DISCRETE_EVENT, SimulationEngines::STRUCT_OF_ARRAYS,
+                                     SimulationEngines::TIMING_WHEEL, SimulationEngines::ADAPTIVE_STEP}){
+        LiveMetrics liveMetrics(3);
+        Simulation simulation(30, 3, 1, 5, 0.5, 5, simulationTime_hrs, simulationTimestep_min, engine, 4);
+        simulation.setLiveMetrics(&liveMetrics);
+        simulation.run();
+        const string text{liveMetrics.toPrometheusText()};
+
+        // Skipped time steps are counted in the simulated ticks
+        EXPECT_EQ(getMetricValue(text, "mining_simulation_simulated_ticks_total"), numTimesteps * minutesToTicks(simulationTimestep_min));
+        EXPECT_EQ(getMetricValue(text, "mining_simulation_simulated_time_hours"), simulationTime_hrs);
+        EXPECT_LE(getMetricValue(text, "mining_simulation_timesteps_total"), numTimesteps);
+        const double numStateChanges{getMetricValue(text, "mining_simulation_truck_state_changes_total")};
+        EXPECT_GT(numStateChanges, 0);
+        if(expectedStateChanges >= 0){
+            EXPECT_EQ(numStateChanges, expectedStateChanges);
+        }
+        expectedStateChanges = numStateChanges;
+    }
+}
+
+// Test case for snapshots of the truck states and station queues taken by a running simulation
+TEST(MiningSimulationTests, TestLiveMetricsSnapshot) {
+    const size_t numMiningVehicles{40};
+    LiveMetrics liveMetrics(2);
+    Simulation simulation(numMiningVehicles, 3, 1, 5, 0.5, 5, 72, 5, SimulationEngines::FIXED_STEP, 6);
+    simulation.setLiveMetrics(&liveMetrics);
+
+    // No simulation is running, the request times out
+    EXPECT_FALSE(liveMetrics.requestSnapshot(chrono::milliseconds(1)));
+
+    // The next time step answers the request
+    future<bool> snapshot{async(launch::async, [&liveMetrics](){ return liveMetrics.requestSnapshot(chrono::seconds(10)); })};
+    while(snapshot.wait_for(chrono::milliseconds(0)) != future_status::ready){
+        simulation.step();
+    }
+    EXPECT_TRUE(snapshot.get());
+    EXPECT_FALSE(liveMetrics.isSnapshotRequested());
+
+    const string text{liveMetrics.toPrometheusText()};
+    double numTrucks{0};
+    for(const string state : {"mining", "travel", "unload"}){
+        const double numStateTrucks{getMetricValue(text, "mining_simulation_trucks{state=\"" + state + "\"}")};
+        EXPECT_GE(numStateTrucks, 0);
+        numTrucks += numStateTrucks;
+    }
+    EXPECT_EQ(numTrucks, numMiningVehicles);
+
+    // Queue lengths of at most the stations the metrics were created for
+    EXPECT_GE(getMetricValue(text, "mining_simulation_station_queue_length{station=\"1\"}"), 0);
+    EXPECT_EQ(getMetricValue(text, "mining_simulation_station_queue_length{station=\"2\"}"), -1);
+}
+
+// Test case for the exporter serving metrics on localhost
+TEST(MiningSimulationTests, TestMetricsExporterServesLocalhost) {
+    // Replications report their progress
+    LiveMetrics liveMetrics(2);
+    SimulationParameters parameters{};
+    parameters.numMiningTrucks = 20;
+    parameters.numUnloadingStations = 2;
+    parameters.simulationTime_hrs = 12;
+    parameters.seed = 8;
+    ReplicationRunner replicationRunner(parameters, 4, 2);
+    replicationRunner.setLiveMetrics(&liveMetrics);
+    replicationRunner.run();
+
+    // Served on a free TCP port
+    MetricsExporter metricsExporter(liveMetrics);
+    ASSERT_TRUE(metricsExporter.startTcp(0));
+    ASSERT_TRUE(metricsExporter.isRunning());
+    ASSERT_GT(metricsExporter.getPort(), 0);
+    const string response{getTcp(metricsExporter.getPort(), "/metrics")};
+    EXPECT_EQ(response.rfind("HTTP/1.1 200 OK\r\n", 0), 0);
+    EXPECT_NE(response.find("# TYPE mining_simulation_simulated_ticks_total counter"), string::npos);
+    EXPECT_EQ(getMetricValue(response, "mining_simulation_runs"), 4);
+    EXPECT_EQ(getMetricValue(response, "mining_simulation_runs_completed"), 4);
+    EXPECT_EQ(getMetricValue(response, "mining_simulation_simulated_ticks_total"), 4 * (hoursToTicks(12) + minutesToTicks(5)));
+    EXPECT_EQ(getTcp(metricsExporter.getPort(), "/other").rfind("HTTP/1.1 404 Not Found\r\n", 0), 0);
+
+    // Served on a Unix domain socket
+    const string socketPath{testing::TempDir() + "MiningSimulationMetrics.sock"};
+    ASSERT_TRUE(metricsExporter.startUnixSocket(socketPath));
+    EXPECT_EQ(metricsExporter.getPort(), 0);
+    const string socketResponse{getUnixSocket(socketPath, "/metrics")};
+    EXPECT_EQ(socketResponse.rfind("HTTP/1.1 200 OK\r\n", 0), 0);
+    EXPECT_EQ(getMetricValue(socketResponse, "mining_simulation_runs_completed"), 4);
+
+    // Stopping removes the socket
+    metricsExporter.stop();
+    EXPECT_FALSE(metricsExporter.isRunning());
+    EXPECT_EQ(access(socketPath.c_str(), F_OK), -1);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <Simulation.h>
+#include <MiningTruckProcessor.h>
+#include <SimulationTestHelpers.h>
+#include <cstdio>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+
+// Test case for the order of newly loaded trucks of the parallel truck update
+TEST(MiningSimulationTests, TestMiningTrucksParallelUpdateMatchesSerial) {
+    // Declare constants, fleet is large enough to update in parallel and does not split evenly across threads
+    const size_t numMiningTrucks{70001};
+    const SimulationTicks timestep{minutesToTicks(5)};
+
+    MiningTrucksProcessor serialProcessor(numMiningTrucks, 1, 5, 0.5, 5, 3);
+    MiningTrucksProcessor parallelProcessor(numMiningTrucks, 1, 5, 0.5, 5, 3);
+    parallelProcessor.setNumUpdateThreads(3);
+    EXPECT_EQ(parallelProcessor.getNumUpdateThreads(), size_t{3});
+
+    // Newly loaded trucks match in every time step, for both truck layouts
+    for(int i = 0; i < 60; i++){
+        serialProcessor.updateMiningTrucks(timestep);
+        parallelProcessor.updateMiningTrucks(timestep);
+        ASSERT_EQ(serialProcessor.getLoadedTrucks(), parallelProcessor.getLoadedTrucks());
+    }
+    serialProcessor.loadTruckFleet();
+    parallelProcessor.loadTruckFleet();
+    for(int i = 0; i < 60; i++){
+        serialProcessor.updateMiningTruckFleet(timestep);
+        parallelProcessor.updateMiningTruckFleet(timestep);
+        ASSERT_EQ(serialProcessor.getLoadedTrucks(), parallelProcessor.getLoadedTrucks());
+    }
+    EXPECT_EQ(serialProcessor.getTruckCounters().numStateChanges, parallelProcessor.getTruckCounters().numStateChanges);
+}
+
+// Test case for running a simulation with trucks updated on multiple threads
+TEST(MiningSimulationTests, TestSimulationParallelUpdateMatchesSerial) {
+    // Declare constants
+    const size_t numUnloadingStations{1500};
+    const size_t numMiningVehicles{70001};
+    const float simulationTime_hrs{12}; // hours
+    const float simulationTimestep{5}; // minutes
+
+    for(SimulationEngines engine : {SimulationEngines::FIXED_STEP, SimulationEngines::STRUCT_OF_ARRAYS, SimulationEngines::ADAPTIVE_STEP}){
+        const string serialTraceFileName{testing::TempDir() + "MiningSimulationSerialUpdate.trace"};
+        const string parallelTraceFileName{testing::TempDir() + "MiningSimulationParallelUpdate.trace"};
+
+        // Run the same simulation on one and four threads
+        Simulation serialSimulation(numMiningVehicles, numUnloadingStations, 1, 5, 0.5, 5, simulationTime_hrs, simulationTimestep, engine, 9);
+        Simulation parallelSimulation(numMiningVehicles, numUnloadingStations, 1, 5, 0.5, 5, simulationTime_hrs, simulationTimestep, engine, 9);
+        serialSimulation.setNumThreads(1);
+        parallelSimulation.setNumThreads(4);
+        serialSimulation.setEventTraceFileName(serialTraceFileName);
+        parallelSimulation.setEventTraceFileName(parallelTraceFileName);
+        serialSimulation.run();
+        parallelSimulation.run();
+
+        expectSameState(serialSimulation, parallelSimulation);
+
+        // Verify every event was recorded in the same order
+        const string serialTrace{readFile(serialTraceFileName)};
+        EXPECT_FALSE(serialTrace.empty());
+        EXPECT_TRUE(serialTrace == readFile(parallelTraceFileName));
+        EXPECT_EQ(serialSimulation.getRuntimeMetrics().trucks.numStateChanges, parallelSimulation.getRuntimeMetrics().trucks.numStateChanges);
+        EXPECT_EQ(serialSimulation.getRuntimeMetrics().maxTruckStateChangesPerTimestep, parallelSimulation.getRuntimeMetrics().maxTruckStateChangesPerTimestep);
+
+        remove(serialTraceFileName.c_str());
+        remove(parallelTraceFileName.c_str());
+    }
+}
+
+// Test case for tasks of the update thread pool throwing
+TEST(MiningSimulationTests, TestThreadPoolRunTasksRethrows) {
+    ThreadPool threadPool(3);
+    const size_t numTasks{64};
+    for(size_t throwingTaskIdx : {size_t{0}, size_t{1}, numTasks - 1}){
+        // Every claimed task finishes before the exception leaves runTasks
+        atomic<size_t> numRunning{0};
+        atomic<size_t> numRun{0};
+        EXPECT_THROW(threadPool.runTasks(numTasks, [&](const size_t taskIdx){
+            numRunning++;
+            this_thread::sleep_for(chrono::microseconds(100));
+            numRun++;
+            numRunning--;
+            if(taskIdx == throwingTaskIdx){
+                throw runtime_error("Task failed");
+            }
+        }), runtime_error);
+        EXPECT_EQ(numRunning.load(), size_t{0});
+        EXPECT_GE(numRun.load(), size_t{1});
+        EXPECT_LE(numRun.load(), numTasks);
+    }
+
+    // The pool keeps running batches afterwards
+    vector<int> taskResults(numTasks, 0);
+    threadPool.runTasks(numTasks, [&](const size_t taskIdx){ taskResults[taskIdx] = static_cast<int>(taskIdx); });
+    for(size_t taskIdx = 0; taskIdx < numTasks; taskIdx++){
+        EXPECT_EQ(taskResults[taskIdx], static_cast<int>(taskIdx));
+    }
+}
+
+// Test case for chunks of a parallel loop throwing
+TEST(MiningSimulationTests, TestParallelForRethrows) {
+    const size_t count{1000};
+    for(size_t throwingBegin : {size_t{0}, size_t{250}, size_t{750}}){
+        atomic<size_t> numItems{0};
+        EXPECT_THROW(parallelFor(count, 4, [&](const size_t begin, const size_t end){
+            if(begin == throwingBegin){
+                throw runtime_error("Chunk failed");
+            }
+            numItems += end - begin;
+        }), runtime_error);
+        EXPECT_EQ(numItems.load(), count - count / 4);
+    }
+}
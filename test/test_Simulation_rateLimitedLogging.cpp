@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <Simulation.h>
+#include <SimulationLog.h>
+#include "spdlog/sinks/ostream_sink.h"
+#include <sstream>
+
+using namespace std;
+
+// Counts the occurrences of text in output
+static size_t countOccurrences(const string& output, const string& text){
+    size_t numOccurrences{0};
+    for(size_t pos = output.find(text); pos != string::npos; pos = output.find(text, pos + text.size())){
+        numOccurrences++;
+    }
+    return numOccurrences;
+}
+
+// Test case for repeated processor errors being rate limited and reported once
+TEST(MiningSimulationTests, TestRateLimitedProcessorErrors) {
+    ostringstream output{};
+    SimulationLog::setSinks({make_shared<sinks::ostream_sink_mt>(output)});
+    SimulationLog::reset();
+
+    // Assigning an unloaded truck fails every time
+    UnloadingStationProcessor unloadingStationProcessor(2, 5);
+    vector<Truck> miningTrucks{Truck(0, 0)};
+    const uint64_t numAttempts{1000};
+    for(uint64_t i = 0; i < numAttempts; i++){
+        unloadingStationProcessor.assignVehiclesToStations(miningTrucks, {0});
+    }
+    EXPECT_FALSE(miningTrucks[0].isAssignedStation);
+    SimulationLog::flush();
+
+    // Only the first burst was logged, the rest was counted
+    EXPECT_EQ(countOccurrences(output.str(), "AssignVehicle Error: Vehicle 0 is not loaded."), SimulationLog::MAX_BURST);
+    EXPECT_EQ(SimulationLog::getNumSuppressed(), numAttempts - SimulationLog::MAX_BURST);
+
+    // Suppressed messages are reported once, then the counters restart
+    SimulationLog::reportSuppressed();
+    EXPECT_EQ(countOccurrences(output.str(), to_string(numAttempts - SimulationLog::MAX_BURST) + " messages from "), size_t{1});
+    EXPECT_EQ(SimulationLog::getNumSuppressed(), uint64_t{0});
+    SimulationLog::reportSuppressed();
+    EXPECT_EQ(countOccurrences(output.str(), " messages from "), size_t{1});
+
+    SimulationLog::setSinks({make_shared<sinks::stdout_color_sink_mt>()});
+}
+
+// Test case for a misconfigured simulation flooding the log
+TEST(MiningSimulationTests, TestRateLimitedSimulationErrors) {
+    ostringstream output{};
+    SimulationLog::setSinks({make_shared<sinks::ostream_sink_mt>(output)});
+    SimulationLog::reset();
+
+    // Every arriving truck fails to be assigned with a negative unload duration
+    Simulation simulation(50, 2, 1, 5, 0.5, -5, 72, 5, SimulationEngines::FIXED_STEP, 3);
+    simulation.run();
+    SimulationLog::flush();
+    EXPECT_GT(SimulationLog::getNumSuppressed(), uint64_t{0});
+    EXPECT_LE(countOccurrences(output.str(), "Invalid unload duration"), SimulationLog::MAX_BURST + 1);
+
+    SimulationLog::reportSuppressed();
+    EXPECT_GE(countOccurrences(output.str(), " messages from "), size_t{1});
+    SimulationLog::setSinks({make_shared<sinks::stdout_color_sink_mt>()});
+}
+
+// Test case for log levels below the active level being compiled out
+TEST(MiningSimulationTests, TestSimulationLogLevelStripping) {
+    ASSERT_GT(SIMULATION_LOG_ACTIVE_LEVEL, SPDLOG_LEVEL_DEBUG);
+    ASSERT_LE(SIMULATION_LOG_ACTIVE_LEVEL, SPDLOG_LEVEL_WARN);
+
+    // Arguments of stripped calls are never evaluated
+    int numEvaluated{0};
+    SIMULATION_LOG_TRACE("Stripped message {}", ++numEvaluated);
+    SIMULATION_LOG_DEBUG("Stripped message {}", ++numEvaluated);
+    EXPECT_EQ(numEvaluated, 0);
+
+    ostringstream output{};
+    SimulationLog::setSinks({make_shared<sinks::ostream_sink_mt>(output)});
+    SIMULATION_LOG_WARN("Kept message {}", ++numEvaluated);
+    SIMULATION_LOG_CRITICAL("Kept message {}", ++numEvaluated);
+    SimulationLog::flush();
+    EXPECT_EQ(numEvaluated, 2);
+    EXPECT_EQ(countOccurrences(output.str(), "Kept message 1"), size_t{1});
+    EXPECT_EQ(countOccurrences(output.str(), "Kept message 2"), size_t{1});
+    SimulationLog::setSinks({make_shared<sinks::stdout_color_sink_mt>()});
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <ReplicationRunner.h>
+#include <MiningTruckProcessor.h>
+
+using namespace std;
+
+// Test case for seeded mining truck initialization
+TEST(MiningSimulationTests, TestMiningTrucksSeededInit) {
+    // Declare constants
+    const size_t numMiningTrucks{20};
+    const float minMiningDuration_hrs{1};
+    const float maxMiningDuration_hrs{5};
+    const uint64_t seed{12345};
+
+    // Initialize trucks with the same seed and replication, and with a different replication
+    const vector<Truck> miningTrucks{MiningTrucksProcessor::initMiningTrucks(numMiningTrucks, minMiningDuration_hrs, maxMiningDuration_hrs, seed, 0)};
+    const vector<Truck> sameMiningTrucks{MiningTrucksProcessor::initMiningTrucks(numMiningTrucks, minMiningDuration_hrs, maxMiningDuration_hrs, seed, 0)};
+    const vector<Truck> otherMiningTrucks{MiningTrucksProcessor::initMiningTrucks(numMiningTrucks, minMiningDuration_hrs, maxMiningDuration_hrs, seed, 1)};
+
+    // Verify same seed and replication reproduces mining durations, and a different replication does not
+    bool allSame{true};
+    for(size_t i = 0; i < numMiningTrucks; i++){
+        EXPECT_EQ(miningTrucks[i].miningCycleDuration, sameMiningTrucks[i].miningCycleDuration);
+        allSame = allSame && miningTrucks[i].miningCycleDuration == otherMiningTrucks[i].miningCycleDuration;
+    }
+    EXPECT_FALSE(allSame);
+}
+
+// Test case for the ReplicationRunner
+TEST(MiningSimulationTests, TestSimulationReplications) {
+    // Declare constants
+    SimulationParameters parameters{};
+    parameters.numMiningTrucks = 10;
+    parameters.numUnloadingStations = 2;
+    parameters.simulationTime_hrs = 24;
+    parameters.seed = 42;
+    const size_t numReplications{12};
+
+    // Run replications serially and on several threads
+    ReplicationRunner serialRunner(parameters, numReplications, 1);
+    serialRunner.run();
+    ReplicationRunner parallelRunner(parameters, numReplications, 4);
+    parallelRunner.run();
+
+    // Verify results are identical regardless of the number of threads
+    const vector<array<ReplicationStatistic, NUM_TRUCK_METRICS>>& serialTruckStatistics{serialRunner.getTruckStatistics()};
+    const vector<array<ReplicationStatistic, NUM_TRUCK_METRICS>>& parallelTruckStatistics{parallelRunner.getTruckStatistics()};
+    ASSERT_EQ(serialTruckStatistics.size(), parameters.numMiningTrucks);
+    ASSERT_EQ(parallelTruckStatistics.size(), parameters.numMiningTrucks);
+    for(size_t i = 0; i < parameters.numMiningTrucks; i++){
+        for(int metric = 0; metric < NUM_TRUCK_METRICS; metric++){
+            EXPECT_EQ(serialTruckStatistics[i][metric].mean, parallelTruckStatistics[i][metric].mean);
+            EXPECT_EQ(serialTruckStatistics[i][metric].stdDev, parallelTruckStatistics[i][metric].stdDev);
+        }
+
+        // Verify mining time varies across replications and is a valid percentage
+        EXPECT_GT(serialTruckStatistics[i][TRUCK_PERCENT_MINING_TIME].stdDev, 0);
+        EXPECT_GT(serialTruckStatistics[i][TRUCK_PERCENT_MINING_TIME].confidenceHalfWidth, 0);
+        EXPECT_GT(serialTruckStatistics[i][TRUCK_PERCENT_MINING_TIME].mean, 0);
+        EXPECT_LT(serialTruckStatistics[i][TRUCK_PERCENT_MINING_TIME].mean, 100);
+    }
+
+    // Verify the percentage metrics of every station sum to 100
+    const vector<array<ReplicationStatistic, NUM_STATION_METRICS>>& stationStatistics{serialRunner.getStationStatistics()};
+    ASSERT_EQ(stationStatistics.size(), parameters.numUnloadingStations);
+    for(size_t i = 0; i < parameters.numUnloadingStations; i++){
+        EXPECT_NEAR(stationStatistics[i][STATION_PERCENT_UNLOADING_TIME].mean + stationStatistics[i][STATION_PERCENT_IDLE_TIME].mean, 100, 1e-3);
+    }
+
+    // Verify Student's t quantiles
+    EXPECT_DOUBLE_EQ(ReplicationRunner::studentTQuantile975(1), 12.706);
+    EXPECT_NEAR(ReplicationRunner::studentTQuantile975(60), 2.000, 1e-3);
+    EXPECT_NEAR(ReplicationRunner::studentTQuantile975(1000000), 1.960, 1e-3);
+}
+
+// Replication runner whose replications fail from a given replication on
+class FailingReplicationRunner : public ReplicationRunner{
+    public:
+        FailingReplicationRunner(const SimulationParameters& parameters, const size_t numReplications, const size_t numThreads,
+                                    const uint32_t firstFailedReplication) :
+                                    ReplicationRunner(parameters, numReplications, numThreads), m_FirstFailedReplication(firstFailedReplication),
+                                    m_NumRun(0) {};
+
+        size_t getNumRun(){
+            return m_NumRun;
+        };
+
+    protected:
+        ReplicationSamples runReplication(const uint32_t replication) override{
+            m_NumRun++;
+            if(replication >= m_FirstFailedReplication){
+                throw runtime_error("Replication " + to_string(replication) + " failed");
+            }
+            return ReplicationRunner::runReplication(replication);
+        };
+
+    private:
+        const uint32_t m_FirstFailedReplication;
+        atomic<size_t> m_NumRun;
+};
+
+// Test case for a failed replication being rethrown by the ReplicationRunner
+TEST(MiningSimulationTests, TestSimulationReplicationsRethrow) {
+    SimulationParameters parameters{};
+    parameters.numMiningTrucks = 10;
+    parameters.numUnloadingStations = 2;
+    parameters.simulationTime_hrs = 24;
+    parameters.seed = 42;
+    const size_t numReplications{12};
+
+    // The lowest failed replication is rethrown, whatever the number of threads
+    for(const size_t numThreads : {size_t{1}, size_t{4}}){
+        FailingReplicationRunner runner(parameters, numReplications, numThreads, 3);
+        try{
+            runner.run();
+            ADD_FAILURE() << "Failed replication was not rethrown";
+        }
+        catch(const runtime_error& exception){
+            EXPECT_STREQ(exception.what(), "Replication 3 failed");
+        }
+
+        // No more replications are launched after the failure
+        EXPECT_LE(runner.getNumRun(), 3 + numThreads);
+        EXPECT_THROW(runner.run(), runtime_error);
+    }
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <Simulation.h>
+#include <ResultWriter.h>
+#include <SimulationTestHelpers.h>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+
+using namespace std;
+
+// Test case for the CSV writer formatting numbers like fixed << setprecision
+TEST(MiningSimulationTests, TestCsvWriterMatchesStreamFormatting) {
+    const string fileName{testing::TempDir() + "MiningSimulationCsvWriter.csv"};
+    const vector<double> values{0, -0.004, 0.005, 1.125, 2.675, 99.995, 100, -12.345678, 1e9 + 0.5, 123456789.987654321};
+
+    // Small buffer so rows are written across several blocks
+    stringstream expected;
+    {
+        CsvWriter csvWriter(fileName, 16);
+        csvWriter.write("Name,Value 2,Value 4").endRow();
+        expected << "Name,Value 2,Value 4\n";
+        for(size_t i = 0; i < values.size(); i++){
+            csvWriter.write(static_cast<long>(i) - 3).write(values[i], 2).write(static_cast<float>(values[i]), 4).endRow();
+            expected << static_cast<long>(i) - 3 << "," << fixed << setprecision(2) << values[i] << ","
+                        << setprecision(4) << static_cast<float>(values[i]) << "\n";
+        }
+        EXPECT_TRUE(csvWriter.close());
+    }
+    EXPECT_EQ(readFile(fileName), expected.str());
+    remove(fileName.c_str());
+}
+
+// Test case for result file names staying unique within the same second
+TEST(MiningSimulationTests, TestResultFileNamesAreUnique) {
+    const string resultsDir{testing::TempDir()};
+    const string firstFileName{getUniqueResultFileName(resultsDir, "MiningSimulationResults", ".csv")};
+    const string secondFileName{getUniqueResultFileName(resultsDir, "MiningSimulationResults", ".csv")};
+    EXPECT_NE(firstFileName, secondFileName);
+    EXPECT_EQ(firstFileName.rfind(resultsDir + "MiningSimulationResults_", 0), 0);
+
+    // Simulation results of two runs saved at once do not overwrite each other
+    Simulation simulation(10, 2, 1, 5, 0.5, 5, 12, 5, SimulationEngines::FIXED_STEP, 1);
+    simulation.run();
+    const string firstCsvFileName{simulation.writeTruckPerformanceToCSV("MiningSimulationResults_MiningTrucks", resultsDir)};
+    const string secondCsvFileName{simulation.writeTruckPerformanceToCSV("MiningSimulationResults_MiningTrucks", resultsDir)};
+    ASSERT_FALSE(firstCsvFileName.empty());
+    EXPECT_NE(firstCsvFileName, secondCsvFileName);
+    EXPECT_EQ(readFile(firstCsvFileName), readFile(secondCsvFileName));
+    remove(firstCsvFileName.c_str());
+    remove(secondCsvFileName.c_str());
+}
+
+// Test case for the performance CSV files keeping their format
+TEST(MiningSimulationTests, TestSimulationPerformanceCsvFormat) {
+    const string resultsDir{testing::TempDir()};
+    Simulation simulation(4, 1, 1, 5, 0.5, 5, 12, 5, SimulationEngines::FIXED_STEP, 2);
+    simulation.run();
+    simulation.computePerformanceStats();
+
+    stringstream expected;
+    expected << "Station ID,Percent Unloading Time,Percent Idle Time,Total Idle Time (hrs),Total Unloading Time (hrs),Total Unloads\n";
+    for(const StationPerformanceStats& stats : simulation.getUnloadingStationPerformances()){
+        expected << stats.stationId << "," << fixed << setprecision(2) << stats.percentUnloadingTime << "," << stats.percentIdleTime << ","
+                    << stats.totalIdleTime_hrs << "," << stats.totalUnloadingTime_hrs << "," << stats.totalUnloads << "\n";
+    }
+    const string fileName{simulation.writeStationPerformanceToCSV("MiningSimulationResults_UnloadingStations", resultsDir)};
+    ASSERT_FALSE(fileName.empty());
+    EXPECT_EQ(readFile(fileName), expected.str());
+    remove(fileName.c_str());
+}
+
+// Test case for reading the columns of a binary columnar file back
+TEST(MiningSimulationTests, TestColumnarWriterLayout) {
+    const string resultsDir{testing::TempDir()};
+    Simulation simulation(25, 3, 1, 5, 0.5, 5, 24, 5, SimulationEngines::FIXED_STEP, 4);
+    simulation.run();
+    simulation.computePerformanceStats();
+    const string fileName{simulation.writeTruckPerformanceToColumns("MiningSimulationResults_MiningTrucks", resultsDir)};
+    ASSERT_FALSE(fileName.empty());
+    const string contents{readFile(fileName)};
+
+    // Header
+    ColumnarFileHeader header{};
+    ASSERT_GE(contents.size(), sizeof(header));
+    memcpy(&header, contents.data(), sizeof(header));
+    EXPECT_EQ(string(header.magic), "MSCOLS");
+    EXPECT_EQ(header.version, 1);
+    ASSERT_EQ(header.numColumns, 7);
+    EXPECT_EQ(header.numRows, 25);
+    vector<ColumnarColumnHeader> columnHeaders(header.numColumns);
+    memcpy(columnHeaders.data(), contents.data() + sizeof(header), columnHeaders.size() * sizeof(ColumnarColumnHeader));
+    EXPECT_EQ(string(columnHeaders[0].name), "Vehicle ID");
+    EXPECT_EQ(string(columnHeaders[0].dtype), "<i4");
+    EXPECT_EQ(string(columnHeaders[6].name), "Total Unloads");
+    EXPECT_EQ(string(columnHeaders[6].dtype), "<f4");
+
+    // Columns are aligned and hold the performance stats
+    for(const ColumnarColumnHeader& columnHeader : columnHeaders){
+        EXPECT_EQ(columnHeader.offset % ColumnarWriter::COLUMN_ALIGNMENT, 0);
+        ASSERT_LE(columnHeader.offset + header.numRows * 4, contents.size());
+    }
+    const vector<TruckPerformanceStats>& performances{simulation.getMiningTruckPerformances()};
+    for(size_t i = 0; i < performances.size(); i++){
+        int32_t vehicleId{0};
+        float percentIdleTime{0};
+        float totalUnloads{0};
+        memcpy(&vehicleId, contents.data() + columnHeaders[0].offset + i * 4, 4);
+        memcpy(&percentIdleTime, contents.data() + columnHeaders[4].offset + i * 4, 4);
+        memcpy(&totalUnloads, contents.data() + columnHeaders[6].offset + i * 4, 4);
+        EXPECT_EQ(vehicleId, performances[i].vehicleId);
+        EXPECT_EQ(percentIdleTime, performances[i].percentIdleTime);
+        EXPECT_EQ(totalUnloads, performances[i].totalUnloads);
+    }
+
+    // Columns must match the row count and fit the name field
+    ColumnarWriter columnarWriter(2);
+    EXPECT_FALSE(columnarWriter.addColumn("Too Short", vector<double>{1}));
+    EXPECT_FALSE(columnarWriter.addColumn(string(48, 'x'), vector<double>{1, 2}));
+    EXPECT_TRUE(columnarWriter.addColumn("Values", vector<double>{1, 2}));
+    EXPECT_EQ(ColumnarWriter::getTypeName<uint8_t>(), "|u1");
+    EXPECT_EQ(ColumnarWriter::getTypeName<double>(), "<f8");
+    remove(fileName.c_str());
+}
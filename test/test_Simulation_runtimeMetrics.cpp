@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <Simulation.h>
+
+using namespace std;
+
+// Test case for the runtime metrics of every simulation engine
+TEST(MiningSimulationTests, TestSimulationRuntimeMetrics) {
+    // Declare constants
+    const size_t numUnloadingStations{2};
+    const size_t numMiningVehicles{40};
+    const float travelDuration_hrs{0.5};
+    const float unloadDuration_min{5};
+    const float minMiningDuration_hrs{1};
+    const float maxMiningDuration_hrs{5};
+    const float simulationTime_hrs{72}; // hours
+    const float simulationTimestep{5}; // minutes
+    const uint64_t numTimesteps{static_cast<uint64_t>(simulationTime_hrs * 60 / simulationTimestep) + 1};
+
+    vector<RuntimeMetrics> engineMetrics{};
+    for(SimulationEngines engine : {SimulationEngines::FIXED_STEP, SimulationEngines::DISCRETE_EVENT, SimulationEngines::STRUCT_OF_ARRAYS, SimulationEngines::TIMING_WHEEL,
+                                     SimulationEngines::ADAPTIVE_STEP}){
+        Simulation simulation(numMiningVehicles, numUnloadingStations, minMiningDuration_hrs, maxMiningDuration_hrs, travelDuration_hrs,
+                                unloadDuration_min, simulationTime_hrs, simulationTimestep, engine, 5);
+        simulation.run();
+        const RuntimeMetrics metrics{simulation.getRuntimeMetrics()};
+        ASSERT_TRUE(metrics.enabled);
+
+        // Every phase ran and was timed
+        EXPECT_GT(metrics.stationUpdate.numCalls, 0);
+        EXPECT_GT(metrics.truckUpdate.numCalls, 0);
+        EXPECT_GT(metrics.assignment.numCalls, 0);
+        EXPECT_GT(metrics.stationUpdate.totalTime_s + metrics.truckUpdate.totalTime_s + metrics.assignment.totalTime_s, 0);
+
+        // Fixed-step engines run every phase once per time step, the discrete-event and adaptive-step engines skip time steps without events
+        if(engine == SimulationEngines::DISCRETE_EVENT || engine == SimulationEngines::ADAPTIVE_STEP){
+            EXPECT_LT(metrics.numTimesteps, numTimesteps);
+            EXPECT_EQ(metrics.assignment.numCalls, metrics.numTimesteps);
+        }
+        else{
+            EXPECT_EQ(metrics.numTimesteps, numTimesteps);
+            EXPECT_EQ(metrics.stationUpdate.numCalls, numTimesteps);
+            EXPECT_EQ(metrics.truckUpdate.numCalls, numTimesteps);
+            EXPECT_EQ(metrics.assignment.numCalls, numTimesteps);
+        }
+
+        // Every assigned truck was either unloaded or is still assigned to a station
+        uint64_t numAssignedTrucks{0};
+        for(const Truck& truck : simulation.getMiningTrucks()){
+            numAssignedTrucks += truck.numUnloads + (truck.isAssignedStation ? 1 : 0);
+        }
+        EXPECT_EQ(metrics.dispatch.numAssignedToAvailableStation + metrics.dispatch.numAssignedToShortestWaitStation, numAssignedTrucks);
+        EXPECT_GT(metrics.dispatch.numAssignedToShortestWaitStation, 0);
+        EXPECT_EQ(metrics.dispatch.numUnassignedTrucks, 0);
+
+        // Queue high-water mark is at least the longest final queue
+        for(const Station& station : simulation.getUnloadingStations()){
+            EXPECT_GE(metrics.dispatch.maxStationQueueLength, station.vehicleIdQueue.size());
+        }
+        EXPECT_GT(metrics.trucks.numStateChanges, 0);
+        EXPECT_GE(metrics.maxTruckStateChangesPerTimestep, metrics.getMeanTruckStateChangesPerTimestep());
+        engineMetrics.push_back(metrics);
+    }
+
+    // Counters do not depend on the engine
+    for(const RuntimeMetrics& metrics : engineMetrics){
+        EXPECT_EQ(metrics.trucks.numStateChanges, engineMetrics[0].trucks.numStateChanges);
+        EXPECT_EQ(metrics.maxTruckStateChangesPerTimestep, engineMetrics[0].maxTruckStateChangesPerTimestep);
+        EXPECT_EQ(metrics.dispatch.numAssignedToAvailableStation, engineMetrics[0].dispatch.numAssignedToAvailableStation);
+        EXPECT_EQ(metrics.dispatch.numAssignedToShortestWaitStation, engineMetrics[0].dispatch.numAssignedToShortestWaitStation);
+        EXPECT_EQ(metrics.dispatch.maxStationQueueLength, engineMetrics[0].dispatch.maxStationQueueLength);
+    }
+}
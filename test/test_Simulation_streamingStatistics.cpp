@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <ReplicationRunner.h>
+#include <StreamingStatistics.h>
+#include <RandomStream.h>
+#include <algorithm>
+
+using namespace std;
+
+// Test case for Welford's mean and variance matching the two-pass formulas
+TEST(MiningSimulationTests, TestWelfordAccumulator) {
+    WelfordAccumulator accumulator{};
+    EXPECT_EQ(accumulator.getMean(), 0);
+    EXPECT_EQ(accumulator.getVariance(), 0);
+    EXPECT_EQ(accumulator.getConfidenceHalfWidth(2), 0);
+
+    // Large offset, where the one-pass sum of squares formula loses precision
+    const vector<double> values{1e9 + 4, 1e9 + 7, 1e9 + 13, 1e9 + 16};
+    for(double value : values){
+        accumulator.add(value);
+    }
+    EXPECT_EQ(accumulator.getCount(), uint64_t{4});
+    EXPECT_DOUBLE_EQ(accumulator.getMean(), 1e9 + 10);
+    EXPECT_DOUBLE_EQ(accumulator.getVariance(), 30);
+    EXPECT_DOUBLE_EQ(accumulator.getConfidenceHalfWidth(3.182), 3.182 * sqrt(30.0) / 2);
+}
+
+// Test case for P-squared quantile estimates
+TEST(MiningSimulationTests, TestP2Quantile) {
+    // Exact up to five values
+    P2Quantile median(0.5);
+    EXPECT_EQ(median.getQuantile(), 0);
+    for(double value : {7.0, 1.0, 4.0}){
+        median.add(value);
+    }
+    EXPECT_EQ(median.getQuantile(), 4);
+    median.add(10);
+    EXPECT_DOUBLE_EQ(median.getQuantile(), 5.5);
+    median.add(2);
+    EXPECT_DOUBLE_EQ(median.getQuantile(), 4);
+    P2Quantile percentile95(0.95);
+    for(double value : {5.0, 1.0, 4.0, 2.0, 3.0}){
+        percentile95.add(value);
+    }
+    EXPECT_DOUBLE_EQ(percentile95.getQuantile(), 4.8);
+
+    // Close to the sample quantiles of a long stream of uniform values
+    P2Quantile percentile5(0.05);
+    P2Quantile percentile50(0.5);
+    P2Quantile streamPercentile95(0.95);
+    vector<double> values{};
+    for(int i = 0; i < 20000; i++){
+        const double value{RandomStream::uniformFloat(3, 0, RandomStreams::MINING_DURATION, 0, i, 0, 100)};
+        values.push_back(value);
+        percentile5.add(value);
+        percentile50.add(value);
+        streamPercentile95.add(value);
+    }
+    sort(values.begin(), values.end());
+    EXPECT_NEAR(percentile5.getQuantile(), values[1000], 0.5);
+    EXPECT_NEAR(percentile50.getQuantile(), values[10000], 0.5);
+    EXPECT_NEAR(streamPercentile95.getQuantile(), values[19000], 0.5);
+}
+
+// Test case for stopping replications once the confidence intervals are narrow enough
+TEST(MiningSimulationTests, TestSequentialStoppingReplications) {
+    SimulationParameters parameters{};
+    parameters.numMiningTrucks = 8;
+    parameters.numUnloadingStations = 2;
+    parameters.simulationTime_hrs = 24;
+    parameters.seed = 17;
+    const size_t maxReplications{60};
+
+    SequentialStoppingConfig config{};
+    config.maxConfidenceHalfWidth = 2.5;
+    config.minReplications = 4;
+
+    // The stopping point and the statistics do not depend on the number of threads
+    ReplicationRunner serialRunner(parameters, maxReplications, 1);
+    serialRunner.setSequentialStopping(config);
+    serialRunner.run();
+    ReplicationRunner parallelRunner(parameters, maxReplications, 4);
+    parallelRunner.setSequentialStopping(config);
+    parallelRunner.run();
+    const size_t numReplications{serialRunner.getNumReplications()};
+    EXPECT_GE(numReplications, config.minReplications);
+    EXPECT_LT(numReplications, maxReplications);
+    EXPECT_EQ(parallelRunner.getNumReplications(), numReplications);
+    for(size_t i = 0; i < parameters.numMiningTrucks; i++){
+        for(int metric = 0; metric < NUM_TRUCK_METRICS; metric++){
+            const ReplicationStatistic& serialStatistic{serialRunner.getTruckStatistics()[i][metric]};
+            const ReplicationStatistic& parallelStatistic{parallelRunner.getTruckStatistics()[i][metric]};
+            EXPECT_EQ(serialStatistic.mean, parallelStatistic.mean);
+            EXPECT_EQ(serialStatistic.stdDev, parallelStatistic.stdDev);
+            EXPECT_EQ(serialStatistic.median, parallelStatistic.median);
+            EXPECT_LE(serialStatistic.percentile5, serialStatistic.percentile95);
+        }
+
+        // Every target metric meets the half width
+        EXPECT_LE(serialRunner.getTruckStatistics()[i][TRUCK_PERCENT_IDLE_TIME].confidenceHalfWidth, config.maxConfidenceHalfWidth);
+    }
+    for(size_t i = 0; i < parameters.numUnloadingStations; i++){
+        EXPECT_LE(serialRunner.getStationStatistics()[i][STATION_PERCENT_UNLOADING_TIME].confidenceHalfWidth, config.maxConfidenceHalfWidth);
+    }
+
+    // The stopping point is the first replication count that meets the half width
+    ReplicationRunner shorterRunner(parameters, numReplications - 1, 1);
+    shorterRunner.run();
+    bool shorterMeetsHalfWidth{true};
+    for(const array<ReplicationStatistic, NUM_TRUCK_METRICS>& statistics : shorterRunner.getTruckStatistics()){
+        shorterMeetsHalfWidth = shorterMeetsHalfWidth && statistics[TRUCK_PERCENT_IDLE_TIME].confidenceHalfWidth <= config.maxConfidenceHalfWidth;
+    }
+    for(const array<ReplicationStatistic, NUM_STATION_METRICS>& statistics : shorterRunner.getStationStatistics()){
+        shorterMeetsHalfWidth = shorterMeetsHalfWidth && statistics[STATION_PERCENT_UNLOADING_TIME].confidenceHalfWidth <= config.maxConfidenceHalfWidth;
+    }
+    EXPECT_TRUE(numReplications == config.minReplications || !shorterMeetsHalfWidth);
+
+    // An unreachable half width runs every replication
+    config.maxConfidenceHalfWidth = 1e-9;
+    ReplicationRunner exhaustiveRunner(parameters, 12, 3);
+    exhaustiveRunner.setSequentialStopping(config);
+    exhaustiveRunner.run();
+    EXPECT_EQ(exhaustiveRunner.getNumReplications(), size_t{12});
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <FleetSweep.h>
+
+using namespace std;
+
+// Test case for the FleetSweep
+TEST(MiningSimulationTests, TestSimulationFleetSweep) {
+    // Declare constants
+    SimulationParameters parameters{};
+    parameters.simulationTime_hrs = 24;
+    parameters.seed = 7;
+    FleetSweepRanges ranges{};
+    ranges.numMiningTrucks = {5, 10, 20, 40};
+    ranges.numUnloadingStations = {1, 2, 4};
+    ranges.travelDurations_hrs = {0.5, 1};
+    const double truckCost{1};
+    const double stationCost{5};
+    const double maxStationIdlePercent{60};
+
+    // Run sweep serially and on several threads
+    FleetSweep serialSweep(parameters, ranges, 1, truckCost, stationCost, maxStationIdlePercent);
+    serialSweep.run();
+    FleetSweep parallelSweep(parameters, ranges, 4, truckCost, stationCost, maxStationIdlePercent);
+    parallelSweep.run();
+
+    // Verify every combination ran and results are identical regardless of the number of threads
+    const vector<FleetSweepResult>& results{serialSweep.getResults()};
+    const vector<FleetSweepResult>& parallelResults{parallelSweep.getResults()};
+    ASSERT_EQ(results.size(), size_t{4 * 3 * 2});
+    ASSERT_EQ(parallelResults.size(), results.size());
+    for(size_t i = 0; i < results.size(); i++){
+        EXPECT_EQ(results[i].throughput_per_hr, parallelResults[i].throughput_per_hr);
+        EXPECT_EQ(results[i].meanStationIdlePercent, parallelResults[i].meanStationIdlePercent);
+        EXPECT_EQ(results[i].onParetoFrontier, parallelResults[i].onParetoFrontier);
+    }
+
+    // Verify a configuration matches a single simulation with the same parameters
+    const FleetSweepResult& result{results[9]};
+    EXPECT_EQ(result.parameters.numMiningTrucks, 10);
+    EXPECT_EQ(result.parameters.numUnloadingStations, 2);
+    EXPECT_EQ(result.parameters.travelDuration_hrs, 1);
+    Simulation simulation(result.parameters);
+    simulation.run();
+    double totalUnloads{0};
+    for(const StationPerformanceStats& stats : simulation.getUnloadingStationPerformances()){
+        totalUnloads += stats.totalUnloads;
+    }
+    EXPECT_DOUBLE_EQ(result.throughput_per_hr, totalUnloads / parameters.simulationTime_hrs);
+    EXPECT_DOUBLE_EQ(result.fleetCost, 10 * truckCost + 2 * stationCost);
+
+    // Verify frontier configurations are not dominated and every other configuration is
+    const vector<size_t> frontier{serialSweep.getParetoFrontier()};
+    ASSERT_FALSE(frontier.empty());
+    for(size_t i = 0; i < results.size(); i++){
+        bool dominated{false};
+        for(size_t j = 0; j < results.size(); j++){
+            const bool noWorse{results[j].fleetCost <= results[i].fleetCost && results[j].throughput_per_hr >= results[i].throughput_per_hr};
+            const bool better{results[j].fleetCost < results[i].fleetCost || results[j].throughput_per_hr > results[i].throughput_per_hr};
+            dominated = dominated || (noWorse && better);
+        }
+        EXPECT_EQ(results[i].onParetoFrontier, !dominated) << "configuration " << i;
+    }
+    for(size_t k = 1; k < frontier.size(); k++){
+        EXPECT_GT(results[frontier[k]].fleetCost, results[frontier[k - 1]].fleetCost);
+        EXPECT_GT(results[frontier[k]].throughput_per_hr, results[frontier[k - 1]].throughput_per_hr);
+    }
+
+    // Verify the cheapest configuration meeting the idle threshold
+    const int cheapestIdx{serialSweep.getCheapestConfigurationIdx()};
+    ASSERT_NE(cheapestIdx, -1);
+    EXPECT_LE(results[cheapestIdx].meanStationIdlePercent, maxStationIdlePercent);
+    for(const FleetSweepResult& other : results){
+        if(other.meetsIdleThreshold){
+            EXPECT_GE(other.fleetCost, results[cheapestIdx].fleetCost);
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <Simulation.h>
+#include <TimeSeriesRecorder.h>
+#include <cstdio>
+
+using namespace std;
+
+// Test case for the fleet and station series of a short run
+TEST(MiningSimulationTests, TestTimeSeriesSamplesFleetAndStations) {
+    const size_t numMiningVehicles{40};
+    const size_t numUnloadingStations{3};
+    TimeSeriesConfig config{};
+    config.sampleInterval_min = 15;
+    config.numLevels = 2;
+    config.bucketsPerLevel = 1000;
+    config.downsampleFactor = 4;
+
+    Simulation simulation(numMiningVehicles, numUnloadingStations, 1, 5, 0.5, 5, 24, 5, SimulationEngines::FIXED_STEP, 3);
+    EXPECT_FALSE(simulation.getTimeSeries().isEnabled());
+    simulation.enableTimeSeries(config);
+    simulation.run();
+
+    // One sample every 3 time steps of the 289 time steps
+    const TimeSeriesRecorder& timeSeries{simulation.getTimeSeries()};
+    ASSERT_TRUE(timeSeries.isEnabled());
+    EXPECT_EQ(timeSeries.getNumSeries(), TimeSeriesRecorder::NUM_FLEET_SERIES + 2 * numUnloadingStations);
+    EXPECT_EQ(timeSeries.getNumSamples(), uint64_t{97});
+    const vector<TimeSeriesPoint> miningPoints{timeSeries.getSeries(TimeSeriesRecorder::getFleetStateSeriesIdx(TruckStates::MINING), 0)};
+    ASSERT_EQ(miningPoints.size(), size_t{97});
+    EXPECT_EQ(miningPoints[0].startTime_min, 0);
+    EXPECT_EQ(miningPoints[1].startTime_min, 15);
+    EXPECT_EQ(miningPoints[96].startTime_min, 1440);
+    EXPECT_EQ(timeSeries.getSeriesName(timeSeries.getStationQueueSeriesIdx(2)), "Station 2 Queue Length");
+    EXPECT_EQ(timeSeries.getSeriesName(timeSeries.getStationBusySeriesIdx(0)), "Station 0 Busy");
+
+    // Every sample counts the whole fleet, and busy states are 0 or 1
+    for(size_t i = 0; i < miningPoints.size(); i++){
+        float numTrucks{0};
+        for(int state : {TruckStates::MINING, TruckStates::TRAVEL, TruckStates::UNLOAD}){
+            numTrucks += timeSeries.getSeries(TimeSeriesRecorder::getFleetStateSeriesIdx(state), 0)[i].mean;
+        }
+        EXPECT_EQ(numTrucks, numMiningVehicles);
+    }
+    for(size_t stationId = 0; stationId < numUnloadingStations; stationId++){
+        for(const TimeSeriesPoint& point : timeSeries.getSeries(timeSeries.getStationBusySeriesIdx(stationId), 0)){
+            EXPECT_TRUE(point.mean == 0 || point.mean == 1);
+        }
+    }
+
+    // Coarse buckets hold the min, max and mean of the fine buckets they span, the last bucket is partly filled
+    for(size_t seriesIdx = 0; seriesIdx < timeSeries.getNumSeries(); seriesIdx++){
+        const vector<TimeSeriesPoint> finePoints{timeSeries.getSeries(seriesIdx, 0)};
+        const vector<TimeSeriesPoint> coarsePoints{timeSeries.getSeries(seriesIdx, 1)};
+        ASSERT_EQ(coarsePoints.size(), size_t{25});
+        EXPECT_EQ(coarsePoints.back().numSamples, 1);
+        for(size_t i = 0; i < coarsePoints.size(); i++){
+            float expectedMin{finePoints[i * 4].min};
+            float expectedMax{finePoints[i * 4].max};
+            double expectedSum{0};
+            for(size_t j = i * 4; j < min(i * 4 + 4, finePoints.size()); j++){
+                expectedMin = min(expectedMin, finePoints[j].min);
+                expectedMax = max(expectedMax, finePoints[j].max);
+                expectedSum += finePoints[j].mean;
+            }
+            EXPECT_EQ(coarsePoints[i].startTime_min, finePoints[i * 4].startTime_min);
+            EXPECT_EQ(coarsePoints[i].min, expectedMin);
+            EXPECT_EQ(coarsePoints[i].max, expectedMax);
+            EXPECT_DOUBLE_EQ(coarsePoints[i].mean, expectedSum / coarsePoints[i].numSamples);
+        }
+    }
+}
+
+// Test case for time series memory staying constant over long horizons
+TEST(MiningSimulationTests, TestTimeSeriesMemoryIsBounded) {
+    TimeSeriesConfig config{};
+    config.sampleInterval_min = 5;
+    config.numLevels = 3;
+    config.bucketsPerLevel = 16;
+    config.downsampleFactor = 8;
+
+    Simulation shortSimulation(20, 2, 1, 5, 0.5, 5, 24, 5, SimulationEngines::FIXED_STEP, 5);
+    shortSimulation.enableTimeSeries(config);
+    shortSimulation.run();
+    Simulation longSimulation(20, 2, 1, 5, 0.5, 5, 24 * 100, 5, SimulationEngines::FIXED_STEP, 5);
+    longSimulation.enableTimeSeries(config);
+    longSimulation.run();
+
+    EXPECT_EQ(shortSimulation.getTimeSeries().getMemoryBytes(), longSimulation.getTimeSeries().getMemoryBytes());
+    EXPECT_EQ(longSimulation.getTimeSeries().getNumSamples(), uint64_t{24 * 100 * 12 + 1});
+
+    // Each level keeps only its most recent buckets
+    const TimeSeriesRecorder& timeSeries{longSimulation.getTimeSeries()};
+    for(size_t level = 0; level < timeSeries.getNumLevels(); level++){
+        const vector<TimeSeriesPoint> points{timeSeries.getSeries(0, level)};
+        ASSERT_GE(points.size(), config.bucketsPerLevel);
+        ASSERT_LE(points.size(), config.bucketsPerLevel + 1);
+        for(size_t i = 1; i < points.size(); i++){
+            EXPECT_GT(points[i].startTime_min, points[i - 1].startTime_min);
+        }
+    }
+    EXPECT_EQ(timeSeries.getSeries(0, 0).back().startTime_min, 24 * 100 * 60);
+}
+
+// Test case for every engine recording the same time series
+TEST(MiningSimulationTests, TestTimeSeriesSameForAllEngines) {
+    TimeSeriesConfig config{};
+    config.sampleInterval_min = 10;
+
+    Simulation fixedStepSimulation(30, 2, 1, 5, 0.5, 5, 48, 5, SimulationEngines::FIXED_STEP, 9);
+    fixedStepSimulation.enableTimeSeries(config);
+    fixedStepSimulation.run();
+    for(SimulationEngines engine : {SimulationEngines::DISCRETE_EVENT, SimulationEngines::STRUCT_OF_ARRAYS, SimulationEngines::TIMING_WHEEL,
+                                     SimulationEngines::ADAPTIVE_STEP}){
+        Simulation simulation(30, 2, 1, 5, 0.5, 5, 48, 5, engine, 9);
+        simulation.enableTimeSeries(config);
+        simulation.run();
+        for(size_t seriesIdx = 0; seriesIdx < simulation.getTimeSeries().getNumSeries(); seriesIdx++){
+            const vector<TimeSeriesPoint> expectedPoints{fixedStepSimulation.getTimeSeries().getSeries(seriesIdx, 0)};
+            const vector<TimeSeriesPoint> points{simulation.getTimeSeries().getSeries(seriesIdx, 0)};
+            ASSERT_EQ(expectedPoints.size(), points.size());
+            for(size_t i = 0; i < points.size(); i++){
+                EXPECT_EQ(expectedPoints[i].mean, points[i].mean);
+            }
+        }
+    }
+
+    // Series can be saved as CSV
+    const string fileName{fixedStepSimulation.writeTimeSeriesToCSV("MiningSimulationResults_TimeSeries", testing::TempDir())};
+    EXPECT_FALSE(fileName.empty());
+    remove(fileName.c_str());
+}
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include <Simulation.h>
+#include <TimingWheel.h>
+#include <RandomStream.h>
+#include <algorithm>
+
+using namespace std;
+
+// Test case for the timing wheel returning every entity in the tick it was filed under
+TEST(MiningSimulationTests, TestTimingWheelCollectsEachTick) {
+    // Two levels hold 4096 ticks, later ticks go through the overflow list
+    TimingWheel timingWheel(2);
+    const uint64_t numTicks{20000};
+    vector<vector<int>> expectedIds(numTicks);
+    for(int id = 0; id < 3000; id++){
+        const uint64_t tick{static_cast<uint64_t>(RandomStream::uniformFloat(11, 0, RandomStreams::MINING_DURATION, id, 0, 0, numTicks - 1))};
+        timingWheel.insert(id, tick);
+        expectedIds[tick].push_back(id);
+    }
+    EXPECT_EQ(timingWheel.size(), size_t{3000});
+
+    // Entities filed while running, including under the current tick
+    vector<int> ids{};
+    for(uint64_t tick = 0; tick < numTicks; tick++){
+        ASSERT_EQ(timingWheel.getCurrentTick(), tick);
+        if(tick % 97 == 0){
+            const int id{static_cast<int>(3000 + tick)};
+            const uint64_t expiryTick{min(tick + (tick % 5) * 1000, numTicks - 1)};
+            timingWheel.insert(id, expiryTick);
+            expectedIds[expiryTick].push_back(id);
+        }
+        ids.clear();
+        timingWheel.collectCurrent(ids);
+        sort(ids.begin(), ids.end());
+        sort(expectedIds[tick].begin(), expectedIds[tick].end());
+        EXPECT_EQ(ids, expectedIds[tick]);
+        timingWheel.advance();
+    }
+    EXPECT_EQ(timingWheel.size(), size_t{0});
+}
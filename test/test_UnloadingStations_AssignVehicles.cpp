@@ -6,9 +6,9 @@
 using namespace std;
 
 // Checks if a value exists in the queue
-bool valueInQueue(const queue<int>& q, int value) {
+bool valueInQueue(const VehicleIdQueue& q, int value) {
     // Create a copy of the queue
-    std::queue<int> tempQueue = q;
+    VehicleIdQueue tempQueue = q;
 
     // Traverse through the queue
     while (!tempQueue.empty()) {
@@ -54,9 +54,9 @@ TEST(MiningSimulationTests, TestUnloadingStationsAssignVehicles) {
     vector<int> loadedTruckIdxs{0, 1, 2, 3, 4};
 
     // Set S2 (3 vehicles), S3 (4 vehicles), S5 (1 vehicle) to have wait times
-    unloadingStationProcessor.m_UnloadingStationsList[1].waitTime = 3 * unloadDuration_min;
-    unloadingStationProcessor.m_UnloadingStationsList[2].waitTime = 4 * unloadDuration_min;
-    unloadingStationProcessor.m_UnloadingStationsList[4].waitTime = unloadDuration_min;
+    unloadingStationProcessor.m_UnloadingStationsList[1].waitTime = 3 * minutesToTicks(unloadDuration_min);
+    unloadingStationProcessor.m_UnloadingStationsList[2].waitTime = 4 * minutesToTicks(unloadDuration_min);
+    unloadingStationProcessor.m_UnloadingStationsList[4].waitTime = minutesToTicks(unloadDuration_min);
 
     // Set S1 and be S4 to available stations
     queue<int> availableStationIdx;
@@ -70,27 +70,27 @@ TEST(MiningSimulationTests, TestUnloadingStationsAssignVehicles) {
     // Check where each vehicle assigned (T1 = S1, T2 = S4, T3 = S1, T4 = S4, T5 = S5)
 
     // Verify S1 has been assigned vehicles T1 and T3
-    queue<int> s1_vehicleQueue{unloadingStationProcessor.m_UnloadingStationsList[0].vehicleIdQueue};
+    VehicleIdQueue s1_vehicleQueue{unloadingStationProcessor.m_UnloadingStationsList[0].vehicleIdQueue};
     EXPECT_EQ(s1_vehicleQueue.size(), 2);
     EXPECT_TRUE(valueInQueue(s1_vehicleQueue, 0));
     EXPECT_TRUE(valueInQueue(s1_vehicleQueue, 2));
 
     // Verify S4 has been assigned vehicles T2 and T4
-    queue<int> s4_vehicleQueue{unloadingStationProcessor.m_UnloadingStationsList[3].vehicleIdQueue};
+    VehicleIdQueue s4_vehicleQueue{unloadingStationProcessor.m_UnloadingStationsList[3].vehicleIdQueue};
     EXPECT_EQ(s4_vehicleQueue.size(), 2);
     EXPECT_TRUE(valueInQueue(s4_vehicleQueue, 1));
     EXPECT_TRUE(valueInQueue(s4_vehicleQueue, 3));
 
     // Verify S5 has been assigned vehicle T5
-    queue<int> s5_vehicleQueue{unloadingStationProcessor.m_UnloadingStationsList[4].vehicleIdQueue};
+    VehicleIdQueue s5_vehicleQueue{unloadingStationProcessor.m_UnloadingStationsList[4].vehicleIdQueue};
     EXPECT_EQ(s5_vehicleQueue.size(), 1);
     EXPECT_TRUE(valueInQueue(s5_vehicleQueue, 4));
 
     // Verify S2 and S3 have not been assigned vehicles 
-    queue<int> s2_vehicleQueue{unloadingStationProcessor.m_UnloadingStationsList[1].vehicleIdQueue};
+    VehicleIdQueue s2_vehicleQueue{unloadingStationProcessor.m_UnloadingStationsList[1].vehicleIdQueue};
     EXPECT_EQ(s2_vehicleQueue.size(), 0);
 
-    queue<int> s3_vehicleQueue{unloadingStationProcessor.m_UnloadingStationsList[2].vehicleIdQueue};
+    VehicleIdQueue s3_vehicleQueue{unloadingStationProcessor.m_UnloadingStationsList[2].vehicleIdQueue};
     EXPECT_EQ(s3_vehicleQueue.size(), 0);
 
     // Verify all loaded stations have been assigned stations
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <StationDispatcher.h>
+#include <SimulationTime.h>
+#include <random>
+
+using namespace std;
+
+// Returns the index of the station with the shortest wait time, lowest id on ties
+static int shortestWaitStationIdx(const vector<int>& waitTimes) {
+    size_t shortestWaitIdx{0};
+    for(size_t i = 1; i < waitTimes.size(); i++){
+        if(waitTimes[i] < waitTimes[shortestWaitIdx]){
+            shortestWaitIdx = i;
+        }
+    }
+    return static_cast<int>(shortestWaitIdx);
+}
+
+// Test case for the StationDispatcher index
+TEST(MiningSimulationTests, TestUnloadingStationsDispatcher) {
+    // Declare constants (more than 64 * 64 stations to cover both bitset levels)
+    const size_t numUnloadingStations{4200};
+    const int lastStationIdx{static_cast<int>(numUnloadingStations) - 1};
+    const int unloadDuration{static_cast<int>(minutesToTicks(5))};
+
+    // Initialize dispatcher
+    StationDispatcher stationDispatcher(numUnloadingStations);
+    vector<int> waitTimes(numUnloadingStations, 0);
+
+    // Verify all stations start available, lowest id first
+    EXPECT_EQ(stationDispatcher.getNextStationIdx(), 0);
+    EXPECT_TRUE(stationDispatcher.isAvailable(lastStationIdx));
+    EXPECT_EQ(stationDispatcher.getNumAvailable(), numUnloadingStations);
+
+    // Make all stations unavailable except the last one
+    for(int i = 0; i < lastStationIdx; i++){
+        stationDispatcher.setAvailable(i, false);
+    }
+    EXPECT_EQ(stationDispatcher.getNextStationIdx(), lastStationIdx);
+    stationDispatcher.setAvailable(lastStationIdx, false);
+    EXPECT_EQ(stationDispatcher.getNumAvailable(), size_t{0});
+
+    // With no available stations, verify dispatcher returns shortest wait station with random wait time updates
+    mt19937 gen(0);
+    uniform_int_distribution<int> stationDistrib(0, lastStationIdx);
+    uniform_int_distribution<int> queueDistrib(0, 20);
+    for(int i = 0; i < 20000; i++){
+        const int stationIdx{stationDistrib(gen)};
+        waitTimes[stationIdx] = queueDistrib(gen) * unloadDuration;
+        stationDispatcher.updateWaitTime(stationIdx, waitTimes[stationIdx]);
+        ASSERT_EQ(stationDispatcher.getNextStationIdx(), shortestWaitStationIdx(waitTimes));
+    }
+
+    // Verify available stations take priority over the shortest wait station
+    stationDispatcher.setAvailable(4100, true);
+    stationDispatcher.setAvailable(70, true);
+    stationDispatcher.setAvailable(70, true);
+    EXPECT_EQ(stationDispatcher.getNumAvailable(), size_t{2});
+    EXPECT_EQ(stationDispatcher.getNextStationIdx(), 70);
+    stationDispatcher.setAvailable(70, false);
+    EXPECT_EQ(stationDispatcher.getNextStationIdx(), 4100);
+
+    // Verify clearing availability falls back to shortest wait station
+    stationDispatcher.clearAvailable();
+    EXPECT_EQ(stationDispatcher.getNumAvailable(), size_t{0});
+    EXPECT_EQ(stationDispatcher.getNextStationIdx(), shortestWaitStationIdx(waitTimes));
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <Simulation.h>
+#include <UnloadingStationProcessor.h>
+#include <StationQueuePool.h>
+
+using namespace std;
+
+// Test case for sizing the station queue slab from the fleet size
+TEST(MiningSimulationTests, TestStationQueuePoolSizedFromFleet) {
+    const size_t numUnloadingStations{4};
+    const size_t numMiningVehicles{10};
+    UnloadingStationProcessor unloadingStationProcessor(numUnloadingStations, 5, numMiningVehicles);
+
+    // ceil(10 / 4) + 1 vehicle ids per station, all in one slab
+    const StationQueuePool& stationQueuePool{unloadingStationProcessor.getStationQueuePool()};
+    EXPECT_EQ(stationQueuePool.getQueueCapacity(), 4);
+    EXPECT_EQ(stationQueuePool.getSlabSize(), numUnloadingStations * 4);
+    for(const Station& station : unloadingStationProcessor.m_UnloadingStationsList){
+        EXPECT_TRUE(station.vehicleIdQueue.isPooled());
+        EXPECT_EQ(station.vehicleIdQueue.capacity(), 4);
+        EXPECT_TRUE(station.vehicleIdQueue.empty());
+    }
+    EXPECT_EQ(StationQueuePool::getFleetQueueCapacity(12, 4), 4);
+    EXPECT_EQ(StationQueuePool::getFleetQueueCapacity(10, 0), 0);
+}
+
+// Test case for first-in first-out order across the ring buffer wrap and on overflow
+TEST(MiningSimulationTests, TestStationQueuePoolRingBufferOrder) {
+    UnloadingStationProcessor unloadingStationProcessor(2, 5, 6);
+    VehicleIdQueue& firstQueue{unloadingStationProcessor.m_UnloadingStationsList[0].vehicleIdQueue};
+    VehicleIdQueue& secondQueue{unloadingStationProcessor.m_UnloadingStationsList[1].vehicleIdQueue};
+    ASSERT_EQ(firstQueue.capacity(), 4);
+
+    // Wrap around the end of the ring buffer without touching the neighbouring station
+    secondQueue.push(100);
+    int nextId{0};
+    int expectedFrontId{0};
+    for(int i = 0; i < 3; i++){
+        firstQueue.push(nextId++);
+    }
+    for(int i = 0; i < 20; i++){
+        firstQueue.push(nextId++);
+        EXPECT_EQ(firstQueue.front(), expectedFrontId++);
+        firstQueue.pop();
+    }
+    firstQueue.push(nextId++);
+    EXPECT_TRUE(firstQueue.isPooled());
+    EXPECT_EQ(firstQueue.size(), size_t{4});
+    for(int i = 0; i < 4; i++){
+        EXPECT_EQ(firstQueue[i], expectedFrontId + i);
+    }
+    EXPECT_EQ(secondQueue.size(), size_t{1});
+    EXPECT_EQ(secondQueue.front(), 100);
+
+    // Pushing to a full queue moves it to its own larger buffer, keeping the order
+    firstQueue.push(nextId++);
+    EXPECT_FALSE(firstQueue.isPooled());
+    EXPECT_GE(firstQueue.capacity(), 5);
+    ASSERT_EQ(firstQueue.size(), size_t{5});
+    for(int i = 0; i < 5; i++){
+        EXPECT_EQ(firstQueue.front(), expectedFrontId++);
+        firstQueue.pop();
+    }
+    EXPECT_TRUE(firstQueue.empty());
+    EXPECT_TRUE(secondQueue.isPooled());
+
+    // Re-pooling brings the queue back into the slab
+    firstQueue.push(7);
+    unloadingStationProcessor.poolStationQueues();
+    EXPECT_TRUE(firstQueue.isPooled());
+    EXPECT_EQ(firstQueue.front(), 7);
+    EXPECT_EQ(secondQueue.front(), 100);
+}
+
+// Test case for copies of queues and processors not sharing the slab
+TEST(MiningSimulationTests, TestStationQueuePoolCopiesAreIndependent) {
+    UnloadingStationProcessor unloadingStationProcessor(3, 5, 9);
+    VehicleIdQueue& queue{unloadingStationProcessor.m_UnloadingStationsList[1].vehicleIdQueue};
+    queue.push(1);
+    queue.push(2);
+
+    // Copied queue owns its buffer
+    VehicleIdQueue copiedQueue{queue};
+    EXPECT_FALSE(copiedQueue.isPooled());
+    EXPECT_EQ(copiedQueue, queue);
+    copiedQueue.pop();
+    EXPECT_EQ(queue.size(), size_t{2});
+
+    // Copied processor has its own slab
+    UnloadingStationProcessor copiedProcessor{unloadingStationProcessor};
+    VehicleIdQueue& processorCopyQueue{copiedProcessor.m_UnloadingStationsList[1].vehicleIdQueue};
+    EXPECT_TRUE(processorCopyQueue.isPooled());
+    EXPECT_EQ(processorCopyQueue, queue);
+    processorCopyQueue.pop();
+    processorCopyQueue.push(3);
+    EXPECT_EQ(queue.front(), 1);
+    EXPECT_EQ(queue.size(), size_t{2});
+    EXPECT_EQ(processorCopyQueue.front(), 2);
+}
+
+// Test case for station queues staying in the slab for a full simulation
+TEST(MiningSimulationTests, TestStationQueuePoolSimulationQueuesStayPooled) {
+    Simulation simulation(200, 16, 1, 5, 0.5, 5, 72, 5, SimulationEngines::FIXED_STEP, 13);
+    simulation.run();
+
+    size_t numPooledQueues{0};
+    for(const Station& station : simulation.getUnloadingStations()){
+        numPooledQueues += station.vehicleIdQueue.isPooled();
+    }
+    EXPECT_EQ(numPooledQueues, 16);
+}
@@ -12,8 +12,8 @@ TEST(MiningSimulationTests, TestUnloadingStationsUpdate) {
     const size_t numMiningVehicles{5};
     float travelDuration_hrs{0.5};
     float unloadDuration_min{5};
-    float simulationTime{};
-    float simulationTimestep{5}; // minutes
+    SimulationTicks simulationTime{};
+    const SimulationTicks simulationTimestep{minutesToTicks(5)};
 
     // Initialize Unloading Station Processor
     UnloadingStationProcessor unloadingStationProcessor(numUnloadingStations, unloadDuration_min);
@@ -25,8 +25,8 @@ TEST(MiningSimulationTests, TestUnloadingStationsUpdate) {
     miningTrucks.push_back(Truck(2, 0)); // T3
 
     // Run Simulation for 15 minutes
-    simulationTime = 30;
-    float currentSimTime{};
+    simulationTime = minutesToTicks(30);
+    SimulationTicks currentSimTime{};
     while(currentSimTime < simulationTime){
         EXPECT_EQ(unloadingStationProcessor.m_UnloadingStationsList[0].state, UnloadingStationStates::AVAILABLE);        
         unloadingStationProcessor.updateUnloadingStations(simulationTimestep, miningTrucks);
@@ -42,7 +42,7 @@ TEST(MiningSimulationTests, TestUnloadingStationsUpdate) {
     // Simulate loaded vehicle assigned to station
     miningTrucks[0].isAssignedStation = true;
     miningTrucks[0].isLoaded = true;
-    queue<int> vehicleIdQueue;
+    VehicleIdQueue vehicleIdQueue;
     vehicleIdQueue.push(0);
     unloadingStationProcessor.m_UnloadingStationsList[0].vehicleIdQueue = vehicleIdQueue;
 
@@ -57,10 +57,10 @@ TEST(MiningSimulationTests, TestUnloadingStationsUpdate) {
     EXPECT_EQ(unloadingStationProcessor.m_UnloadingStationsList[0].state, UnloadingStationStates::OCCUPIED);
 
     // Verify wait time equal to unload duration
-    EXPECT_EQ(unloadingStationProcessor.m_UnloadingStationsList[0].waitTime, unloadDuration_min);
+    EXPECT_EQ(unloadingStationProcessor.m_UnloadingStationsList[0].waitTime, minutesToTicks(unloadDuration_min));
 
     // Run simulation for unload duration
-    simulationTime += unloadDuration_min;
+    simulationTime += minutesToTicks(unloadDuration_min);
     while(currentSimTime < simulationTime){
         EXPECT_EQ(unloadingStationProcessor.m_UnloadingStationsList[0].state, UnloadingStationStates::OCCUPIED);
         unloadingStationProcessor.updateUnloadingStations(simulationTimestep, miningTrucks);
@@ -0,0 +1,113 @@
+import sys
+import threading
+import numpy as np
+import miningsim
+
+
+# Test case for the views of a finished simulation
+def test_simulation_views():
+    simulation = miningsim.Simulation(20, 3, simulation_time_hrs=24, seed=7)
+    assert simulation.seed == 7
+    assert simulation.replication == 0
+    simulation.run()
+
+    # Views point into the simulation without copying and are read-only
+    trucks = simulation.trucks()
+    assert len(trucks["id"]) == 20
+    assert list(trucks["id"]) == list(range(20))
+    assert not trucks["num_unloads"].flags.owndata
+    assert not trucks["num_unloads"].flags.writeable
+    assert trucks["is_loaded"].dtype == np.bool_
+
+    performances = simulation.truck_performances()
+    assert np.array_equal(performances["total_unloads"], trucks["num_unloads"].astype(np.float32))
+    stations = simulation.station_performances()
+    assert len(stations["station_id"]) == 3
+    assert stations["total_unloads"].sum() == simulation.stations()["num_vehicles_unloaded"].sum()
+
+    # Views keep the simulation alive
+    del simulation
+    assert len(trucks["id"]) == 20
+    assert trucks["num_unloads"].sum() > 0
+
+
+# Test case for every engine producing the same results for the same seed
+def test_engines_match():
+    results = []
+    for engine in miningsim.SimulationEngine:
+        simulation = miningsim.Simulation(30, 2, simulation_time_hrs=24, engine=engine, seed=11)
+        simulation.run()
+        results.append(np.array(simulation.truck_performances()["percent_idle_time"]))
+    assert len(results) == 5
+    for result in results:
+        assert np.array_equal(result, results[0])
+
+
+# Test case for invalid arguments
+def test_invalid_arguments():
+    for args, kwargs in [((-1, 2), {}), ((10, 2), {"engine": 9}), ((10, 2), {"unknown": 1})]:
+        try:
+            miningsim.Simulation(*args, **kwargs)
+            assert False, f"{args} {kwargs} accepted"
+        except (ValueError, TypeError):
+            pass
+
+
+# Test case for simulations running in parallel Python threads
+def test_run_releases_gil():
+    simulations = [miningsim.Simulation(50, 4, simulation_time_hrs=200, seed=3, replication=i) for i in range(4)]
+    threads = [threading.Thread(target=simulation.run) for simulation in simulations]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    unloads = [simulation.trucks()["num_unloads"].sum() for simulation in simulations]
+    assert all(num_unloads > 0 for num_unloads in unloads)
+    assert len(set(unloads)) > 1
+
+
+# Test case for threads sharing one simulation, their calls run one at a time
+def test_shared_simulation():
+    simulation = miningsim.Simulation(20, 2, simulation_time_hrs=48, seed=9)
+    threads = [threading.Thread(target=simulation.step) for _ in range(50)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    reference = miningsim.Simulation(20, 2, simulation_time_hrs=48, seed=9)
+    for _ in range(50):
+        reference.step()
+    assert np.array_equal(simulation.trucks()["num_mining_cycles"], reference.trucks()["num_mining_cycles"])
+
+
+# Test case for replication statistics
+def test_replications():
+    runner = miningsim.ReplicationRunner(10, 2, 6, 2, simulation_time_hrs=24, seed=5)
+    statistics = runner.truck_statistics()
+    assert statistics["mean"].shape == (10, len(miningsim.TRUCK_METRIC_NAMES))
+    assert not statistics["mean"].flags.writeable
+
+    runner.run()
+    assert runner.num_replications == 6
+    assert runner.station_statistics()["median"].shape == (2, len(miningsim.STATION_METRIC_NAMES))
+    assert np.all(statistics["std_dev"] >= 0)
+
+    # Statistics are overwritten in place, arrays of an earlier run show the latest results
+    first_means = np.array(statistics["mean"])
+    assert np.any(first_means > 0)
+    threads = [threading.Thread(target=runner.run) for _ in range(2)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    assert np.array_equal(statistics["mean"], runner.truck_statistics()["mean"])
+    assert np.array_equal(statistics["mean"], first_means)
+
+
+if __name__ == "__main__":
+    for name, test in list(globals().items()):
+        if name.startswith("test_") and callable(test):
+            test()
+            print(f"{name} passed")
+    sys.exit(0)